@@ -0,0 +1,144 @@
+/** Copyright 2022 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// Compare the ways to sort a table of edges by the sources:
+//   exec_plan:  EdgeChunkWriter::sortTableByExecPlan, the Acero plan that
+//               sortTable used before;
+//   arrow:      arrow::compute::SortIndices and Take;
+//   radix:      EdgeChunkWriter::sortTable, by util::SortIndices and
+//               util::TakeTable.
+//
+// Usage: sort_table_benchmark [thread_num] [num_rows ...]
+// The default is 10M and 100M rows with the hardware threads. The exec_plan
+// path is skipped beyond 100M rows, since it takes too long.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "arrow/api.h"
+#include "arrow/compute/api.h"
+
+#include "gar/utils/general_params.h"
+#include "gar/writer/arrow_chunk_writer.h"
+
+namespace GAR = GAR_NAMESPACE;
+
+// a table of random edges among num_rows / 16 vertices, with a property
+std::shared_ptr<arrow::Table> MakeEdges(int64_t num_rows) {
+  std::mt19937_64 engine(0);
+  std::uniform_int_distribution<int64_t> vertex(0, num_rows / 16);
+  arrow::Int64Builder src_builder, dst_builder;
+  arrow::DoubleBuilder weight_builder;
+  if (!src_builder.Reserve(num_rows).ok() ||
+      !dst_builder.Reserve(num_rows).ok() ||
+      !weight_builder.Reserve(num_rows).ok()) {
+    std::cerr << "out of memory" << std::endl;
+    std::exit(1);
+  }
+  for (int64_t i = 0; i < num_rows; ++i) {
+    src_builder.UnsafeAppend(vertex(engine));
+    dst_builder.UnsafeAppend(vertex(engine));
+    weight_builder.UnsafeAppend(static_cast<double>(i));
+  }
+  auto schema = arrow::schema(
+      {arrow::field(GAR::GeneralParams::kSrcIndexCol, arrow::int64()),
+       arrow::field(GAR::GeneralParams::kDstIndexCol, arrow::int64()),
+       arrow::field("weight", arrow::float64())});
+  return arrow::Table::Make(schema, {src_builder.Finish().ValueOrDie(),
+                                     dst_builder.Finish().ValueOrDie(),
+                                     weight_builder.Finish().ValueOrDie()});
+}
+
+std::shared_ptr<arrow::Table> SortByArrow(
+    const std::shared_ptr<arrow::Table>& table, const std::string& column) {
+  arrow::compute::SortOptions options{
+      {arrow::compute::SortKey{column, arrow::compute::SortOrder::Ascending}}};
+  auto indices =
+      arrow::compute::SortIndices(arrow::Datum(table), options).ValueOrDie();
+  return arrow::compute::Take(table, indices).ValueOrDie().table();
+}
+
+// the sorted table, or exit on error
+std::shared_ptr<arrow::Table> ValueOrExit(
+    GAR::Result<std::shared_ptr<arrow::Table>> maybe_sorted) {
+  if (maybe_sorted.has_error()) {
+    std::cerr << "failed to sort: " << maybe_sorted.status().message()
+              << std::endl;
+    std::exit(1);
+  }
+  return maybe_sorted.value();
+}
+
+// check that the sorted table is ordered by the column
+bool IsSorted(const std::shared_ptr<arrow::Table>& table,
+              const std::string& column) {
+  int64_t last = INT64_MIN;
+  for (const auto& chunk : table->GetColumnByName(column)->chunks()) {
+    auto array = std::static_pointer_cast<arrow::Int64Array>(chunk);
+    for (int64_t i = 0; i < array->length(); ++i) {
+      if (array->Value(i) < last) {
+        return false;
+      }
+      last = array->Value(i);
+    }
+  }
+  return true;
+}
+
+template <typename Func>
+void Run(const std::string& name, int64_t num_rows, const std::string& column,
+         Func&& sort) {
+  auto begin = std::chrono::steady_clock::now();
+  auto sorted = sort();
+  auto end = std::chrono::steady_clock::now();
+  double seconds = std::chrono::duration<double>(end - begin).count();
+  std::cout << name << "\trows=" << num_rows << "\ttime=" << seconds
+            << "s\trows/s=" << static_cast<double>(num_rows) / seconds
+            << (IsSorted(sorted, column) ? "" : "\tNOT SORTED") << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+  int thread_num = argc > 1 ? std::atoi(argv[1]) : 0;
+  std::vector<int64_t> sizes;
+  for (int i = 2; i < argc; ++i) {
+    sizes.push_back(std::atoll(argv[i]));
+  }
+  if (sizes.empty()) {
+    sizes = {10000000, 100000000};
+  }
+  const std::string column = GAR::GeneralParams::kSrcIndexCol;
+  for (auto num_rows : sizes) {
+    auto table = MakeEdges(num_rows);
+    if (num_rows <= 100000000) {
+      Run("exec_plan", num_rows, column, [&]() {
+        return ValueOrExit(
+            GAR::EdgeChunkWriter::sortTableByExecPlan(table, column));
+      });
+    }
+    Run("arrow", num_rows, column,
+        [&]() { return SortByArrow(table, column); });
+    Run("radix", num_rows, column, [&]() {
+      return ValueOrExit(
+          GAR::EdgeChunkWriter::sortTable(table, column, thread_num));
+    });
+  }
+  return 0;
+}
@@ -0,0 +1,139 @@
+/** Copyright 2022 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef GAR_ALGORITHM_BFS_H_
+#define GAR_ALGORITHM_BFS_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gar/graph_info.h"
+#include "gar/reader/csr_reader.h"
+#include "gar/utils/result.h"
+#include "gar/utils/status.h"
+#include "gar/utils/utils.h"
+
+namespace GAR_NAMESPACE_INTERNAL {
+
+// forward declaration
+class VertexPropertyWriter;
+
+/// The result of BFS.
+struct BFSResult {
+  /// The distance of each vertex from the root, -1 if it is unreachable.
+  std::vector<int32_t> distance;
+  /// The parent of each vertex in the BFS tree, the root is the parent of
+  /// itself, and -1 if the vertex is unreachable.
+  std::vector<IdType> parent;
+  /// The number of top-down (push) iterations.
+  int push_iterations = 0;
+  /// The number of bottom-up (pull) iterations.
+  int pull_iterations = 0;
+};
+
+/**
+ * @brief Run the direction-optimizing BFS from a root vertex.
+ *
+ * Each iteration either pushes from the frontier along the outgoing edges
+ * (top-down), or lets each unvisited vertex pull from the frontier along its
+ * incoming edges (bottom-up), switching with the heuristic of Beamer et al.
+ * The iterations run on multiple threads, and the parents are claimed with
+ * atomic operations.
+ *
+ * @param out_edges The outgoing edges, loaded from the ordered_by_source adj
+ *     list.
+ * @param in_edges The incoming edges of the same vertices, loaded from the
+ *     ordered_by_dest adj list.
+ * @param root The root vertex.
+ * @param thread_num The number of threads, the number of hardware threads is
+ *     used if it is not positive.
+ * @return The distances and parents, or error.
+ */
+Result<BFSResult> BFS(const CSR& out_edges, const CSR& in_edges, IdType root,
+                      int thread_num = 0) noexcept;
+
+/**
+ * @brief Run the direction-optimizing BFS from a root vertex on the
+ * compressed adjacency, the same as on the CSR.
+ *
+ * @param out_edges The outgoing edges, loaded from the ordered_by_source adj
+ *     list.
+ * @param in_edges The incoming edges of the same vertices, loaded from the
+ *     ordered_by_dest adj list.
+ * @param root The root vertex.
+ * @param thread_num The number of threads, the number of hardware threads is
+ *     used if it is not positive.
+ * @return The distances and parents, or error.
+ */
+Result<BFSResult> BFS(const CompressedCSR& out_edges,
+                      const CompressedCSR& in_edges, IdType root,
+                      int thread_num = 0) noexcept;
+
+/**
+ * @brief Run the direction-optimizing BFS on an edge type whose source and
+ * destination are of the same vertex type.
+ *
+ * @param edge_info The edge info that describes the edge type, which must
+ *     contain both the ordered_by_source and ordered_by_dest adj lists.
+ * @param vertex_info The vertex info of the vertices.
+ * @param prefix The absolute prefix.
+ * @param root The root vertex.
+ * @param thread_num The number of threads.
+ * @return The distances and parents, or error.
+ */
+Result<BFSResult> BFS(const EdgeInfo& edge_info, const VertexInfo& vertex_info,
+                      const std::string& prefix, IdType root,
+                      int thread_num = 0) noexcept;
+
+/**
+ * @brief Helper function to run the direction-optimizing BFS.
+ *
+ * @param graph_info The graph info to describe the graph.
+ * @param label label of the vertices.
+ * @param edge_label label of edge, from and to the vertices.
+ * @param root The root vertex.
+ * @param thread_num The number of threads.
+ * @return The distances and parents, or error.
+ */
+static inline Result<BFSResult> BFS(const GraphInfo& graph_info,
+                                    const std::string& label,
+                                    const std::string& edge_label, IdType root,
+                                    int thread_num = 0) noexcept {
+  EdgeInfo edge_info;
+  GAR_ASSIGN_OR_RAISE(edge_info,
+                      graph_info.GetEdgeInfo(label, edge_label, label));
+  VertexInfo vertex_info;
+  GAR_ASSIGN_OR_RAISE(vertex_info, graph_info.GetVertexInfo(label));
+  return BFS(edge_info, vertex_info, graph_info.GetPrefix(), root, thread_num);
+}
+
+/**
+ * @brief Write the result of BFS as a vertex property group.
+ *
+ * @param result The result of BFS.
+ * @param writer The writer of the vertices, whose vertex info contains the
+ *     property group.
+ * @param property_group The property group to write, whose first property
+ *     (int32) holds the distances and whose optional second property (int64)
+ *     holds the parents.
+ * @return Status: ok or error.
+ */
+Status WriteBFSResult(const BFSResult& result,
+                      const VertexPropertyWriter& writer,
+                      const PropertyGroup& property_group) noexcept;
+
+}  // namespace GAR_NAMESPACE_INTERNAL
+#endif  // GAR_ALGORITHM_BFS_H_
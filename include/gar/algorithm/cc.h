@@ -0,0 +1,102 @@
+/** Copyright 2022 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef GAR_ALGORITHM_CC_H_
+#define GAR_ALGORITHM_CC_H_
+
+#include <string>
+#include <vector>
+
+#include "gar/graph_info.h"
+#include "gar/utils/adj_list_type.h"
+#include "gar/utils/result.h"
+#include "gar/utils/status.h"
+#include "gar/utils/utils.h"
+
+namespace GAR_NAMESPACE_INTERNAL {
+
+// forward declaration
+class VertexPropertyWriter;
+
+/// The result of connected components.
+struct CCResult {
+  /// The component of each vertex, which is the smallest vertex id in it.
+  std::vector<IdType> component;
+  /// The number of components.
+  IdType component_num = 0;
+};
+
+/**
+ * @brief Find the connected components of the vertices, taking the edges as
+ * undirected.
+ *
+ * The adjList chunks are read by multiple threads, and the edges are merged
+ * into a lock-free union-find as the chunks arrive, so a single pass over
+ * the chunks is enough for any adjList type.
+ *
+ * @param edge_info The edge info that describes the edge type.
+ * @param vertex_info The vertex info of both the sources and destinations.
+ * @param prefix The absolute prefix.
+ * @param adj_list_type The type of adjList to read.
+ * @param thread_num The number of threads, the number of hardware threads is
+ *     used if it is not positive.
+ * @return The components, or error.
+ */
+Result<CCResult> ConnectedComponents(const EdgeInfo& edge_info,
+                                     const VertexInfo& vertex_info,
+                                     const std::string& prefix,
+                                     AdjListType adj_list_type,
+                                     int thread_num = 0) noexcept;
+
+/**
+ * @brief Helper function to find the connected components.
+ *
+ * @param graph_info The graph info to describe the graph.
+ * @param label label of the vertices.
+ * @param edge_label label of edge, from and to the vertices.
+ * @param adj_list_type The type of adjList to read.
+ * @param thread_num The number of threads.
+ * @return The components, or error.
+ */
+static inline Result<CCResult> ConnectedComponents(
+    const GraphInfo& graph_info, const std::string& label,
+    const std::string& edge_label,
+    AdjListType adj_list_type = AdjListType::ordered_by_source,
+    int thread_num = 0) noexcept {
+  EdgeInfo edge_info;
+  GAR_ASSIGN_OR_RAISE(edge_info,
+                      graph_info.GetEdgeInfo(label, edge_label, label));
+  VertexInfo vertex_info;
+  GAR_ASSIGN_OR_RAISE(vertex_info, graph_info.GetVertexInfo(label));
+  return ConnectedComponents(edge_info, vertex_info, graph_info.GetPrefix(),
+                             adj_list_type, thread_num);
+}
+
+/**
+ * @brief Write the result of connected components as a vertex property
+ * group.
+ *
+ * @param result The result of connected components.
+ * @param writer The writer of the vertices, whose vertex info contains the
+ *     property group.
+ * @param property_group The property group to write, which contains a
+ *     single int64 property for the components.
+ * @return Status: ok or error.
+ */
+Status WriteCCResult(const CCResult& result, const VertexPropertyWriter& writer,
+                     const PropertyGroup& property_group) noexcept;
+
+}  // namespace GAR_NAMESPACE_INTERNAL
+#endif  // GAR_ALGORITHM_CC_H_
@@ -0,0 +1,142 @@
+/** Copyright 2022 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef GAR_ALGORITHM_NEIGHBOR_SAMPLER_H_
+#define GAR_ALGORITHM_NEIGHBOR_SAMPLER_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gar/graph_info.h"
+#include "gar/reader/csr_reader.h"
+#include "gar/utils/result.h"
+#include "gar/utils/status.h"
+#include "gar/utils/utils.h"
+
+// forward declaration
+namespace arrow {
+class DoubleArray;
+class Int64Array;
+class Table;
+}  // namespace arrow
+
+namespace GAR_NAMESPACE_INTERNAL {
+
+/// A hop of sampled neighbors, as the edges from the vertices they are
+/// sampled for to the sampled neighbors.
+struct SampledBlock {
+  /// The vertices the neighbors are sampled for, one per edge, as the indices
+  /// in the vertices of the subgraph.
+  std::shared_ptr<arrow::Int64Array> centers;
+  /// The sampled neighbors, one per edge, as the indices in the vertices of
+  /// the subgraph.
+  std::shared_ptr<arrow::Int64Array> neighbors;
+  /// The positions of the edges in the neighbors of the CSR, which are also
+  /// the positions of their properties in the ordered adjList.
+  std::shared_ptr<arrow::Int64Array> edges;
+};
+
+/// The subgraph sampled from the seed vertices.
+struct SampledSubgraph {
+  /// The distinct vertices of the subgraph, starting with the seeds and
+  /// followed by the vertices in the order they are first sampled.
+  std::shared_ptr<arrow::Int64Array> vertices;
+  /// The sampled neighbors of each hop.
+  std::vector<SampledBlock> blocks;
+};
+
+/**
+ * @brief Sample the multi-hop neighborhoods of the seed vertices with fixed
+ * fanouts, uniformly or by the weights of the edges.
+ *
+ * The first hop samples the neighbors of the seeds, and each following hop
+ * samples the neighbors of the vertices first reached by the previous hop.
+ * The centers of a hop are split into blocks sampled by multiple threads,
+ * each block with its own random engine seeded by the random seed, the hop,
+ * and the block, so the result depends on the random seed only, not on the
+ * number of threads.
+ *
+ * Without replacement, the neighbors of a vertex are all kept if there are
+ * no more than the fanout, otherwise the fanout neighbors are sampled by
+ * Floyd's algorithm, or by the keys log(u) / weight (Efraimidis-Spirakis) if
+ * weighted. With replacement, the fanout neighbors are drawn independently.
+ * The edges of zero weight are never sampled.
+ *
+ * @param csr The CSR to sample from, of the out-going edges if loaded from
+ *     the ordered_by_source adjList or of the incoming edges if loaded from
+ *     the ordered_by_dest adjList. The CompressedCSR is not accepted, since
+ *     the sampled edges are the positions in the neighbors of the CSR.
+ * @param seeds The seed vertices.
+ * @param fanouts The number of neighbors sampled for each vertex of each
+ *     hop, all neighbors are kept if it is negative.
+ * @param weights The non-negative weights of the edges, in the order of the
+ *     neighbors of the CSR, or nullptr to sample uniformly.
+ * @param replace Whether to sample with replacement.
+ * @param random_seed The seed of the random engines.
+ * @param thread_num The number of threads, the number of hardware threads is
+ *     used if it is not positive.
+ * @return The sampled subgraph, or error.
+ */
+Result<SampledSubgraph> SampleNeighbors(
+    const CSR& csr, const std::vector<IdType>& seeds,
+    const std::vector<int>& fanouts,
+    const std::shared_ptr<arrow::DoubleArray>& weights = nullptr,
+    bool replace = false, uint64_t random_seed = 0,
+    int thread_num = 0) noexcept;
+
+/**
+ * @brief Load an edge property as the weights of the edges of a CSR.
+ *
+ * Only the column of the property is read from the property chunks of the
+ * ordered adjList the CSR is loaded from, and the chunks are read in
+ * parallel. The null weights are taken as zero.
+ *
+ * @param csr The CSR loaded from the edge type.
+ * @param edge_info The edge info that describes the edge type.
+ * @param prefix The absolute prefix.
+ * @param property The name of the property, which must be numeric.
+ * @param thread_num The number of threads, the number of hardware threads is
+ *     used if it is not positive.
+ * @return The weights in the order of the neighbors of the CSR, or error.
+ */
+Result<std::shared_ptr<arrow::DoubleArray>> LoadEdgeWeights(
+    const CSR& csr, const EdgeInfo& edge_info, const std::string& prefix,
+    const std::string& property, int thread_num = 0) noexcept;
+
+/**
+ * @brief Gather the properties of some vertices, e.g., the features of the
+ * vertices of a sampled subgraph.
+ *
+ * Only the chunks containing the vertices are read, each with only the
+ * columns of the properties, and the chunks are read in parallel.
+ *
+ * @param vertex_info The vertex info that describes the vertex type.
+ * @param prefix The absolute prefix.
+ * @param vertices The ids of the vertices.
+ * @param properties The names of the properties.
+ * @param thread_num The number of threads, the number of hardware threads is
+ *     used if it is not positive.
+ * @return The table of the properties, a row for each vertex in the order
+ *     of the vertices, or error.
+ */
+Result<std::shared_ptr<arrow::Table>> GatherVertexProperties(
+    const VertexInfo& vertex_info, const std::string& prefix,
+    const std::shared_ptr<arrow::Int64Array>& vertices,
+    const std::vector<std::string>& properties, int thread_num = 0) noexcept;
+
+}  // namespace GAR_NAMESPACE_INTERNAL
+#endif  // GAR_ALGORITHM_NEIGHBOR_SAMPLER_H_
@@ -0,0 +1,152 @@
+/** Copyright 2022 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef GAR_ALGORITHM_PAGERANK_H_
+#define GAR_ALGORITHM_PAGERANK_H_
+
+#include <string>
+#include <vector>
+
+#include "gar/graph_info.h"
+#include "gar/reader/csr_reader.h"
+#include "gar/utils/result.h"
+#include "gar/utils/status.h"
+#include "gar/utils/utils.h"
+
+namespace GAR_NAMESPACE_INTERNAL {
+
+// forward declaration
+class VertexPropertyWriter;
+
+/// The result of PageRank.
+struct PageRankResult {
+  /// The rank of each vertex.
+  std::vector<double> rank;
+  /// The number of iterations run.
+  int iterations = 0;
+  /// The L1 norm of the change of the ranks in the last iteration.
+  double delta = 0;
+};
+
+/**
+ * @brief Run PageRank by pulling the ranks along the incoming edges.
+ *
+ * The destination vertices are partitioned into blocks which are updated by
+ * different threads, so each rank is written by a single thread without
+ * atomics. A vertex without outgoing edges keeps its damped rank, the same
+ * as the PageRank example. The out-degrees are counted from the incoming
+ * edges in parallel, each thread into its own histogram.
+ *
+ * @param in_edges The incoming edges, loaded from the ordered_by_dest adj
+ *     list, whose number of vertices is the one of the vertex type.
+ * @param damping The damping factor.
+ * @param max_iterations The maximum number of iterations.
+ * @param tolerance Stop once the L1 norm of the change of the ranks is less
+ *     than it.
+ * @param thread_num The number of threads, the number of hardware threads is
+ *     used if it is not positive.
+ * @return The ranks, or error.
+ */
+Result<PageRankResult> PageRank(const CSR& in_edges, double damping = 0.85,
+                                int max_iterations = 100,
+                                double tolerance = 1e-6,
+                                int thread_num = 0) noexcept;
+
+/**
+ * @brief Run PageRank on the compressed adjacency, the same as on the CSR.
+ *
+ * @param in_edges The incoming edges, loaded from the ordered_by_dest adj
+ *     list, whose number of vertices is the one of the vertex type.
+ * @param damping The damping factor.
+ * @param max_iterations The maximum number of iterations.
+ * @param tolerance Stop once the L1 norm of the change of the ranks is less
+ *     than it.
+ * @param thread_num The number of threads, the number of hardware threads is
+ *     used if it is not positive.
+ * @return The ranks, or error.
+ */
+Result<PageRankResult> PageRank(const CompressedCSR& in_edges,
+                                double damping = 0.85,
+                                int max_iterations = 100,
+                                double tolerance = 1e-6,
+                                int thread_num = 0) noexcept;
+
+/**
+ * @brief Run PageRank on an edge type whose source and destination are of
+ * the same vertex type.
+ *
+ * If the edge type also contains the ordered_by_source adj list, the
+ * out-degrees are computed from its offset chunks instead of being counted.
+ *
+ * @param edge_info The edge info that describes the edge type, which must
+ *     contain the ordered_by_dest adj list.
+ * @param vertex_info The vertex info of the vertices.
+ * @param prefix The absolute prefix.
+ * @param damping The damping factor.
+ * @param max_iterations The maximum number of iterations.
+ * @param tolerance The tolerance of the L1 norm of the change of the ranks.
+ * @param thread_num The number of threads.
+ * @return The ranks, or error.
+ */
+Result<PageRankResult> PageRank(const EdgeInfo& edge_info,
+                                const VertexInfo& vertex_info,
+                                const std::string& prefix,
+                                double damping = 0.85,
+                                int max_iterations = 100,
+                                double tolerance = 1e-6,
+                                int thread_num = 0) noexcept;
+
+/**
+ * @brief Helper function to run PageRank.
+ *
+ * @param graph_info The graph info to describe the graph.
+ * @param label label of the vertices.
+ * @param edge_label label of edge, from and to the vertices.
+ * @param damping The damping factor.
+ * @param max_iterations The maximum number of iterations.
+ * @param tolerance The tolerance of the L1 norm of the change of the ranks.
+ * @param thread_num The number of threads.
+ * @return The ranks, or error.
+ */
+static inline Result<PageRankResult> PageRank(
+    const GraphInfo& graph_info, const std::string& label,
+    const std::string& edge_label, double damping = 0.85,
+    int max_iterations = 100, double tolerance = 1e-6,
+    int thread_num = 0) noexcept {
+  EdgeInfo edge_info;
+  GAR_ASSIGN_OR_RAISE(edge_info,
+                      graph_info.GetEdgeInfo(label, edge_label, label));
+  VertexInfo vertex_info;
+  GAR_ASSIGN_OR_RAISE(vertex_info, graph_info.GetVertexInfo(label));
+  return PageRank(edge_info, vertex_info, graph_info.GetPrefix(), damping,
+                  max_iterations, tolerance, thread_num);
+}
+
+/**
+ * @brief Write the result of PageRank as a vertex property group.
+ *
+ * @param result The result of PageRank.
+ * @param writer The writer of the vertices, whose vertex info contains the
+ *     property group.
+ * @param property_group The property group to write, which contains a
+ *     single double property for the ranks.
+ * @return Status: ok or error.
+ */
+Status WritePageRankResult(const PageRankResult& result,
+                           const VertexPropertyWriter& writer,
+                           const PropertyGroup& property_group) noexcept;
+
+}  // namespace GAR_NAMESPACE_INTERNAL
+#endif  // GAR_ALGORITHM_PAGERANK_H_
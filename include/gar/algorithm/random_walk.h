@@ -0,0 +1,118 @@
+/** Copyright 2022 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef GAR_ALGORITHM_RANDOM_WALK_H_
+#define GAR_ALGORITHM_RANDOM_WALK_H_
+
+#include <cstdint>
+#include <string>
+
+#include "gar/graph_info.h"
+#include "gar/utils/result.h"
+#include "gar/utils/status.h"
+#include "gar/utils/utils.h"
+
+namespace GAR_NAMESPACE_INTERNAL {
+
+/// The options of random walks.
+struct RandomWalkOptions {
+  /// The number of vertices in a walk, including the start vertex.
+  int walk_length = 80;
+  /// The number of walks starting from each vertex.
+  int walks_per_vertex = 10;
+  /// The return parameter of node2vec, 1 for DeepWalk.
+  double p = 1;
+  /// The in-out parameter of node2vec, 1 for DeepWalk.
+  double q = 1;
+  /// The number of walks generated and written at a time.
+  IdType batch_size = 1 << 20;
+  /// The bytes of the adjList chunks kept in memory to be shared by the
+  /// walkers, 0 to read a chunk each time it is needed.
+  int64_t cache_bytes = int64_t(256) << 20;
+  /// The seed of the random engines.
+  uint64_t random_seed = 0;
+};
+
+/**
+ * @brief Generate random walks from every vertex, and write them to a
+ * Parquet file.
+ *
+ * The walks are generated in batches, one row group of the file per batch,
+ * in a single column "walk" of list<int64>. A walk is shorter than the walk
+ * length if it reaches a vertex without out-going edges. The walk i starts
+ * from the vertex i % vertex num.
+ *
+ * At each step, the walkers are grouped by the vertex chunk of the vertex
+ * they are at, and the adjList of each vertex chunk is read once for all of
+ * its walkers, by multiple threads. The node2vec bias is applied by
+ * rejection: a neighbor x of the current vertex is drawn uniformly, and
+ * accepted with the weight 1 / p if x is the previous vertex t, 1 if x is a
+ * neighbor of t, or 1 / q otherwise, divided by the largest weight. The
+ * proposed walkers are grouped by the vertex chunk of t to read its adjList
+ * once, and the rejected ones draw again. Each group of walkers has its own
+ * random engine seeded by the random seed, the batch, the step, the round
+ * and the chunk, so the walks depend on the random seed only, not on the
+ * number of threads.
+ *
+ * The adjLists read are kept in a least-recently-used cache of at most
+ * options.cache_bytes, so the memory is bounded by the cache, a chunk being
+ * read per thread, and the walks of a batch, but not by the graph.
+ *
+ * @param edge_info The edge info that describes the edge type, whose
+ *     sources and destinations are of the same vertex type and which
+ *     contains the ordered_by_source adjList.
+ * @param vertex_info The vertex info of the vertices.
+ * @param prefix The absolute prefix.
+ * @param output_path The path of the Parquet file to write.
+ * @param options The options of random walks.
+ * @param thread_num The number of threads, the number of hardware threads is
+ *     used if it is not positive.
+ * @return The number of walks written, or error.
+ */
+Result<IdType> RandomWalk(const EdgeInfo& edge_info,
+                          const VertexInfo& vertex_info,
+                          const std::string& prefix,
+                          const std::string& output_path,
+                          const RandomWalkOptions& options = {},
+                          int thread_num = 0) noexcept;
+
+/**
+ * @brief Helper function to generate random walks.
+ *
+ * @param graph_info The graph info to describe the graph.
+ * @param label label of the vertices.
+ * @param edge_label label of edge, from and to the vertices.
+ * @param output_path The path of the Parquet file to write.
+ * @param options The options of random walks.
+ * @param thread_num The number of threads.
+ * @return The number of walks written, or error.
+ */
+static inline Result<IdType> RandomWalk(const GraphInfo& graph_info,
+                                        const std::string& label,
+                                        const std::string& edge_label,
+                                        const std::string& output_path,
+                                        const RandomWalkOptions& options = {},
+                                        int thread_num = 0) noexcept {
+  EdgeInfo edge_info;
+  GAR_ASSIGN_OR_RAISE(edge_info,
+                      graph_info.GetEdgeInfo(label, edge_label, label));
+  VertexInfo vertex_info;
+  GAR_ASSIGN_OR_RAISE(vertex_info, graph_info.GetVertexInfo(label));
+  return RandomWalk(edge_info, vertex_info, graph_info.GetPrefix(),
+                    output_path, options, thread_num);
+}
+
+}  // namespace GAR_NAMESPACE_INTERNAL
+#endif  // GAR_ALGORITHM_RANDOM_WALK_H_
@@ -0,0 +1,120 @@
+/** Copyright 2022 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef GAR_ALGORITHM_SUBGRAPH_H_
+#define GAR_ALGORITHM_SUBGRAPH_H_
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <utility>
+
+#include "gar/graph_info.h"
+#include "gar/utils/bitmap.h"
+#include "gar/utils/filesystem.h"
+#include "gar/utils/property_column.h"
+#include "gar/utils/reader_utils.h"
+#include "gar/utils/result.h"
+#include "gar/utils/status.h"
+#include "gar/utils/utils.h"
+
+namespace GAR_NAMESPACE_INTERNAL {
+
+/**
+ * @brief Select the vertices whose property satisfies a predicate.
+ *
+ * Only the column of the property is read, one vertex chunk at a time on
+ * each thread. The vertices whose property is null are not selected.
+ *
+ * @tparam T The C++ type of the property.
+ * @param vertex_info The vertex info that describes the vertex type.
+ * @param prefix The absolute prefix.
+ * @param property The name of the property.
+ * @param predicate The predicate, which is called by multiple threads at the
+ *     same time.
+ * @param thread_num The number of threads, the number of hardware threads is
+ *     used if it is not positive.
+ * @return The bitmap of the selected vertices, or error.
+ */
+template <typename T>
+Result<util::Bitmap> SelectVertices(
+    const VertexInfo& vertex_info, const std::string& prefix,
+    const std::string& property, const std::function<bool(const T&)>& predicate,
+    int thread_num = 0) noexcept {
+  GAR_ASSIGN_OR_RAISE(IdType vertex_num,
+                      utils::GetVertexNum(prefix, vertex_info));
+  GAR_ASSIGN_OR_RAISE(const auto& property_group,
+                      vertex_info.GetPropertyGroup(property));
+  std::string out_prefix;
+  GAR_ASSIGN_OR_RAISE(auto fs, FileSystemFromUriOrPath(prefix, &out_prefix));
+  IdType chunk_size = vertex_info.GetChunkSize();
+  IdType chunk_num = (vertex_num + chunk_size - 1) / chunk_size;
+  util::Bitmap selected(vertex_num);
+  GAR_RETURN_NOT_OK(util::ParallelFor(
+      0, chunk_num,
+      [&](IdType i) -> Status {
+        GAR_ASSIGN_OR_RAISE(auto chunk_path,
+                            vertex_info.GetFilePath(property_group, i));
+        GAR_ASSIGN_OR_RAISE(
+            auto table,
+            fs->ReadFileToTable(out_prefix + chunk_path,
+                                property_group.GetFileType(), {property}));
+        PropertyColumn<T> column(property);
+        GAR_RETURN_NOT_OK(column.Bind(table, i));
+        IdType length = std::min(column.length(), vertex_num - i * chunk_size);
+        for (IdType row = 0; row < length; ++row) {
+          if (!column.IsNull(row) && predicate(column[row])) {
+            selected.AtomicSet(i * chunk_size + row);
+          }
+        }
+        return Status::OK();
+      },
+      thread_num));
+  return std::move(selected);
+}
+
+/**
+ * @brief Extract the subgraph induced by the selected vertices of a vertex
+ * type, and write it as a new graph.
+ *
+ * The selected vertices are renumbered densely in the order of their ids.
+ * The new graph contains the vertex type and the edge types whose sources
+ * and destinations are both of the vertex type, with the same infos, i.e.,
+ * chunk sizes, property groups, and adjList types, as the original ones.
+ * An edge is kept if both of its endpoints are selected.
+ *
+ * Each new vertex chunk is produced by a task which reads the original
+ * chunks it comes from, filters and renumbers them, and writes them through
+ * VertexPropertyWriter or EdgeChunkWriter. The tasks run in parallel, so
+ * only the chunks of the running tasks are held in memory. The infos are
+ * saved as <name>.graph.yml, <label>.vertex.yml and
+ * <src_label>_<edge_label>_<dst_label>.edge.yml under the output prefix.
+ *
+ * @param graph_info The graph info of the original graph.
+ * @param label The label of the vertex type.
+ * @param selected The bitmap of the selected vertices.
+ * @param output_prefix The absolute prefix of the new graph.
+ * @param thread_num The number of threads, the number of hardware threads is
+ *     used if it is not positive.
+ * @return The graph info of the new graph, or error.
+ */
+Result<GraphInfo> ExtractInducedSubgraph(const GraphInfo& graph_info,
+                                         const std::string& label,
+                                         const util::Bitmap& selected,
+                                         const std::string& output_prefix,
+                                         int thread_num = 0) noexcept;
+
+}  // namespace GAR_NAMESPACE_INTERNAL
+#endif  // GAR_ALGORITHM_SUBGRAPH_H_
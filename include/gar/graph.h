@@ -17,9 +17,14 @@ limitations under the License.
 #define GAR_GRAPH_H_
 
 #include <any>
+#include <iterator>
+#include <list>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -27,6 +32,9 @@ limitations under the License.
 #include "arrow/api.h"
 
 #include "gar/reader/arrow_chunk_reader.h"
+#include "gar/utils/filesystem.h"
+#include "gar/utils/general_params.h"
+#include "gar/utils/property_column.h"
 #include "gar/utils/reader_utils.h"
 #include "gar/utils/utils.h"
 
@@ -94,6 +102,19 @@ class Edge {
                 std::vector<AdjListPropertyArrowChunkReader>&
                     property_readers);  // NOLINT
 
+  /**
+   * Initialize the Edge.
+   *
+   * @param src_id The id of the source vertex.
+   * @param dst_id The id of the destination vertex.
+   * @param property_tables The property chunks which contain the edge.
+   * @param row_offset The row offset of the edge in the chunks.
+   */
+  explicit Edge(
+      IdType src_id, IdType dst_id,
+      const std::vector<std::shared_ptr<arrow::Table>>& property_tables,
+      IdType row_offset);
+
   /**
    * @brief Get source id of the edge.
    *
@@ -173,7 +194,8 @@ class VerticesCollection {
      * @param offset The current offset of the readers.
      */
     explicit iterator(const VertexInfo& vertex_info, const std::string& prefix,
-                      IdType offset) noexcept {
+                      IdType offset) noexcept
+        : chunk_size_(vertex_info.GetChunkSize()), columns_chunk_index_(-1) {
       for (const auto& pg : vertex_info.GetPropertyGroups()) {
         readers_.emplace_back(vertex_info, pg, prefix);
       }
@@ -182,7 +204,11 @@ class VerticesCollection {
 
     /// Copy constructor.
     iterator(const iterator& other)
-        : readers_(other.readers_), cur_offset_(other.cur_offset_) {}
+        : readers_(other.readers_),
+          cur_offset_(other.cur_offset_),
+          chunk_size_(other.chunk_size_),
+          columns_(other.columns_),
+          columns_chunk_index_(other.columns_chunk_index_) {}
 
     /// Construct and return the vertex of the current offset.
     Vertex operator*() noexcept {
@@ -195,24 +221,53 @@ class VerticesCollection {
     /// Get the vertex id of the current offset.
     IdType id() { return cur_offset_; }
 
-    /// Get the value for a property of the current vertex.
+    /**
+     * @brief Get the value for a property of the current vertex.
+     *
+     * The column of the property is looked up once per vertex chunk and
+     * cached in the iterator.
+     *
+     * @param property The property name.
+     * @return Result: The property value or error.
+     */
     template <typename T>
     Result<T> property(const std::string& property) noexcept {
-      std::shared_ptr<arrow::ChunkedArray> column(nullptr);
-      for (auto& reader : readers_) {
-        reader.seek(cur_offset_);
-        GAR_ASSIGN_OR_RAISE(auto chunk_table, reader.GetChunk());
-        column = chunk_table->GetColumnByName(property);
-        if (column != nullptr) {
-          break;
-        }
+      IdType chunk_index = cur_offset_ / chunk_size_;
+      if (columns_chunk_index_ != chunk_index) {
+        columns_.clear();
+        columns_chunk_index_ = chunk_index;
       }
-      if (column != nullptr) {
-        GAR_ASSIGN_OR_RAISE(auto data,
-                            util::GetArrowArrayData(column->chunk(0)));
-        return util::ValueGetter<T>::Value(data, 0);
+      auto it = columns_.find(property);
+      if (it == columns_.end()) {
+        GAR_ASSIGN_OR_RAISE(auto array, getArray(property, chunk_index));
+        it = columns_.emplace(property, array).first;
       }
-      return Status::KeyError("The property is not exist.");
+      if (!PropertyColumn<T>::TypeMatch(*it->second)) {
+        return Status::TypeError("The property type is not match.");
+      }
+      return PropertyColumn<T>::Value(*it->second,
+                                      cur_offset_ - chunk_index * chunk_size_);
+    }
+
+    /**
+     * @brief Get the value for a property of the current vertex through a
+     * typed accessor.
+     *
+     * The accessor is only bound again when the iterator moves to another
+     * vertex chunk, so the repeated reads in the same chunk are direct
+     * indexed accesses.
+     *
+     * @param column The typed accessor of the property.
+     * @return Result: The property value or error.
+     */
+    template <typename T>
+    Result<T> property(PropertyColumn<T>& column) noexcept {  // NOLINT
+      IdType chunk_index = cur_offset_ / chunk_size_;
+      if (!column.IsBound(chunk_index)) {
+        GAR_ASSIGN_OR_RAISE(auto array, getArray(column.name(), chunk_index));
+        GAR_RETURN_NOT_OK(column.Bind(array, chunk_index));
+      }
+      return column[cur_offset_ - chunk_index * chunk_size_];
     }
 
     /// The prefix increment operator.
@@ -238,9 +293,33 @@ class VerticesCollection {
       return cur_offset_ != rhs.cur_offset_;
     }
 
+   private:
+    /// Get the array of a property for the vertex chunk.
+    Result<std::shared_ptr<arrow::Array>> getArray(
+        const std::string& property, IdType chunk_index) noexcept {
+      for (auto& reader : readers_) {
+        GAR_RETURN_NOT_OK(reader.seek(chunk_index * chunk_size_));
+        GAR_ASSIGN_OR_RAISE(auto chunk_table, reader.GetChunk());
+        auto column = chunk_table->GetColumnByName(property);
+        if (column != nullptr) {
+          if (column->num_chunks() == 1) {
+            return column->chunk(0);
+          }
+          GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+              auto array, arrow::Concatenate(column->chunks(),
+                                             arrow::default_memory_pool()));
+          return array;
+        }
+      }
+      return Status::KeyError("The property is not exist.");
+    }
+
    private:
     std::vector<VertexPropertyArrowChunkReader> readers_;
     IdType cur_offset_;
+    IdType chunk_size_;
+    std::unordered_map<std::string, std::shared_ptr<arrow::Array>> columns_;
+    IdType columns_chunk_index_;
   };
 
   /// The iterator pointing to the first vertex.
@@ -257,177 +336,504 @@ class VerticesCollection {
   /// Get the number of vertices in the collection.
   size_t size() const noexcept { return vertex_num_; }
 
+  /**
+   * @brief Load properties of all vertices.
+   *
+   * The vertex chunks are read in parallel, and only the columns of the
+   * properties are decoded from the chunk files.
+   *
+   * @param properties The names of the properties.
+   * @param thread_num The number of threads to read the chunks, the number of
+   *     hardware threads is used if it is not positive.
+   * @return The table with a column for each property, each column holds the
+   *     arrays of the vertex chunks as they are decoded, without copies.
+   */
+  Result<std::shared_ptr<arrow::Table>> LoadColumns(
+      const std::vector<std::string>& properties,
+      int thread_num = 0) const noexcept;
+
+  /**
+   * @brief Load a property of all vertices into one contiguous array.
+   *
+   * @tparam T The C++ type of the property.
+   * @param property The name of the property.
+   * @param thread_num The number of threads to read the chunks, the number of
+   *     hardware threads is used if it is not positive.
+   * @return The array of the property, indexed by vertex id, or TypeError if
+   *     the type of the property does not match T.
+   */
+  template <typename T>
+  Result<std::shared_ptr<typename PropertyColumn<T>::ArrayType>> LoadColumn(
+      const std::string& property, int thread_num = 0) const noexcept {
+    using ArrayType = typename PropertyColumn<T>::ArrayType;
+    GAR_ASSIGN_OR_RAISE(auto table, LoadColumns({property}, thread_num));
+    auto column = table->column(0);
+    if (column->type()->id() != PropertyColumn<T>::ArrowType::type_id) {
+      return Status::TypeError("The property type " +
+                               column->type()->ToString() +
+                               " is not match for " + property + ".");
+    }
+    std::shared_ptr<arrow::Array> array;
+    if (column->num_chunks() == 0) {
+      GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+          array, arrow::MakeEmptyArray(column->type()));
+    } else if (column->num_chunks() == 1) {
+      array = column->chunk(0);
+    } else {
+      GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+          array,
+          arrow::Concatenate(column->chunks(), arrow::default_memory_pool()));
+    }
+    return std::static_pointer_cast<ArrayType>(array);
+  }
+
  private:
   VertexInfo vertex_info_;
   std::string prefix_;
   IdType vertex_num_;
 };
 
+struct EdgesCollectionContext;
+
+/// An adjList chunk of an ordered adjList, cached for the neighbor queries.
+struct NeighborChunk {
+  std::shared_ptr<arrow::Int64Array> neighbors;  // the neighbor ids
+  std::vector<std::shared_ptr<arrow::Table>> property_tables;
+  bool has_properties = false;  // if the property tables are loaded
+};
+
 /**
- * @brief EdgesCollection is designed for reading a collection of edges.
+ * @brief The neighbors of a vertex in an ordered adjList.
  *
+ * It is a read-only range over the ids of the neighbors, which may span more
+ * than one adjList chunk. The range holds the chunks it refers to, so it
+ * stays valid after the chunks are evicted from the cache.
  */
-template <AdjListType adj_list_type>
-class EdgesCollection;
+class NeighborRange {
+ public:
+  /// The rows [begin, end) of a chunk.
+  struct Segment {
+    std::shared_ptr<const NeighborChunk> chunk;
+    int64_t begin, end;
+  };
+
+  /// The iterator over the neighbor ids.
+  class iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = IdType;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const IdType*;
+    using reference = IdType;
+
+    iterator(const std::vector<Segment>* segments, size_t segment,
+             int64_t row) noexcept
+        : segments_(segments), segment_(segment), row_(row) {}
+
+    /// Get the id of the neighbor.
+    IdType operator*() const noexcept {
+      return (*segments_)[segment_].chunk->neighbors->Value(row_);
+    }
+
+    /// The prefix increment operator.
+    iterator& operator++() noexcept {
+      if (++row_ == (*segments_)[segment_].end) {
+        ++segment_;
+        row_ = segment_ < segments_->size() ? (*segments_)[segment_].begin : 0;
+      }
+      return *this;
+    }
+
+    /// The postfix increment operator.
+    iterator operator++(int) noexcept {
+      iterator ret(*this);
+      ++(*this);
+      return ret;
+    }
+
+    /// The equality operator.
+    bool operator==(const iterator& rhs) const noexcept {
+      return segment_ == rhs.segment_ && row_ == rhs.row_;
+    }
+
+    /// The inequality operator.
+    bool operator!=(const iterator& rhs) const noexcept {
+      return !(*this == rhs);
+    }
+
+   private:
+    const std::vector<Segment>* segments_;
+    size_t segment_;
+    int64_t row_;
+  };
+
+  /// Initialize an empty range.
+  NeighborRange() : size_(0) {}
+
+  /**
+   * @brief Initialize the range.
+   *
+   * @param segments The non-empty segments of the range, in order.
+   */
+  explicit NeighborRange(std::vector<Segment>&& segments)
+      : segments_(std::move(segments)), size_(0) {
+    for (const auto& segment : segments_) {
+      size_ += segment.end - segment.begin;
+    }
+  }
+
+  /// Get the number of neighbors.
+  IdType size() const noexcept { return size_; }
+
+  /// Check if the range is empty.
+  bool empty() const noexcept { return size_ == 0; }
+
+  /// The iterator pointing to the first neighbor.
+  iterator begin() const noexcept {
+    return iterator(&segments_, 0, segments_.empty() ? 0 : segments_[0].begin);
+  }
+
+  /// The iterator pointing to the past-the-end neighbor.
+  iterator end() const noexcept {
+    return iterator(&segments_, segments_.size(), 0);
+  }
+
+  /// Get the id of the neighbor with specific index.
+  IdType operator[](IdType index) const noexcept {
+    for (const auto& segment : segments_) {
+      IdType length = segment.end - segment.begin;
+      if (index < length) {
+        return segment.chunk->neighbors->Value(segment.begin + index);
+      }
+      index -= length;
+    }
+    return -1;
+  }
+
+  /**
+   * @brief Get the property of the edge to the neighbor with specific index,
+   * the properties are available if the range is got with properties.
+   *
+   * @param property The property name.
+   * @param index The index of the neighbor.
+   * @return Result: The property value or error.
+   */
+  template <typename T>
+  Result<T> property(const std::string& property, IdType index) const
+      noexcept {
+    for (const auto& segment : segments_) {
+      IdType length = segment.end - segment.begin;
+      if (index >= length) {
+        index -= length;
+        continue;
+      }
+      if (!segment.chunk->has_properties) {
+        return Status::Invalid("The properties of the neighbors are not got.");
+      }
+      for (const auto& table : segment.chunk->property_tables) {
+        auto column = table->GetColumnByName(property);
+        if (column != nullptr) {
+          const auto& array = *column->chunk(0);
+          if (!PropertyColumn<T>::TypeMatch(array)) {
+            return Status::TypeError("The property type " +
+                                     array.type()->ToString() +
+                                     " is not match for " + property + ".");
+          }
+          return PropertyColumn<T>::Value(array, segment.begin + index);
+        }
+      }
+      return Status::KeyError("The property " + property + " is not exist.");
+    }
+    return Status::OutOfRange("The index is out of the neighbors.");
+  }
+
+ private:
+  std::vector<Segment> segments_;
+  IdType size_;
+};
 
 /**
- * @brief The iterator for traversing a type of edges.
+ * @brief The neighbors of a batch of vertices in CSR form, the neighbors of
+ * the i-th vertex of the batch are neighbors[offsets[i], offsets[i + 1]).
+ */
+struct NeighborBatch {
+  std::vector<IdType> offsets;
+  std::vector<IdType> neighbors;
+};
+
+/**
+ * @brief The cache of the offset chunks and the adjList chunks of an ordered
+ * adjList, shared by the neighbor queries on an edges collection.
  *
+ * All offset chunks that have been used are kept, they are small. The
+ * adjList chunks are kept in a least-recently-used list of bounded size. The
+ * cache is thread-safe, the chunks are read out of the lock.
  */
-class EdgeIter {
+class NeighborCache {
  public:
+  /// The default number of adjList chunks to keep.
+  static constexpr size_t kDefaultCapacity = 64;
+
   /**
-   * Initialize the iterator.
+   * @brief Initialize the cache.
+   *
+   * @param capacity The number of adjList chunks to keep.
+   */
+  explicit NeighborCache(size_t capacity = kDefaultCapacity)
+      : capacity_(capacity) {}
+
+  /**
+   * @brief Get the neighbors of a vertex.
+   *
+   * @param context The state of the edges collection.
+   * @param vid The id of the vertex.
+   * @param with_properties Whether to load the properties of the edges.
+   * @return The neighbors, or KeyError if the vertex does not exist.
+   */
+  Result<NeighborRange> Neighbors(const EdgesCollectionContext& context,
+                                  IdType vid, bool with_properties) noexcept;
+
+  /**
+   * @brief Get the neighbors of a batch of vertices.
+   *
+   * @param context The state of the edges collection.
+   * @param vids The ids of the vertices, in any order.
+   * @param thread_num The number of threads to load the chunks, the number of
+   *     hardware threads is used if it is not positive.
+   * @return The neighbors in the order of the ids, or KeyError if a vertex
+   *     does not exist.
+   */
+  Result<NeighborBatch> BatchNeighbors(const EdgesCollectionContext& context,
+                                       const std::vector<IdType>& vids,
+                                       int thread_num) noexcept;
+
+ private:
+  /// Get the vertex chunk size of the ordered adjList.
+  static Result<IdType> getVertexChunkSize(
+      const EdgesCollectionContext& context) noexcept;
+
+  /// Get the offset chunk of a vertex chunk.
+  Result<std::shared_ptr<arrow::Int64Array>> getOffsets(
+      const EdgesCollectionContext& context,
+      IdType vertex_chunk_index) noexcept;
+
+  /// Get an adjList chunk of a vertex chunk.
+  Result<std::shared_ptr<const NeighborChunk>> getChunk(
+      const EdgesCollectionContext& context, IdType vertex_chunk_index,
+      IdType edge_chunk_index, bool with_properties) noexcept;
+
+  size_t capacity_;
+  std::mutex mutex_;
+  std::unordered_map<IdType, std::shared_ptr<arrow::Int64Array>> offsets_;
+  std::list<IdType> lru_;  // the global chunk indices, most recent first
+  std::unordered_map<IdType,
+                     std::pair<std::shared_ptr<const NeighborChunk>,
+                               std::list<IdType>::iterator>>
+      chunks_;
+};
+
+/**
+ * @brief The immutable state of an EdgesCollection.
+ *
+ * It is built once when the collection is constructed and shared by the
+ * collection and all of its iterators through one pointer, so constructing
+ * and copying the iterators neither touches the file system nor allocates.
+ */
+struct EdgesCollectionContext {
+  EdgeInfo edge_info;                // the edge info of the edge type
+  AdjListType adj_list_type;         // the type of adjList
+  FileType adj_list_file_type;       // the file type of adjList chunks
+  std::vector<PropertyGroup> property_groups;  // the property groups to read
+  std::shared_ptr<FileSystem> fs;    // the file system of the payload files
+  std::string prefix;                // the path prefix in the file system
+  std::shared_ptr<util::IndexConverter> index_converter;
+  IdType chunk_size, src_chunk_size, dst_chunk_size;
+  IdType chunk_begin, chunk_end;     // global indices of the chunk range
+  IdType offset_of_chunk_begin, offset_of_chunk_end;
+  std::shared_ptr<NeighborCache> neighbor_cache;  // for the neighbor queries
+
+  /**
+   * @brief Make the context for all edges of an adjList type.
+   *
+   * @param edge_info The edge info that describes the edge type.
+   * @param prefix The absolute prefix.
+   * @param adj_list_type The type of adjList.
+   * @param property_groups The property groups to read, all of the property
+   * groups of the adj list type are read if not given.
+   * @return The context or error.
+   */
+  static Result<std::shared_ptr<const EdgesCollectionContext>> Make(
+      const EdgeInfo& edge_info, const std::string& prefix,
+      AdjListType adj_list_type,
+      const std::optional<std::vector<PropertyGroup>>&
+          property_groups) noexcept;
+
+  /**
+   * @brief Make the context for a range of edge chunks.
+   *
+   * @param edge_info The edge info that describes the edge type.
+   * @param prefix The absolute prefix.
+   * @param adj_list_type The type of adjList.
+   * @param chunk_begin The global index of the begin chunk.
+   * @param chunk_end The global index of the end chunk.
+   * @param property_groups The property groups to read, all of the property
+   * groups of the adj list type are read if not given.
+   * @return The context or error.
+   */
+  static Result<std::shared_ptr<const EdgesCollectionContext>> Make(
+      const EdgeInfo& edge_info, const std::string& prefix,
+      AdjListType adj_list_type, IdType chunk_begin, IdType chunk_end,
+      const std::optional<std::vector<PropertyGroup>>&
+          property_groups) noexcept;
+
+  /**
+   * @brief Make the context for the edges of a vertex chunk.
    *
    * @param edge_info The edge info that describes the edge type.
    * @param prefix The absolute prefix.
    * @param adj_list_type The type of adjList.
+   * @param vertex_chunk_index The index of the vertex chunk.
+   * @param property_groups The property groups to read, all of the property
+   * groups of the adj list type are read if not given.
+   * @return The context or error.
+   */
+  static Result<std::shared_ptr<const EdgesCollectionContext>> Make(
+      const EdgeInfo& edge_info, const std::string& prefix,
+      AdjListType adj_list_type, IdType vertex_chunk_index,
+      const std::optional<std::vector<PropertyGroup>>&
+          property_groups) noexcept;
+};
+
+/**
+ * @brief The iterator for traversing a type of edges.
+ *
+ * The iterator only holds a pointer to the state of its collection and a
+ * cursor. The chunks at the cursor are loaded on the first access and are
+ * shared by the copies of the iterator, the property chunks are only loaded
+ * when a property is accessed.
+ */
+class EdgeIter {
+ public:
+  /**
+   * Initialize the iterator.
+   *
+   * @param context The state of the collection.
    * @param global_chunk_index The global index of the current edge chunk.
-   * @param offset The current offset in the current edge chunk.
-   * @param chunk_begin The index of the first chunk.
-   * @param chunk_end The index of the last chunk.
-   * @param offset_of_chunk_begin The begin offset of the first chunk.
-   * @param offset_of_chunk_end The end offset of the last chunk.
-   * @param index_converter The converter for transforming the edge chunk
-   * indices.
+   * @param offset The current offset in the current vertex chunk.
    */
-  explicit EdgeIter(const EdgeInfo& edge_info, const std::string& prefix,
-                    AdjListType adj_list_type, IdType global_chunk_index,
-                    IdType offset, IdType chunk_begin, IdType chunk_end,
-                    IdType offset_of_chunk_begin, IdType offset_of_chunk_end,
-                    std::shared_ptr<util::IndexConverter> index_converter)
-      : adj_list_reader_(
-            edge_info, adj_list_type, prefix,
-            index_converter->GlobalChunkIndexToIndexPair(global_chunk_index)
-                .first),
+  explicit EdgeIter(std::shared_ptr<const EdgesCollectionContext> context,
+                    IdType global_chunk_index, IdType offset) noexcept
+      : context_(std::move(context)),
         global_chunk_index_(global_chunk_index),
         cur_offset_(offset),
-        chunk_size_(edge_info.GetChunkSize()),
-        src_chunk_size_(edge_info.GetSrcChunkSize()),
-        dst_chunk_size_(edge_info.GetDstChunkSize()),
-        num_row_of_chunk_(0),
-        chunk_begin_(chunk_begin),
-        chunk_end_(chunk_end),
-        offset_of_chunk_begin_(offset_of_chunk_begin),
-        offset_of_chunk_end_(offset_of_chunk_end),
-        adj_list_type_(adj_list_type),
-        index_converter_(index_converter) {
+        offsets_chunk_index_(-1) {
     vertex_chunk_index_ =
-        index_converter->GlobalChunkIndexToIndexPair(global_chunk_index).first;
-    GAR_ASSIGN_OR_RAISE_ERROR(auto& property_groups,
-                              edge_info.GetPropertyGroups(adj_list_type));
-    for (const auto& pg : property_groups) {
-      property_readers_.emplace_back(edge_info, pg, adj_list_type, prefix,
-                                     vertex_chunk_index_);
-    }
-    if (adj_list_type == AdjListType::ordered_by_source ||
-        adj_list_type == AdjListType::ordered_by_dest) {
-      offset_reader_ = std::make_shared<AdjListOffsetArrowChunkReader>(
-          edge_info, adj_list_type, prefix);
-    }
+        context_->index_converter->GlobalChunkIndexToIndexPair(
+            global_chunk_index_).first;
   }
 
   /// Copy constructor.
-  EdgeIter(const EdgeIter& other)
-      : adj_list_reader_(other.adj_list_reader_),
-        offset_reader_(other.offset_reader_),
-        property_readers_(other.property_readers_),
-        global_chunk_index_(other.global_chunk_index_),
-        vertex_chunk_index_(other.vertex_chunk_index_),
-        cur_offset_(other.cur_offset_),
-        chunk_size_(other.chunk_size_),
-        src_chunk_size_(other.src_chunk_size_),
-        dst_chunk_size_(other.dst_chunk_size_),
-        num_row_of_chunk_(other.num_row_of_chunk_),
-        chunk_begin_(other.chunk_begin_),
-        chunk_end_(other.chunk_end_),
-        offset_of_chunk_begin_(other.offset_of_chunk_begin_),
-        offset_of_chunk_end_(other.offset_of_chunk_end_),
-        adj_list_type_(other.adj_list_type_),
-        index_converter_(other.index_converter_) {}
+  EdgeIter(const EdgeIter& other) = default;
+
+  /// The copy assignment operator.
+  EdgeIter& operator=(const EdgeIter& other) = default;
 
   /// Construct and return the edge of the current offset.
   Edge operator*() {
-    adj_list_reader_.seek(cur_offset_);
-    for (auto& reader : property_readers_) {
-      reader.seek(cur_offset_);
-    }
-    return Edge(adj_list_reader_, property_readers_);
+    GAR_RAISE_ERROR_NOT_OK(loadChunk());
+    GAR_RAISE_ERROR_NOT_OK(loadPropertyChunk());
+    IdType row_offset = cur_offset_ % context_->chunk_size;
+    return Edge(chunk_->src[row_offset], chunk_->dst[row_offset],
+                property_chunk_->tables, row_offset);
   }
 
   /// Get the source vertex id for the current edge.
   IdType source() {
-    adj_list_reader_.seek(cur_offset_);
-    GAR_ASSIGN_OR_RAISE_ERROR(auto chunk, adj_list_reader_.GetChunk());
-    auto src_column = chunk->column(0);
-    return std::dynamic_pointer_cast<arrow::Int64Array>(src_column->chunk(0))
-        ->GetView(0);
+    GAR_RAISE_ERROR_NOT_OK(loadChunk());
+    return chunk_->src[cur_offset_ % context_->chunk_size];
   }
 
   /// Get the destination vertex id for the current edge.
   IdType destination() {
-    adj_list_reader_.seek(cur_offset_);
-    GAR_ASSIGN_OR_RAISE_ERROR(auto chunk, adj_list_reader_.GetChunk());
-    auto src_column = chunk->column(1);
-    return std::dynamic_pointer_cast<arrow::Int64Array>(src_column->chunk(0))
-        ->GetView(0);
+    GAR_RAISE_ERROR_NOT_OK(loadChunk());
+    return chunk_->dst[cur_offset_ % context_->chunk_size];
   }
 
   /// Get the value of a property for the current edge.
   template <typename T>
   Result<T> property(const std::string& property) noexcept {
-    std::shared_ptr<arrow::ChunkedArray> column(nullptr);
-    for (auto& reader : property_readers_) {
-      reader.seek(cur_offset_);
-      GAR_ASSIGN_OR_RAISE(auto chunk_table, reader.GetChunk());
-      column = chunk_table->GetColumnByName(property);
+    GAR_RETURN_NOT_OK(loadPropertyChunk());
+    for (const auto& table : property_chunk_->tables) {
+      auto column = table->GetColumnByName(property);
       if (column != nullptr) {
-        break;
+        auto array = column->chunk(0);
+        if (!PropertyColumn<T>::TypeMatch(*array)) {
+          return Status::TypeError("The property type is not match.");
+        }
+        return PropertyColumn<T>::Value(*array,
+                                        cur_offset_ % context_->chunk_size);
       }
     }
-    if (column != nullptr) {
-      GAR_ASSIGN_OR_RAISE(auto data, util::GetArrowArrayData(column->chunk(0)));
-      return util::ValueGetter<T>::Value(data, 0);
-    }
     return Status::KeyError("The property is not exist.");
   }
 
+  /**
+   * @brief Get the value of a property for the current edge through a typed
+   * accessor.
+   *
+   * The accessor is only bound again when the iterator moves to another
+   * edge chunk, so the repeated reads in the same chunk are direct indexed
+   * accesses.
+   *
+   * @param column The typed accessor of the property.
+   * @return Result: The property value or error.
+   */
+  template <typename T>
+  Result<T> property(PropertyColumn<T>& column) noexcept {  // NOLINT
+    if (!column.IsBound(global_chunk_index_)) {
+      GAR_RETURN_NOT_OK(loadPropertyChunk());
+      std::shared_ptr<arrow::ChunkedArray> array(nullptr);
+      for (const auto& table : property_chunk_->tables) {
+        array = table->GetColumnByName(column.name());
+        if (array != nullptr) {
+          break;
+        }
+      }
+      if (array == nullptr) {
+        return Status::KeyError("The property is not exist.");
+      }
+      GAR_RETURN_NOT_OK(column.Bind(array, global_chunk_index_));
+    }
+    return column[cur_offset_ % context_->chunk_size];
+  }
+
   /// The prefix increment operator.
   EdgeIter& operator++() {
-    if (num_row_of_chunk_ == 0) {
-      adj_list_reader_.seek(cur_offset_);
-      GAR_ASSIGN_OR_RAISE_ERROR(num_row_of_chunk_,
-                                adj_list_reader_.GetRowNumOfChunk());
+    if (is_end()) {
+      return *this;
     }
-    auto st = adj_list_reader_.seek(++cur_offset_);
-    if (st.ok() && num_row_of_chunk_ != chunk_size_) {
-      // check the row offset is overflow
-      auto row_offset = cur_offset_ % chunk_size_;
-      if (row_offset >= num_row_of_chunk_) {
-        cur_offset_ = (cur_offset_ / chunk_size_ + 1) * chunk_size_;
-        adj_list_reader_.seek(cur_offset_);
-        st = Status::KeyError();
-      }
+    GAR_RAISE_ERROR_NOT_OK(loadChunk());
+    ++cur_offset_;
+    IdType row_offset = cur_offset_ % context_->chunk_size;
+    if (row_offset != 0 && row_offset < chunk_->num_rows) {
+      // still in the current chunk
+      return *this;
     }
-    if (st.ok() && num_row_of_chunk_ == chunk_size_ &&
-        cur_offset_ % chunk_size_ == 0) {
-      GAR_ASSIGN_OR_RAISE_ERROR(num_row_of_chunk_,
-                                adj_list_reader_.GetRowNumOfChunk());
-      ++global_chunk_index_;
+    ++global_chunk_index_;
+    if (row_offset == 0 &&
+        cur_offset_ / context_->chunk_size <
+            context_->index_converter->GetEdgeChunkNum(vertex_chunk_index_)) {
+      // the next edge chunk of the current vertex chunk
+      return *this;
     }
-    if (st.IsKeyError()) {
-      st = adj_list_reader_.next_chunk();
-      ++global_chunk_index_;
+    // the first edge chunk of the next vertex chunk which has edges
+    cur_offset_ = 0;
+    ++vertex_chunk_index_;
+    while (vertex_chunk_index_ <
+               context_->index_converter->GetVertexChunkNum() &&
+           context_->index_converter->GetEdgeChunkNum(vertex_chunk_index_) ==
+               0) {
       ++vertex_chunk_index_;
-      if (!st.IsOutOfRange()) {
-        GAR_ASSIGN_OR_RAISE_ERROR(num_row_of_chunk_,
-                                  adj_list_reader_.GetRowNumOfChunk());
-        for (auto& reader : property_readers_) {
-          reader.next_chunk();
-        }
-      }
-      cur_offset_ = 0;
-      adj_list_reader_.seek(cur_offset_);
     }
     return *this;
   }
@@ -439,39 +845,16 @@ class EdgeIter {
     return ret;
   }
 
-  /// The copy assignment operator.
-  EdgeIter operator=(const EdgeIter& other) {
-    adj_list_reader_ = other.adj_list_reader_;
-    offset_reader_ = other.offset_reader_;
-    property_readers_ = other.property_readers_;
-    global_chunk_index_ = other.global_chunk_index_;
-    vertex_chunk_index_ = other.vertex_chunk_index_;
-    cur_offset_ = other.cur_offset_;
-    chunk_size_ = other.chunk_size_;
-    src_chunk_size_ = other.src_chunk_size_;
-    dst_chunk_size_ = other.dst_chunk_size_;
-    num_row_of_chunk_ = other.num_row_of_chunk_;
-    chunk_begin_ = other.chunk_begin_;
-    chunk_end_ = other.chunk_end_;
-    offset_of_chunk_begin_ = other.offset_of_chunk_begin_;
-    offset_of_chunk_end_ = other.offset_of_chunk_end_;
-    adj_list_type_ = other.adj_list_type_;
-    index_converter_ = other.index_converter_;
-    return *this;
-  }
-
   /// The equality operator.
   bool operator==(const EdgeIter& rhs) const noexcept {
     return global_chunk_index_ == rhs.global_chunk_index_ &&
            cur_offset_ == rhs.cur_offset_ &&
-           adj_list_type_ == rhs.adj_list_type_;
+           context_->adj_list_type == rhs.context_->adj_list_type;
   }
 
   /// The inequality operator.
   bool operator!=(const EdgeIter& rhs) const noexcept {
-    return global_chunk_index_ != rhs.global_chunk_index_ ||
-           cur_offset_ != rhs.cur_offset_ ||
-           adj_list_type_ != rhs.adj_list_type_;
+    return !(*this == rhs);
   }
 
   /// Get the global index of the current edge chunk.
@@ -492,26 +875,14 @@ class EdgeIter {
     if (from.is_end())
       return false;
 
+    AdjListType adj_list_type = context_->adj_list_type;
     // ordered_by_dest or unordered_by_dest
-    if (adj_list_type_ == AdjListType::ordered_by_dest ||
-        adj_list_type_ == AdjListType::unordered_by_dest) {
-      if (from.global_chunk_index_ > chunk_end_ ||
-          (from.global_chunk_index_ == chunk_end_ &&
-           from.cur_offset_ > offset_of_chunk_end_)) {
+    if (adj_list_type == AdjListType::ordered_by_dest ||
+        adj_list_type == AdjListType::unordered_by_dest) {
+      if (from.is_after_range()) {
         return false;
       }
-      if (from.global_chunk_index_ == global_chunk_index_) {
-        cur_offset_ = from.cur_offset_;
-      } else if (from.global_chunk_index_ < chunk_begin_ ||
-                 (from.global_chunk_index_ == chunk_begin_ &&
-                  from.cur_offset_ < offset_of_chunk_begin_)) {
-        this->to_begin();
-      } else {
-        global_chunk_index_ = from.global_chunk_index_;
-        cur_offset_ = from.cur_offset_;
-        vertex_chunk_index_ = from.vertex_chunk_index_;
-        this->refresh();
-      }
+      this->seek_from(from);
       while (!this->is_end()) {
         if (this->source() == id)
           return true;
@@ -521,241 +892,64 @@ class EdgeIter {
     }
 
     // unordered_by_source
-    if (adj_list_type_ == AdjListType::unordered_by_source) {
-      IdType expect_chunk_index = index_converter_->IndexPairToGlobalChunkIndex(
-          id / src_chunk_size_, 0);
-      if (expect_chunk_index > chunk_end_)
-        return false;
-      if (from.global_chunk_index_ > chunk_end_ ||
-          (from.global_chunk_index_ == chunk_end_ &&
-           from.cur_offset_ > offset_of_chunk_end_)) {
+    if (adj_list_type == AdjListType::unordered_by_source) {
+      return this->scan_unordered(from, id, context_->src_chunk_size, true);
+    }
+
+    // ordered_by_source
+    return this->seek_ordered(from, id, context_->src_chunk_size);
+  }
+
+  /**
+   * Let the input iterator to point to the first incoming edge of the
+   * vertex with specific id after the current position of the iterator.
+   *
+   * @param from The input iterator.
+   * @param id The vertex id.
+   * @return If such edge is found or not.
+   */
+  bool first_dst(const EdgeIter& from, IdType id) {
+    if (from.is_end())
+      return false;
+
+    AdjListType adj_list_type = context_->adj_list_type;
+    // ordered_by_source or unordered_by_source
+    if (adj_list_type == AdjListType::ordered_by_source ||
+        adj_list_type == AdjListType::unordered_by_source) {
+      if (from.is_after_range()) {
         return false;
       }
-      bool need_refresh = false;
-      if (from.global_chunk_index_ == global_chunk_index_) {
-        cur_offset_ = from.cur_offset_;
-      } else if (from.global_chunk_index_ < chunk_begin_ ||
-                 (from.global_chunk_index_ == chunk_begin_ &&
-                  from.cur_offset_ < offset_of_chunk_begin_)) {
-        this->to_begin();
-      } else {
-        global_chunk_index_ = from.global_chunk_index_;
-        cur_offset_ = from.cur_offset_;
-        vertex_chunk_index_ = from.vertex_chunk_index_;
-        need_refresh = true;
-      }
-      if (global_chunk_index_ < expect_chunk_index) {
-        global_chunk_index_ = expect_chunk_index;
-        cur_offset_ = 0;
-        vertex_chunk_index_ = id / src_chunk_size_;
-        need_refresh = true;
-      }
-      if (need_refresh)
-        this->refresh();
+      this->seek_from(from);
       while (!this->is_end()) {
-        if (this->source() == id)
+        if (this->destination() == id)
           return true;
-        if (vertex_chunk_index_ > id / src_chunk_size_)
-          return false;
         this->operator++();
       }
       return false;
     }
 
-    // ordered_by_source
-    auto st = offset_reader_->seek(id);
-    if (!st.ok()) {
-      return false;
-    }
-    auto maybe_offset_chunk = offset_reader_->GetChunk();
-    if (!maybe_offset_chunk.status().ok()) {
-      return false;
-    }
-    auto offset_array = std::dynamic_pointer_cast<arrow::Int64Array>(
-        maybe_offset_chunk.value());
-    auto begin_offset = static_cast<IdType>(offset_array->Value(0));
-    auto end_offset = static_cast<IdType>(offset_array->Value(1));
-    if (begin_offset >= end_offset) {
-      return false;
-    }
-    auto vertex_chunk_index_of_id = offset_reader_->GetChunkIndex();
-    auto begin_global_index = index_converter_->IndexPairToGlobalChunkIndex(
-        vertex_chunk_index_of_id, begin_offset / chunk_size_);
-    auto end_global_index = index_converter_->IndexPairToGlobalChunkIndex(
-        vertex_chunk_index_of_id, end_offset / chunk_size_);
-    if (begin_global_index <= from.global_chunk_index_ &&
-        from.global_chunk_index_ <= end_global_index) {
-      if (begin_offset < from.cur_offset_ && from.cur_offset_ < end_offset) {
-        global_chunk_index_ = from.global_chunk_index_;
-        cur_offset_ = from.cur_offset_;
-        vertex_chunk_index_ = from.vertex_chunk_index_;
-        refresh();
-        return true;
-      } else if (from.cur_offset_ <= begin_offset) {
-        global_chunk_index_ = begin_global_index;
-        cur_offset_ = begin_offset;
-        vertex_chunk_index_ = vertex_chunk_index_of_id;
-        refresh();
-        return true;
-      } else {
-        return false;
-      }
-    } else if (from.global_chunk_index_ < begin_global_index) {
-      global_chunk_index_ = begin_global_index;
-      cur_offset_ = begin_offset;
-      vertex_chunk_index_ = vertex_chunk_index_of_id;
-      refresh();
-      return true;
-    } else {
-      return false;
-    }
-  }
-
-  /**
-   * Let the input iterator to point to the first incoming edge of the
-   * vertex with specific id after the current position of the iterator.
-   *
-   * @param from The input iterator.
-   * @param id The vertex id.
-   * @return If such edge is found or not.
-   */
-  bool first_dst(const EdgeIter& from, IdType id) {
-    if (from.is_end())
-      return false;
-
-    // ordered_by_source or unordered_by_source
-    if (adj_list_type_ == AdjListType::ordered_by_source ||
-        adj_list_type_ == AdjListType::unordered_by_source) {
-      if (from.global_chunk_index_ > chunk_end_ ||
-          (from.global_chunk_index_ == chunk_end_ &&
-           from.cur_offset_ > offset_of_chunk_end_)) {
-        return false;
-      }
-      if (from.global_chunk_index_ == global_chunk_index_) {
-        cur_offset_ = from.cur_offset_;
-      } else if (from.global_chunk_index_ < chunk_begin_ ||
-                 (from.global_chunk_index_ == chunk_begin_ &&
-                  from.cur_offset_ < offset_of_chunk_begin_)) {
-        this->to_begin();
-      } else {
-        global_chunk_index_ = from.global_chunk_index_;
-        cur_offset_ = from.cur_offset_;
-        vertex_chunk_index_ = from.vertex_chunk_index_;
-        this->refresh();
-      }
-      while (!this->is_end()) {
-        if (this->destination() == id)
-          return true;
-        this->operator++();
-      }
-      return false;
-    }
-
-    // unordered_by_dest
-    if (adj_list_type_ == AdjListType::unordered_by_dest) {
-      IdType expect_chunk_index = index_converter_->IndexPairToGlobalChunkIndex(
-          id / dst_chunk_size_, 0);
-      if (expect_chunk_index > chunk_end_)
-        return false;
-      if (from.global_chunk_index_ > chunk_end_ ||
-          (from.global_chunk_index_ == chunk_end_ &&
-           from.cur_offset_ > offset_of_chunk_end_)) {
-        return false;
-      }
-      bool need_refresh = false;
-      if (from.global_chunk_index_ == global_chunk_index_) {
-        cur_offset_ = from.cur_offset_;
-      } else if (from.global_chunk_index_ < chunk_begin_ ||
-                 (from.global_chunk_index_ == chunk_begin_ &&
-                  from.cur_offset_ < offset_of_chunk_begin_)) {
-        this->to_begin();
-      } else {
-        global_chunk_index_ = from.global_chunk_index_;
-        cur_offset_ = from.cur_offset_;
-        vertex_chunk_index_ = from.vertex_chunk_index_;
-        need_refresh = true;
-      }
-      if (global_chunk_index_ < expect_chunk_index) {
-        global_chunk_index_ = expect_chunk_index;
-        cur_offset_ = 0;
-        vertex_chunk_index_ = id / dst_chunk_size_;
-        need_refresh = true;
-      }
-      if (need_refresh)
-        this->refresh();
-      while (!this->is_end()) {
-        if (this->destination() == id)
-          return true;
-        if (vertex_chunk_index_ > id / dst_chunk_size_)
-          return false;
-        this->operator++();
-      }
-      return false;
+    // unordered_by_dest
+    if (adj_list_type == AdjListType::unordered_by_dest) {
+      return this->scan_unordered(from, id, context_->dst_chunk_size, false);
     }
 
     // ordered_by_dest
-    auto st = offset_reader_->seek(id);
-    if (!st.ok()) {
-      return false;
-    }
-    auto maybe_offset_chunk = offset_reader_->GetChunk();
-    if (!maybe_offset_chunk.status().ok()) {
-      return false;
-    }
-    auto offset_array = std::dynamic_pointer_cast<arrow::Int64Array>(
-        maybe_offset_chunk.value());
-    auto begin_offset = static_cast<IdType>(offset_array->Value(0));
-    auto end_offset = static_cast<IdType>(offset_array->Value(1));
-    if (begin_offset >= end_offset) {
-      return false;
-    }
-    auto vertex_chunk_index_of_id = offset_reader_->GetChunkIndex();
-    auto begin_global_index = index_converter_->IndexPairToGlobalChunkIndex(
-        vertex_chunk_index_of_id, begin_offset / chunk_size_);
-    auto end_global_index = index_converter_->IndexPairToGlobalChunkIndex(
-        vertex_chunk_index_of_id, end_offset / chunk_size_);
-    if (begin_global_index <= from.global_chunk_index_ &&
-        from.global_chunk_index_ <= end_global_index) {
-      if (begin_offset < from.cur_offset_ && from.cur_offset_ < end_offset) {
-        global_chunk_index_ = from.global_chunk_index_;
-        cur_offset_ = from.cur_offset_;
-        vertex_chunk_index_ = from.vertex_chunk_index_;
-        refresh();
-        return true;
-      } else if (from.cur_offset_ <= begin_offset) {
-        global_chunk_index_ = begin_global_index;
-        cur_offset_ = begin_offset;
-        vertex_chunk_index_ = vertex_chunk_index_of_id;
-        refresh();
-        return true;
-      } else {
-        return false;
-      }
-    } else if (from.global_chunk_index_ < begin_global_index) {
-      global_chunk_index_ = begin_global_index;
-      cur_offset_ = begin_offset;
-      vertex_chunk_index_ = vertex_chunk_index_of_id;
-      refresh();
-      return true;
-    } else {
-      return false;
-    }
+    return this->seek_ordered(from, id, context_->dst_chunk_size);
   }
 
   /// Let the iterator to point to the begin.
   void to_begin() {
-    global_chunk_index_ = chunk_begin_;
-    cur_offset_ = offset_of_chunk_begin_;
+    global_chunk_index_ = context_->chunk_begin;
+    cur_offset_ = context_->offset_of_chunk_begin;
     vertex_chunk_index_ =
-        index_converter_->GlobalChunkIndexToIndexPair(global_chunk_index_)
-            .first;
-    refresh();
+        context_->index_converter->GlobalChunkIndexToIndexPair(
+            global_chunk_index_).first;
   }
 
   /// Check if the current position is the end.
   bool is_end() const {
-    return global_chunk_index_ == chunk_end_ &&
-           cur_offset_ == offset_of_chunk_end_;
+    return global_chunk_index_ == context_->chunk_end &&
+           cur_offset_ == context_->offset_of_chunk_end;
   }
 
   /// Point to the next edge with the same source, return false if not found.
@@ -764,7 +958,7 @@ class EdgeIter {
       return false;
     IdType id = this->source();
     IdType pre_vertex_chunk_index = vertex_chunk_index_;
-    if (adj_list_type_ == AdjListType::ordered_by_source) {
+    if (context_->adj_list_type == AdjListType::ordered_by_source) {
       this->operator++();
       if (is_end() || this->source() != id)
         return false;
@@ -776,7 +970,7 @@ class EdgeIter {
       if (this->source() == id) {
         return true;
       }
-      if (adj_list_type_ == AdjListType::unordered_by_source) {
+      if (context_->adj_list_type == AdjListType::unordered_by_source) {
         if (vertex_chunk_index_ > pre_vertex_chunk_index)
           return false;
       }
@@ -792,7 +986,7 @@ class EdgeIter {
       return false;
     IdType id = this->destination();
     IdType pre_vertex_chunk_index = vertex_chunk_index_;
-    if (adj_list_type_ == AdjListType::ordered_by_dest) {
+    if (context_->adj_list_type == AdjListType::ordered_by_dest) {
       this->operator++();
       if (is_end() || this->destination() != id)
         return false;
@@ -804,7 +998,7 @@ class EdgeIter {
       if (this->destination() == id) {
         return true;
       }
-      if (adj_list_type_ == AdjListType::unordered_by_dest) {
+      if (context_->adj_list_type == AdjListType::unordered_by_dest) {
         if (vertex_chunk_index_ > pre_vertex_chunk_index)
           return false;
       }
@@ -832,519 +1026,178 @@ class EdgeIter {
   }
 
  private:
-  /// Refresh the readers to point to the current position.
-  void refresh() {
-    adj_list_reader_.seek_chunk_index(vertex_chunk_index_);
-    adj_list_reader_.seek(cur_offset_);
-    for (auto& reader : property_readers_) {
-      reader.seek_chunk_index(vertex_chunk_index_);
-    }
-    GAR_ASSIGN_OR_RAISE_ERROR(num_row_of_chunk_,
-                              adj_list_reader_.GetRowNumOfChunk());
-  }
+  /// The adjList chunk at the cursor.
+  struct AdjListChunk {
+    AdjListChunk()
+        : src(GeneralParams::kSrcIndexCol), dst(GeneralParams::kDstIndexCol) {}
+    IdType global_chunk_index;
+    IdType num_rows;
+    PropertyColumn<IdType> src, dst;
+  };
 
- private:
-  AdjListArrowChunkReader adj_list_reader_;
-  std::shared_ptr<AdjListOffsetArrowChunkReader> offset_reader_;
-  std::vector<AdjListPropertyArrowChunkReader> property_readers_;
-  IdType global_chunk_index_;
-  IdType vertex_chunk_index_;
-  IdType cur_offset_;
-  IdType chunk_size_;
-  IdType src_chunk_size_;
-  IdType dst_chunk_size_;
-  IdType num_row_of_chunk_;
-  IdType chunk_begin_, chunk_end_;
-  IdType offset_of_chunk_begin_, offset_of_chunk_end_;
-  AdjListType adj_list_type_;
-  std::shared_ptr<util::IndexConverter> index_converter_;
-
-  friend class EdgesCollection<AdjListType::ordered_by_source>;
-  friend class EdgesCollection<AdjListType::ordered_by_dest>;
-  friend class EdgesCollection<AdjListType::unordered_by_source>;
-  friend class EdgesCollection<AdjListType::unordered_by_dest>;
-};
+  /// The property chunks at the cursor, one for each property group to read.
+  struct PropertyChunk {
+    IdType global_chunk_index;
+    std::vector<std::shared_ptr<arrow::Table>> tables;
+  };
 
-/**
- * @brief The implementation of EdgesCollection when the type of adjList is
- * AdjListType::ordered_by_source.
- *
- */
-template <>
-class EdgesCollection<AdjListType::ordered_by_source> {
- public:
-  static const AdjListType adj_list_type_ = AdjListType::ordered_by_source;
+  /// Load the adjList chunk at the cursor if it is not loaded.
+  Status loadChunk() noexcept;
 
-  /**
-   * @brief Initialize the EdgesCollection.
-   *
-   * @param edge_info The edge info that describes the edge type.
-   * @param prefix The absolute prefix.
-   */
-  EdgesCollection(const EdgeInfo& edge_info, const std::string& prefix)
-      : edge_info_(edge_info), prefix_(prefix), chunk_begin_(0) {
-    std::string base_dir;
-    GAR_ASSIGN_OR_RAISE_ERROR(auto fs,
-                              FileSystemFromUriOrPath(prefix, &base_dir));
-    GAR_ASSIGN_OR_RAISE_ERROR(auto dir_path,
-                              edge_info.GetAdjListDirPath(adj_list_type_));
-    base_dir += dir_path;
-    GAR_ASSIGN_OR_RAISE_ERROR(auto vertex_chunk_num,
-                              fs->GetFileNumOfDir(base_dir));
-    std::vector<IdType> edge_chunk_nums(vertex_chunk_num, 0);
-    chunk_end_ = 0;
-    for (size_t i = 0; i < vertex_chunk_num; ++i) {
-      std::string chunk_dir = base_dir + "/part" + std::to_string(i);
-      GAR_ASSIGN_OR_RAISE_ERROR(edge_chunk_nums[i],
-                                fs->GetFileNumOfDir(chunk_dir));
-      chunk_end_ += edge_chunk_nums[i];
-    }
-    index_converter_ =
-        std::make_shared<util::IndexConverter>(std::move(edge_chunk_nums));
-    offset_of_chunk_begin_ = 0;
-    offset_of_chunk_end_ = 0;
-  }
+  /// Load the property chunks at the cursor if they are not loaded.
+  Status loadPropertyChunk() noexcept;
 
-  /**
-   * @brief Initialize the EdgesCollection with a range of chunks.
-   *
-   * @param edge_info The edge info that describes the edge type.
-   * @param prefix The absolute prefix.
-   * @param chunk_begin The global index of the begin chunk.
-   * @param chunk_end The global index of the end chunk.
-   */
-  EdgesCollection(const EdgeInfo& edge_info, const std::string& prefix,
-                  IdType chunk_begin, IdType chunk_end)
-      : edge_info_(edge_info),
-        prefix_(prefix),
-        chunk_begin_(chunk_begin),
-        chunk_end_(chunk_end) {
-    std::string base_dir;
-    GAR_ASSIGN_OR_RAISE_ERROR(auto fs,
-                              FileSystemFromUriOrPath(prefix, &base_dir));
-    GAR_ASSIGN_OR_RAISE_ERROR(auto dir_path,
-                              edge_info.GetAdjListDirPath(adj_list_type_));
-    base_dir += dir_path;
-    GAR_ASSIGN_OR_RAISE_ERROR(auto vertex_chunk_num,
-                              fs->GetFileNumOfDir(base_dir));
-    std::vector<IdType> edge_chunk_nums(vertex_chunk_num, 0);
-    for (size_t i = 0; i < vertex_chunk_num; ++i) {
-      std::string chunk_dir = base_dir + "/part" + std::to_string(i);
-      GAR_ASSIGN_OR_RAISE_ERROR(edge_chunk_nums[i],
-                                fs->GetFileNumOfDir(chunk_dir));
-    }
-    index_converter_ =
-        std::make_shared<util::IndexConverter>(std::move(edge_chunk_nums));
-    offset_of_chunk_begin_ =
-        index_converter_->GlobalChunkIndexToIndexPair(chunk_begin).second *
-        edge_info.GetChunkSize();
-    offset_of_chunk_end_ =
-        index_converter_->GlobalChunkIndexToIndexPair(chunk_end).second *
-        edge_info.GetChunkSize();
-  }
-
-  /**
-   * @brief Initialize the EdgesCollection for a vertex chunk.
-   *
-   * @param edge_info The edge info that describes the edge type.
-   * @param prefix The absolute prefix.
-   * @param vertex_chunk_index The index of the vertex chunk.
-   */
-  EdgesCollection(const EdgeInfo& edge_info, const std::string& prefix,
-                  IdType vertex_chunk_index)
-      : edge_info_(edge_info), prefix_(prefix) {
-    std::string base_dir;
-    GAR_ASSIGN_OR_RAISE_ERROR(auto fs,
-                              FileSystemFromUriOrPath(prefix, &base_dir));
-    GAR_ASSIGN_OR_RAISE_ERROR(auto dir_path,
-                              edge_info.GetAdjListDirPath(adj_list_type_));
-    base_dir += dir_path;
-    IdType vertex_chunk_num = 0;
-    GAR_ASSIGN_OR_RAISE_ERROR(vertex_chunk_num, fs->GetFileNumOfDir(base_dir));
-    std::vector<IdType> edge_chunk_nums(vertex_chunk_num, 0);
-    chunk_begin_ = 0;
-    chunk_end_ = 0;
-    for (IdType i = 0; i < vertex_chunk_num; ++i) {
-      std::string chunk_dir = base_dir + "/part" + std::to_string(i);
-      GAR_ASSIGN_OR_RAISE_ERROR(edge_chunk_nums[i],
-                                fs->GetFileNumOfDir(chunk_dir));
-      if (i < vertex_chunk_index) {
-        chunk_begin_ += edge_chunk_nums[i];
-      }
-      if (i == vertex_chunk_index) {
-        chunk_end_ = chunk_begin_ + edge_chunk_nums[i];
-      }
-    }
-    index_converter_ =
-        std::make_shared<util::IndexConverter>(std::move(edge_chunk_nums));
-    offset_of_chunk_begin_ = 0;
-    offset_of_chunk_end_ = 0;
-  }
+  /// Get the offset range of the edges of a vertex in its vertex chunk, only
+  /// for the ordered adjList types.
+  Result<std::pair<IdType, IdType>> getOffsetRange(IdType id) noexcept;
 
-  /// The iterator pointing to the first edge.
-  EdgeIter begin() {
-    if (begin_ == nullptr) {
-      EdgeIter iter(edge_info_, prefix_, adj_list_type_, chunk_begin_,
-                    offset_of_chunk_begin_, chunk_begin_, chunk_end_,
-                    offset_of_chunk_begin_, offset_of_chunk_end_,
-                    index_converter_);
-      begin_ = std::make_shared<EdgeIter>(iter);
-    }
-    return *begin_;
+  /// Check if the position is after the range of the collection.
+  bool is_after_range() const {
+    return global_chunk_index_ > context_->chunk_end ||
+           (global_chunk_index_ == context_->chunk_end &&
+            cur_offset_ > context_->offset_of_chunk_end);
   }
 
-  /// The iterator pointing to the past-the-end element.
-  EdgeIter end() {
-    if (end_ == nullptr) {
-      EdgeIter iter(edge_info_, prefix_, adj_list_type_, chunk_end_,
-                    offset_of_chunk_end_, chunk_begin_, chunk_end_,
-                    offset_of_chunk_begin_, offset_of_chunk_end_,
-                    index_converter_);
-      end_ = std::make_shared<EdgeIter>(iter);
-    }
-    return *end_;
+  /// Check if the position is before the range of the collection.
+  bool is_before_range() const {
+    return global_chunk_index_ < context_->chunk_begin ||
+           (global_chunk_index_ == context_->chunk_begin &&
+            cur_offset_ < context_->offset_of_chunk_begin);
   }
 
-  /**
-   * Construct and return the iterator pointing to the first out-going edge of
-   * the vertex with specific id after the input iterator.
-   *
-   * @param id The vertex id.
-   * @param from The input iterator.
-   * @return The new constructed iterator.
-   */
-  EdgeIter find_src(IdType id, const EdgeIter& from) {
-    auto result = utils::GetAdjListOffsetOfVertex(edge_info_, prefix_,
-                                                  adj_list_type_, id);
-    if (!result.status().ok()) {
-      return this->end();
-    }
-    auto begin_offset = result.value().first;
-    auto end_offset = result.value().second;
-    if (begin_offset >= end_offset) {
-      return this->end();
-    }
-    auto begin_global_chunk_index =
-        index_converter_->IndexPairToGlobalChunkIndex(
-            id / edge_info_.GetSrcChunkSize(),
-            begin_offset / edge_info_.GetChunkSize());
-    auto end_global_chunk_index = index_converter_->IndexPairToGlobalChunkIndex(
-        id / edge_info_.GetSrcChunkSize(),
-        end_offset / edge_info_.GetChunkSize());
-    if (begin_global_chunk_index > from.global_chunk_index_) {
-      return EdgeIter(edge_info_, prefix_, adj_list_type_,
-                      begin_global_chunk_index, begin_offset, chunk_begin_,
-                      chunk_end_, offset_of_chunk_begin_, offset_of_chunk_end_,
-                      index_converter_);
-    } else if (end_global_chunk_index < from.global_chunk_index_) {
-      return this->end();
+  /// Move to the position of another iterator, or to the begin if the
+  /// position is before the range.
+  void seek_from(const EdgeIter& from) {
+    if (from.global_chunk_index_ == global_chunk_index_) {
+      cur_offset_ = from.cur_offset_;
+    } else if (from.is_before_range()) {
+      this->to_begin();
     } else {
-      if (begin_offset > from.cur_offset_) {
-        return EdgeIter(edge_info_, prefix_, adj_list_type_,
-                        begin_global_chunk_index, begin_offset, chunk_begin_,
-                        chunk_end_, offset_of_chunk_begin_,
-                        offset_of_chunk_end_, index_converter_);
-      } else if (end_offset <= from.cur_offset_) {
-        return this->end();
-      } else {
-        return EdgeIter(edge_info_, prefix_, adj_list_type_,
-                        from.global_chunk_index_, from.cur_offset_,
-                        chunk_begin_, chunk_end_, offset_of_chunk_begin_,
-                        offset_of_chunk_end_, index_converter_);
-      }
-    }
-    return this->end();
-  }
-
-  /**
-   * Construct and return the iterator pointing to the first incoming edge of
-   * the vertex with specific id after the input iterator.
-   *
-   * @param id The vertex id.
-   * @param from The input iterator.
-   * @return The new constructed iterator.
-   */
-  EdgeIter find_dst(IdType id, const EdgeIter& from) {
-    EdgeIter iter(from);
-    auto end = this->end();
-    while (iter != end) {
-      auto edge = *iter;
-      if (edge.destination() == id) {
-        break;
-      }
-      ++iter;
+      global_chunk_index_ = from.global_chunk_index_;
+      cur_offset_ = from.cur_offset_;
+      vertex_chunk_index_ = from.vertex_chunk_index_;
     }
-    return iter;
   }
 
- private:
-  EdgeInfo edge_info_;
-  std::string prefix_;
-  IdType chunk_begin_, chunk_end_;
-  IdType offset_of_chunk_begin_, offset_of_chunk_end_;
-  std::shared_ptr<util::IndexConverter> index_converter_;
-  std::shared_ptr<EdgeIter> begin_, end_;
-};
-
-/**
- * @brief The implementation of EdgesCollection when the type of adjList is
- * AdjListType::ordered_by_dest.
- *
- */
-template <>
-class EdgesCollection<AdjListType::ordered_by_dest> {
- public:
-  static const AdjListType adj_list_type_ = AdjListType::ordered_by_dest;
-
-  /**
-   * @brief Initialize the EdgesCollection.
-   *
-   * @param edge_info The edge info that describes the edge type.
-   * @param prefix The absolute prefix.
-   */
-  EdgesCollection(const EdgeInfo& edge_info, const std::string& prefix)
-      : edge_info_(edge_info), prefix_(prefix), chunk_begin_(0) {
-    std::string base_dir;
-    GAR_ASSIGN_OR_RAISE_ERROR(auto fs,
-                              FileSystemFromUriOrPath(prefix, &base_dir));
-    GAR_ASSIGN_OR_RAISE_ERROR(auto dir_path,
-                              edge_info.GetAdjListDirPath(adj_list_type_));
-    base_dir += dir_path;
-    GAR_ASSIGN_OR_RAISE_ERROR(auto vertex_chunk_num,
-                              fs->GetFileNumOfDir(base_dir));
-    std::vector<IdType> edge_chunk_nums(vertex_chunk_num, 0);
-    chunk_end_ = 0;
-    for (size_t i = 0; i < vertex_chunk_num; ++i) {
-      std::string chunk_dir = base_dir + "/part" + std::to_string(i);
-      GAR_ASSIGN_OR_RAISE_ERROR(edge_chunk_nums[i],
-                                fs->GetFileNumOfDir(chunk_dir));
-      chunk_end_ += edge_chunk_nums[i];
-    }
-    index_converter_ =
-        std::make_shared<util::IndexConverter>(std::move(edge_chunk_nums));
-    offset_of_chunk_begin_ = 0;
-    offset_of_chunk_end_ = 0;
-  }
-
-  /**
-   * @brief Initialize the EdgesCollection with a range of chunks.
-   *
-   * @param edge_info The edge info that describes the edge type.
-   * @param prefix The absolute prefix.
-   * @param chunk_begin The global index of the begin chunk.
-   * @param chunk_end The global index of the end chunk.
-   */
-  EdgesCollection(const EdgeInfo& edge_info, const std::string& prefix,
-                  IdType chunk_begin, IdType chunk_end)
-      : edge_info_(edge_info),
-        prefix_(prefix),
-        chunk_begin_(chunk_begin),
-        chunk_end_(chunk_end) {
-    std::string base_dir;
-    GAR_ASSIGN_OR_RAISE_ERROR(auto fs,
-                              FileSystemFromUriOrPath(prefix, &base_dir));
-    GAR_ASSIGN_OR_RAISE_ERROR(auto dir_path,
-                              edge_info.GetAdjListDirPath(adj_list_type_));
-    base_dir += dir_path;
-    GAR_ASSIGN_OR_RAISE_ERROR(auto vertex_chunk_num,
-                              fs->GetFileNumOfDir(base_dir));
-    std::vector<IdType> edge_chunk_nums(vertex_chunk_num, 0);
-    for (size_t i = 0; i < vertex_chunk_num; ++i) {
-      std::string chunk_dir = base_dir + "/part" + std::to_string(i);
-      GAR_ASSIGN_OR_RAISE_ERROR(edge_chunk_nums[i],
-                                fs->GetFileNumOfDir(chunk_dir));
-    }
-    index_converter_ =
-        std::make_shared<util::IndexConverter>(std::move(edge_chunk_nums));
-    offset_of_chunk_begin_ =
-        index_converter_->GlobalChunkIndexToIndexPair(chunk_begin).second *
-        edge_info.GetChunkSize();
-    offset_of_chunk_end_ =
-        index_converter_->GlobalChunkIndexToIndexPair(chunk_end).second *
-        edge_info.GetChunkSize();
-  }
-
-  /**
-   * @brief Initialize the EdgesCollection for a vertex chunk.
-   *
-   * @param edge_info The edge info that describes the edge type.
-   * @param prefix The absolute prefix.
-   * @param vertex_chunk_index The index of the vertex chunk.
-   */
-  EdgesCollection(const EdgeInfo& edge_info, const std::string& prefix,
-                  IdType vertex_chunk_index)
-      : edge_info_(edge_info), prefix_(prefix) {
-    std::string base_dir;
-    GAR_ASSIGN_OR_RAISE_ERROR(auto fs,
-                              FileSystemFromUriOrPath(prefix, &base_dir));
-    GAR_ASSIGN_OR_RAISE_ERROR(auto dir_path,
-                              edge_info.GetAdjListDirPath(adj_list_type_));
-    base_dir += dir_path;
-    IdType vertex_chunk_num = 0;
-    GAR_ASSIGN_OR_RAISE_ERROR(vertex_chunk_num, fs->GetFileNumOfDir(base_dir));
-    std::vector<IdType> edge_chunk_nums(vertex_chunk_num, 0);
-    chunk_begin_ = 0;
-    chunk_end_ = 0;
-    for (IdType i = 0; i < vertex_chunk_num; ++i) {
-      std::string chunk_dir = base_dir + "/part" + std::to_string(i);
-      GAR_ASSIGN_OR_RAISE_ERROR(edge_chunk_nums[i],
-                                fs->GetFileNumOfDir(chunk_dir));
-      if (i < vertex_chunk_index) {
-        chunk_begin_ += edge_chunk_nums[i];
-      }
-      if (i == vertex_chunk_index) {
-        chunk_end_ = chunk_begin_ + edge_chunk_nums[i];
-      }
+  /// Find the first edge of a vertex after the position of another iterator
+  /// for the unordered adjList types, the edges of the vertex are all in
+  /// the vertex chunk of the vertex.
+  bool scan_unordered(const EdgeIter& from, IdType id,
+                      IdType vertex_chunk_size, bool by_source) {
+    IdType vertex_chunk_index_of_id = id / vertex_chunk_size;
+    if (vertex_chunk_index_of_id >=
+        context_->index_converter->GetVertexChunkNum()) {
+      return false;
     }
-    index_converter_ =
-        std::make_shared<util::IndexConverter>(std::move(edge_chunk_nums));
-    offset_of_chunk_begin_ = 0;
-    offset_of_chunk_end_ = 0;
-  }
-
-  /// The iterator pointing to the first edge.
-  EdgeIter begin() {
-    if (begin_ == nullptr) {
-      EdgeIter iter(edge_info_, prefix_, adj_list_type_, chunk_begin_,
-                    offset_of_chunk_begin_, chunk_begin_, chunk_end_,
-                    offset_of_chunk_begin_, offset_of_chunk_end_,
-                    index_converter_);
-      begin_ = std::make_shared<EdgeIter>(iter);
+    IdType expect_chunk_index =
+        context_->index_converter->IndexPairToGlobalChunkIndex(
+            vertex_chunk_index_of_id, 0);
+    if (expect_chunk_index > context_->chunk_end)
+      return false;
+    if (from.is_after_range()) {
+      return false;
     }
-    return *begin_;
-  }
-
-  /// The iterator pointing to the past-the-end element.
-  EdgeIter end() {
-    if (end_ == nullptr) {
-      EdgeIter iter(edge_info_, prefix_, adj_list_type_, chunk_end_,
-                    offset_of_chunk_end_, chunk_begin_, chunk_end_,
-                    offset_of_chunk_begin_, offset_of_chunk_end_,
-                    index_converter_);
-      end_ = std::make_shared<EdgeIter>(iter);
+    this->seek_from(from);
+    if (global_chunk_index_ < expect_chunk_index) {
+      global_chunk_index_ = expect_chunk_index;
+      cur_offset_ = 0;
+      vertex_chunk_index_ = vertex_chunk_index_of_id;
     }
-    return *end_;
-  }
-
-  /**
-   * Construct and return the iterator pointing to the first out-going edge of
-   * the vertex with specific id after the input iterator.
-   *
-   * @param id The vertex id.
-   * @param from The input iterator.
-   * @return The new constructed iterator.
-   */
-  EdgeIter find_src(IdType id, const EdgeIter& from) {
-    EdgeIter iter(from);
-    auto end = this->end();
-    while (iter != end) {
-      auto edge = *iter;
-      if (edge.source() == id) {
-        break;
-      }
-      ++iter;
+    while (!this->is_end()) {
+      if ((by_source ? this->source() : this->destination()) == id)
+        return true;
+      if (vertex_chunk_index_ > vertex_chunk_index_of_id)
+        return false;
+      this->operator++();
     }
-    return iter;
+    return false;
   }
 
-  /**
-   * Construct and return the iterator pointing to the first incoming edge of
-   * the vertex with specific id after the input iterator.
-   *
-   * @param id The vertex id.
-   * @param from The input iterator.
-   * @return The new constructed iterator.
-   */
-  EdgeIter find_dst(IdType id, const EdgeIter& from) {
-    auto result = utils::GetAdjListOffsetOfVertex(edge_info_, prefix_,
-                                                  adj_list_type_, id);
-    if (!result.status().ok()) {
-      return this->end();
+  /// Find the first edge of a vertex after the position of another iterator
+  /// for the ordered adjList types through the offset chunk.
+  bool seek_ordered(const EdgeIter& from, IdType id,
+                    IdType vertex_chunk_size) {
+    auto maybe_range = this->getOffsetRange(id);
+    if (!maybe_range.status().ok()) {
+      return false;
     }
-    auto begin_offset = result.value().first;
-    auto end_offset = result.value().second;
+    auto begin_offset = maybe_range.value().first;
+    auto end_offset = maybe_range.value().second;
     if (begin_offset >= end_offset) {
-      return this->end();
+      return false;
     }
-    auto begin_global_chunk_index =
-        index_converter_->IndexPairToGlobalChunkIndex(
-            id / edge_info_.GetDstChunkSize(),
-            begin_offset / edge_info_.GetChunkSize());
-    auto end_global_chunk_index = index_converter_->IndexPairToGlobalChunkIndex(
-        id / edge_info_.GetDstChunkSize(),
-        end_offset / edge_info_.GetChunkSize());
-    if (begin_global_chunk_index > from.global_chunk_index_) {
-      return EdgeIter(edge_info_, prefix_, adj_list_type_,
-                      begin_global_chunk_index, begin_offset, chunk_begin_,
-                      chunk_end_, offset_of_chunk_begin_, offset_of_chunk_end_,
-                      index_converter_);
-    } else if (end_global_chunk_index < from.global_chunk_index_) {
-      return this->end();
-    } else {
-      if (begin_offset >= from.cur_offset_) {
-        return EdgeIter(edge_info_, prefix_, adj_list_type_,
-                        begin_global_chunk_index, begin_offset, chunk_begin_,
-                        chunk_end_, offset_of_chunk_begin_,
-                        offset_of_chunk_end_, index_converter_);
-      } else if (end_offset <= from.cur_offset_) {
-        return this->end();
+    auto vertex_chunk_index_of_id = id / vertex_chunk_size;
+    auto chunk_size = context_->chunk_size;
+    auto begin_global_index =
+        context_->index_converter->IndexPairToGlobalChunkIndex(
+            vertex_chunk_index_of_id, begin_offset / chunk_size);
+    auto end_global_index =
+        context_->index_converter->IndexPairToGlobalChunkIndex(
+            vertex_chunk_index_of_id, end_offset / chunk_size);
+    if (begin_global_index <= from.global_chunk_index_ &&
+        from.global_chunk_index_ <= end_global_index) {
+      if (begin_offset < from.cur_offset_ && from.cur_offset_ < end_offset) {
+        global_chunk_index_ = from.global_chunk_index_;
+        cur_offset_ = from.cur_offset_;
+        vertex_chunk_index_ = from.vertex_chunk_index_;
+        return true;
+      } else if (from.cur_offset_ <= begin_offset) {
+        global_chunk_index_ = begin_global_index;
+        cur_offset_ = begin_offset;
+        vertex_chunk_index_ = vertex_chunk_index_of_id;
+        return true;
       } else {
-        return EdgeIter(edge_info_, prefix_, adj_list_type_,
-                        from.global_chunk_index_, from.cur_offset_,
-                        chunk_begin_, chunk_end_, offset_of_chunk_begin_,
-                        offset_of_chunk_end_, index_converter_);
+        return false;
       }
+    } else if (from.global_chunk_index_ < begin_global_index) {
+      global_chunk_index_ = begin_global_index;
+      cur_offset_ = begin_offset;
+      vertex_chunk_index_ = vertex_chunk_index_of_id;
+      return true;
+    } else {
+      return false;
     }
-    return this->end();
   }
 
  private:
-  EdgeInfo edge_info_;
-  std::string prefix_;
-  IdType chunk_begin_, chunk_end_;
-  IdType offset_of_chunk_begin_, offset_of_chunk_end_;
-  std::shared_ptr<util::IndexConverter> index_converter_;
-  std::shared_ptr<EdgeIter> begin_, end_;
+  std::shared_ptr<const EdgesCollectionContext> context_;
+  std::shared_ptr<const AdjListChunk> chunk_;
+  std::shared_ptr<const PropertyChunk> property_chunk_;
+  std::shared_ptr<arrow::Int64Array> offsets_;
+  IdType offsets_chunk_index_;
+  IdType global_chunk_index_;
+  IdType vertex_chunk_index_;
+  IdType cur_offset_;
 };
 
 /**
- * @brief The implementation of EdgesCollection when the type of adjList is
- * AdjListType::unordered_by_source.
+ * @brief EdgesCollection is designed for reading a collection of edges.
+ *
+ * The collection only holds a pointer to its immutable state, which is
+ * shared with all of its iterators.
  *
+ * @tparam adj_list_type The type of adjList.
  */
-template <>
-class EdgesCollection<AdjListType::unordered_by_source> {
+template <AdjListType adj_list_type>
+class EdgesCollection {
  public:
-  static const AdjListType adj_list_type_ = AdjListType::unordered_by_source;
+  static constexpr AdjListType adj_list_type_ = adj_list_type;
 
   /**
    * @brief Initialize the EdgesCollection.
    *
    * @param edge_info The edge info that describes the edge type.
    * @param prefix The absolute prefix.
+   * @param property_groups The property groups to read, all of the property
+   * groups of the adj list type are read if not given.
    */
-  EdgesCollection(const EdgeInfo& edge_info, const std::string& prefix)
-      : edge_info_(edge_info), prefix_(prefix), chunk_begin_(0) {
-    std::string base_dir;
-    GAR_ASSIGN_OR_RAISE_ERROR(auto fs,
-                              FileSystemFromUriOrPath(prefix, &base_dir));
-    GAR_ASSIGN_OR_RAISE_ERROR(auto dir_path,
-                              edge_info.GetAdjListDirPath(adj_list_type_));
-    base_dir += dir_path;
-    GAR_ASSIGN_OR_RAISE_ERROR(auto vertex_chunk_num,
-                              fs->GetFileNumOfDir(base_dir));
-    std::vector<IdType> edge_chunk_nums(vertex_chunk_num, 0);
-    chunk_end_ = 0;
-    for (size_t i = 0; i < vertex_chunk_num; ++i) {
-      std::string chunk_dir = base_dir + "/part" + std::to_string(i);
-      GAR_ASSIGN_OR_RAISE_ERROR(edge_chunk_nums[i],
-                                fs->GetFileNumOfDir(chunk_dir));
-      chunk_end_ += edge_chunk_nums[i];
-    }
-    index_converter_ =
-        std::make_shared<util::IndexConverter>(std::move(edge_chunk_nums));
-    offset_of_chunk_begin_ = 0;
-    offset_of_chunk_end_ = 0;
+  EdgesCollection(const EdgeInfo& edge_info, const std::string& prefix,
+                  const std::optional<std::vector<PropertyGroup>>&
+                      property_groups = std::nullopt) {
+    GAR_ASSIGN_OR_RAISE_ERROR(
+        context_,
+        EdgesCollectionContext::Make(edge_info, prefix, adj_list_type_,
+                                     property_groups));
   }
 
   /**
@@ -1354,35 +1207,17 @@ class EdgesCollection<AdjListType::unordered_by_source> {
    * @param prefix The absolute prefix.
    * @param chunk_begin The global index of the begin chunk.
    * @param chunk_end The global index of the end chunk.
+   * @param property_groups The property groups to read, all of the property
+   * groups of the adj list type are read if not given.
    */
   EdgesCollection(const EdgeInfo& edge_info, const std::string& prefix,
-                  IdType chunk_begin, IdType chunk_end)
-      : edge_info_(edge_info),
-        prefix_(prefix),
-        chunk_begin_(chunk_begin),
-        chunk_end_(chunk_end) {
-    std::string base_dir;
-    GAR_ASSIGN_OR_RAISE_ERROR(auto fs,
-                              FileSystemFromUriOrPath(prefix, &base_dir));
-    GAR_ASSIGN_OR_RAISE_ERROR(auto dir_path,
-                              edge_info.GetAdjListDirPath(adj_list_type_));
-    base_dir += dir_path;
-    GAR_ASSIGN_OR_RAISE_ERROR(auto vertex_chunk_num,
-                              fs->GetFileNumOfDir(base_dir));
-    std::vector<IdType> edge_chunk_nums(vertex_chunk_num, 0);
-    for (size_t i = 0; i < vertex_chunk_num; ++i) {
-      std::string chunk_dir = base_dir + "/part" + std::to_string(i);
-      GAR_ASSIGN_OR_RAISE_ERROR(edge_chunk_nums[i],
-                                fs->GetFileNumOfDir(chunk_dir));
-    }
-    index_converter_ =
-        std::make_shared<util::IndexConverter>(std::move(edge_chunk_nums));
-    offset_of_chunk_begin_ =
-        index_converter_->GlobalChunkIndexToIndexPair(chunk_begin).second *
-        edge_info.GetChunkSize();
-    offset_of_chunk_end_ =
-        index_converter_->GlobalChunkIndexToIndexPair(chunk_end).second *
-        edge_info.GetChunkSize();
+                  IdType chunk_begin, IdType chunk_end,
+                  const std::optional<std::vector<PropertyGroup>>&
+                      property_groups = std::nullopt) {
+    GAR_ASSIGN_OR_RAISE_ERROR(
+        context_,
+        EdgesCollectionContext::Make(edge_info, prefix, adj_list_type_,
+                                     chunk_begin, chunk_end, property_groups));
   }
 
   /**
@@ -1391,60 +1226,29 @@ class EdgesCollection<AdjListType::unordered_by_source> {
    * @param edge_info The edge info that describes the edge type.
    * @param prefix The absolute prefix.
    * @param vertex_chunk_index The index of the vertex chunk.
+   * @param property_groups The property groups to read, all of the property
+   * groups of the adj list type are read if not given.
    */
   EdgesCollection(const EdgeInfo& edge_info, const std::string& prefix,
-                  IdType vertex_chunk_index)
-      : edge_info_(edge_info), prefix_(prefix) {
-    std::string base_dir;
-    GAR_ASSIGN_OR_RAISE_ERROR(auto fs,
-                              FileSystemFromUriOrPath(prefix, &base_dir));
-    GAR_ASSIGN_OR_RAISE_ERROR(auto dir_path,
-                              edge_info.GetAdjListDirPath(adj_list_type_));
-    base_dir += dir_path;
-    IdType vertex_chunk_num = 0;
-    GAR_ASSIGN_OR_RAISE_ERROR(vertex_chunk_num, fs->GetFileNumOfDir(base_dir));
-    std::vector<IdType> edge_chunk_nums(vertex_chunk_num, 0);
-    chunk_begin_ = 0;
-    chunk_end_ = 0;
-    for (IdType i = 0; i < vertex_chunk_num; ++i) {
-      std::string chunk_dir = base_dir + "/part" + std::to_string(i);
-      GAR_ASSIGN_OR_RAISE_ERROR(edge_chunk_nums[i],
-                                fs->GetFileNumOfDir(chunk_dir));
-      if (i < vertex_chunk_index) {
-        chunk_begin_ += edge_chunk_nums[i];
-      }
-      if (i == vertex_chunk_index) {
-        chunk_end_ = chunk_begin_ + edge_chunk_nums[i];
-      }
-    }
-    index_converter_ =
-        std::make_shared<util::IndexConverter>(std::move(edge_chunk_nums));
-    offset_of_chunk_begin_ = 0;
-    offset_of_chunk_end_ = 0;
+                  IdType vertex_chunk_index,
+                  const std::optional<std::vector<PropertyGroup>>&
+                      property_groups = std::nullopt) {
+    GAR_ASSIGN_OR_RAISE_ERROR(
+        context_,
+        EdgesCollectionContext::Make(edge_info, prefix, adj_list_type_,
+                                     vertex_chunk_index, property_groups));
   }
 
   /// The iterator pointing to the first edge.
-  EdgeIter begin() {
-    if (begin_ == nullptr) {
-      EdgeIter iter(edge_info_, prefix_, adj_list_type_, chunk_begin_,
-                    offset_of_chunk_begin_, chunk_begin_, chunk_end_,
-                    offset_of_chunk_begin_, offset_of_chunk_end_,
-                    index_converter_);
-      begin_ = std::make_shared<EdgeIter>(iter);
-    }
-    return *begin_;
+  EdgeIter begin() const noexcept {
+    return EdgeIter(context_, context_->chunk_begin,
+                    context_->offset_of_chunk_begin);
   }
 
   /// The iterator pointing to the past-the-end element.
-  EdgeIter end() {
-    if (end_ == nullptr) {
-      EdgeIter iter(edge_info_, prefix_, adj_list_type_, chunk_end_,
-                    offset_of_chunk_end_, chunk_begin_, chunk_end_,
-                    offset_of_chunk_begin_, offset_of_chunk_end_,
-                    index_converter_);
-      end_ = std::make_shared<EdgeIter>(iter);
-    }
-    return *end_;
+  EdgeIter end() const noexcept {
+    return EdgeIter(context_, context_->chunk_end,
+                    context_->offset_of_chunk_end);
   }
 
   /**
@@ -1455,17 +1259,12 @@ class EdgesCollection<AdjListType::unordered_by_source> {
    * @param from The input iterator.
    * @return The new constructed iterator.
    */
-  EdgeIter find_src(IdType id, const EdgeIter& from) {
+  EdgeIter find_src(IdType id, const EdgeIter& from) const {
     EdgeIter iter(from);
-    auto end = this->end();
-    while (iter != end) {
-      auto edge = *iter;
-      if (edge.source() == id) {
-        break;
-      }
-      ++iter;
+    if (iter.first_src(from, id)) {
+      return iter;
     }
-    return iter;
+    return this->end();
   }
 
   /**
@@ -1476,217 +1275,58 @@ class EdgesCollection<AdjListType::unordered_by_source> {
    * @param from The input iterator.
    * @return The new constructed iterator.
    */
-  EdgeIter find_dst(IdType id, const EdgeIter& from) {
+  EdgeIter find_dst(IdType id, const EdgeIter& from) const {
     EdgeIter iter(from);
-    auto end = this->end();
-    while (iter != end) {
-      auto edge = *iter;
-      if (edge.destination() == id) {
-        break;
-      }
-      ++iter;
+    if (iter.first_dst(from, id)) {
+      return iter;
     }
-    return iter;
+    return this->end();
   }
 
- private:
-  EdgeInfo edge_info_;
-  std::string prefix_;
-  IdType chunk_begin_, chunk_end_;
-  IdType offset_of_chunk_begin_, offset_of_chunk_end_;
-  std::shared_ptr<util::IndexConverter> index_converter_;
-  std::shared_ptr<EdgeIter> begin_, end_;
-};
-
-/**
- * @brief The implementation of EdgesCollection when the type of adjList is
- * AdjListType::unordered_by_dest.
- *
- */
-template <>
-class EdgesCollection<AdjListType::unordered_by_dest> {
- public:
-  static const AdjListType adj_list_type_ = AdjListType::unordered_by_dest;
-
   /**
-   * @brief Initialize the EdgesCollection.
+   * @brief Get the neighbors of a vertex, only for the ordered adjList types.
    *
-   * @param edge_info The edge info that describes the edge type.
-   * @param prefix The absolute prefix.
-   */
-  EdgesCollection(const EdgeInfo& edge_info, const std::string& prefix)
-      : edge_info_(edge_info), prefix_(prefix), chunk_begin_(0) {
-    std::string base_dir;
-    GAR_ASSIGN_OR_RAISE_ERROR(auto fs,
-                              FileSystemFromUriOrPath(prefix, &base_dir));
-    GAR_ASSIGN_OR_RAISE_ERROR(auto dir_path,
-                              edge_info.GetAdjListDirPath(adj_list_type_));
-    base_dir += dir_path;
-    IdType vertex_chunk_num = 0;
-    GAR_ASSIGN_OR_RAISE_ERROR(vertex_chunk_num, fs->GetFileNumOfDir(base_dir));
-    std::vector<IdType> edge_chunk_nums(vertex_chunk_num, 0);
-    chunk_end_ = 0;
-    for (IdType i = 0; i < vertex_chunk_num; ++i) {
-      std::string chunk_dir = base_dir + "/part" + std::to_string(i);
-      GAR_ASSIGN_OR_RAISE_ERROR(edge_chunk_nums[i],
-                                fs->GetFileNumOfDir(chunk_dir));
-      chunk_end_ += edge_chunk_nums[i];
-    }
-    index_converter_ =
-        std::make_shared<util::IndexConverter>(std::move(edge_chunk_nums));
-    offset_of_chunk_begin_ = 0;
-    offset_of_chunk_end_ = 0;
-  }
-
-  /**
-   * @brief Initialize the EdgesCollection with a range of chunks.
+   * The neighbors are the destinations of the out-going edges for
+   * ordered_by_source, or the sources of the incoming edges for
+   * ordered_by_dest. The offset chunks and adjList chunks are cached by the
+   * collection, so a query on a cached chunk reads no file. The query is not
+   * limited to the chunk range of the collection.
    *
-   * @param edge_info The edge info that describes the edge type.
-   * @param prefix The absolute prefix.
-   * @param chunk_begin The global index of the begin chunk.
-   * @param chunk_end The global index of the end chunk.
+   * @param vid The id of the vertex.
+   * @param with_properties Whether to load the properties of the edges.
+   * @return The neighbors or error.
    */
-  EdgesCollection(const EdgeInfo& edge_info, const std::string& prefix,
-                  IdType chunk_begin, IdType chunk_end)
-      : edge_info_(edge_info),
-        prefix_(prefix),
-        chunk_begin_(chunk_begin),
-        chunk_end_(chunk_end) {
-    std::string base_dir;
-    GAR_ASSIGN_OR_RAISE_ERROR(auto fs,
-                              FileSystemFromUriOrPath(prefix, &base_dir));
-    GAR_ASSIGN_OR_RAISE_ERROR(auto dir_path,
-                              edge_info.GetAdjListDirPath(adj_list_type_));
-    base_dir += dir_path;
-    GAR_ASSIGN_OR_RAISE_ERROR(auto vertex_chunk_num,
-                              fs->GetFileNumOfDir(base_dir));
-    std::vector<IdType> edge_chunk_nums(vertex_chunk_num, 0);
-    for (size_t i = 0; i < vertex_chunk_num; ++i) {
-      std::string chunk_dir = base_dir + "/part" + std::to_string(i);
-      GAR_ASSIGN_OR_RAISE_ERROR(edge_chunk_nums[i],
-                                fs->GetFileNumOfDir(chunk_dir));
-    }
-    index_converter_ =
-        std::make_shared<util::IndexConverter>(std::move(edge_chunk_nums));
-    offset_of_chunk_begin_ =
-        index_converter_->GlobalChunkIndexToIndexPair(chunk_begin).second *
-        edge_info.GetChunkSize();
-    offset_of_chunk_end_ =
-        index_converter_->GlobalChunkIndexToIndexPair(chunk_end).second *
-        edge_info.GetChunkSize();
+  Result<NeighborRange> Neighbors(IdType vid,
+                                  bool with_properties = false) const noexcept {
+    return context_->neighbor_cache->Neighbors(*context_, vid,
+                                               with_properties);
   }
 
   /**
-   * @brief Initialize the EdgesCollection for a vertex chunk.
+   * @brief Get the neighbors of a batch of vertices, only for the ordered
+   * adjList types.
    *
-   * @param edge_info The edge info that describes the edge type.
-   * @param prefix The absolute prefix.
-   * @param vertex_chunk_index The index of the vertex chunk.
-   */
-  EdgesCollection(const EdgeInfo& edge_info, const std::string& prefix,
-                  IdType vertex_chunk_index)
-      : edge_info_(edge_info), prefix_(prefix) {
-    std::string base_dir;
-    GAR_ASSIGN_OR_RAISE_ERROR(auto fs,
-                              FileSystemFromUriOrPath(prefix, &base_dir));
-    GAR_ASSIGN_OR_RAISE_ERROR(auto dir_path,
-                              edge_info.GetAdjListDirPath(adj_list_type_));
-    base_dir += dir_path;
-    IdType vertex_chunk_num = 0;
-    GAR_ASSIGN_OR_RAISE_ERROR(vertex_chunk_num, fs->GetFileNumOfDir(base_dir));
-    std::vector<IdType> edge_chunk_nums(vertex_chunk_num, 0);
-    chunk_begin_ = 0;
-    chunk_end_ = 0;
-    for (IdType i = 0; i < vertex_chunk_num; ++i) {
-      std::string chunk_dir = base_dir + "/part" + std::to_string(i);
-      GAR_ASSIGN_OR_RAISE_ERROR(edge_chunk_nums[i],
-                                fs->GetFileNumOfDir(chunk_dir));
-      if (i < vertex_chunk_index) {
-        chunk_begin_ += edge_chunk_nums[i];
-      }
-      if (i == vertex_chunk_index) {
-        chunk_end_ = chunk_begin_ + edge_chunk_nums[i];
-      }
-    }
-    index_converter_ =
-        std::make_shared<util::IndexConverter>(std::move(edge_chunk_nums));
-    offset_of_chunk_begin_ = 0;
-    offset_of_chunk_end_ = 0;
-  }
-
-  /// The iterator pointing to the first edge.
-  EdgeIter begin() {
-    if (begin_ == nullptr) {
-      EdgeIter iter(edge_info_, prefix_, adj_list_type_, chunk_begin_,
-                    offset_of_chunk_begin_, chunk_begin_, chunk_end_,
-                    offset_of_chunk_begin_, offset_of_chunk_end_,
-                    index_converter_);
-      begin_ = std::make_shared<EdgeIter>(iter);
-    }
-    return *begin_;
-  }
-
-  /// The iterator pointing to the past-the-end element.
-  EdgeIter end() {
-    if (end_ == nullptr) {
-      EdgeIter iter(edge_info_, prefix_, adj_list_type_, chunk_end_,
-                    offset_of_chunk_end_, chunk_begin_, chunk_end_,
-                    offset_of_chunk_begin_, offset_of_chunk_end_,
-                    index_converter_);
-      end_ = std::make_shared<EdgeIter>(iter);
-    }
-    return *end_;
-  }
-
-  /**
-   * Construct and return the iterator pointing to the first out-going edge of
-   * the vertex with specific id after the input iterator.
+   * The ids are grouped by the chunks they need, each of which is loaded
+   * once, in parallel.
    *
-   * @param id The vertex id.
-   * @param from The input iterator.
-   * @return The new constructed iterator.
+   * @param vids The ids of the vertices, in any order.
+   * @param thread_num The number of threads to load the chunks, the number of
+   *     hardware threads is used if it is not positive.
+   * @return The neighbors in CSR form, in the order of the ids, or error.
    */
-  EdgeIter find_src(IdType id, const EdgeIter& from) {
-    EdgeIter iter(from);
-    auto end = this->end();
-    while (iter != end) {
-      auto edge = *iter;
-      if (edge.source() == id) {
-        break;
-      }
-      ++iter;
-    }
-    return iter;
+  Result<NeighborBatch> BatchNeighbors(const std::vector<IdType>& vids,
+                                       int thread_num = 0) const noexcept {
+    return context_->neighbor_cache->BatchNeighbors(*context_, vids,
+                                                    thread_num);
   }
 
-  /**
-   * Construct and return the iterator pointing to the first incoming edge of
-   * the vertex with specific id after the input iterator.
-   *
-   * @param id The vertex id.
-   * @param from The input iterator.
-   * @return The new constructed iterator.
-   */
-  EdgeIter find_dst(IdType id, const EdgeIter& from) {
-    EdgeIter iter(from);
-    auto end = this->end();
-    while (iter != end) {
-      auto edge = *iter;
-      if (edge.destination() == id) {
-        break;
-      }
-      ++iter;
-    }
-    return iter;
+  /// Get the state shared by the collection and its iterators.
+  const std::shared_ptr<const EdgesCollectionContext>& context() const {
+    return context_;
   }
 
  private:
-  EdgeInfo edge_info_;
-  std::string prefix_;
-  IdType chunk_begin_, chunk_end_;
-  IdType offset_of_chunk_begin_, offset_of_chunk_end_;
-  std::shared_ptr<util::IndexConverter> index_converter_;
-  std::shared_ptr<EdgeIter> begin_, end_;
+  std::shared_ptr<const EdgesCollectionContext> context_;
 };
 
 typedef std::variant<EdgesCollection<AdjListType::ordered_by_source>,
@@ -1820,6 +1460,148 @@ static inline Result<Edges> ConstructEdgesCollection(
   }
   return Status::Invalid("Invalid adj list type");
 }
+
+/**
+ * @brief Construct the collection for a type of edges with only the given
+ * properties.
+ *
+ * The property groups which do not contain any of the given properties are
+ * never opened, and the iterators of the collection only traverse the
+ * topology if the property list is empty.
+ *
+ * @param graph_info The GraphInfo for the graph.
+ * @param src_label The source vertex label.
+ * @param edge_label The edge label.
+ * @param dst_label The destination vertex label.
+ * @param adj_list_type The adjList type.
+ * @param properties The properties to read, could be empty.
+ * @return The constructed collection or error.
+ */
+static inline Result<Edges> ConstructEdgesCollectionWithProperties(
+    const GraphInfo& graph_info, const std::string& src_label,
+    const std::string& edge_label, const std::string& dst_label,
+    AdjListType adj_list_type,
+    const std::vector<std::string>& properties) noexcept {
+  EdgeInfo edge_info;
+  GAR_ASSIGN_OR_RAISE(edge_info,
+                      graph_info.GetEdgeInfo(src_label, edge_label, dst_label));
+  GAR_ASSIGN_OR_RAISE(auto property_groups,
+                      utils::GetPropertyGroupsOfProperties(
+                          edge_info, adj_list_type, properties));
+  switch (adj_list_type) {
+  case AdjListType::ordered_by_source:
+    return EdgesCollection<AdjListType::ordered_by_source>(
+        edge_info, graph_info.GetPrefix(), property_groups);
+  case AdjListType::ordered_by_dest:
+    return EdgesCollection<AdjListType::ordered_by_dest>(
+        edge_info, graph_info.GetPrefix(), property_groups);
+  case AdjListType::unordered_by_source:
+    return EdgesCollection<AdjListType::unordered_by_source>(
+        edge_info, graph_info.GetPrefix(), property_groups);
+  case AdjListType::unordered_by_dest:
+    return EdgesCollection<AdjListType::unordered_by_dest>(
+        edge_info, graph_info.GetPrefix(), property_groups);
+  default:
+    return Status::Invalid("Invalid adj list type");
+  }
+  return Status::Invalid("Invalid adj list type");
+}
+
+/**
+ * @brief Construct the collection for a range of edges with only the given
+ * properties.
+ *
+ * @param graph_info The GraphInfo for the graph.
+ * @param src_label The source vertex label.
+ * @param edge_label The edge label.
+ * @param dst_label The destination vertex label.
+ * @param adj_list_type The adjList type.
+ * @param chunk_begin The global index of the begin chunk.
+ * @param chunk_end The global index of the end chunk.
+ * @param properties The properties to read, could be empty.
+ * @return The constructed collection or error.
+ */
+static inline Result<Edges> ConstructEdgesCollectionWithProperties(
+    const GraphInfo& graph_info, const std::string& src_label,
+    const std::string& edge_label, const std::string& dst_label,
+    AdjListType adj_list_type, const IdType chunk_begin,
+    const IdType chunk_end,
+    const std::vector<std::string>& properties) noexcept {
+  EdgeInfo edge_info;
+  GAR_ASSIGN_OR_RAISE(edge_info,
+                      graph_info.GetEdgeInfo(src_label, edge_label, dst_label));
+  GAR_ASSIGN_OR_RAISE(auto property_groups,
+                      utils::GetPropertyGroupsOfProperties(
+                          edge_info, adj_list_type, properties));
+  switch (adj_list_type) {
+  case AdjListType::ordered_by_source:
+    return EdgesCollection<AdjListType::ordered_by_source>(
+        edge_info, graph_info.GetPrefix(), chunk_begin, chunk_end,
+        property_groups);
+  case AdjListType::ordered_by_dest:
+    return EdgesCollection<AdjListType::ordered_by_dest>(
+        edge_info, graph_info.GetPrefix(), chunk_begin, chunk_end,
+        property_groups);
+  case AdjListType::unordered_by_source:
+    return EdgesCollection<AdjListType::unordered_by_source>(
+        edge_info, graph_info.GetPrefix(), chunk_begin, chunk_end,
+        property_groups);
+  case AdjListType::unordered_by_dest:
+    return EdgesCollection<AdjListType::unordered_by_dest>(
+        edge_info, graph_info.GetPrefix(), chunk_begin, chunk_end,
+        property_groups);
+  default:
+    return Status::Invalid("Invalid adj list type");
+  }
+  return Status::Invalid("Invalid adj list type");
+}
+
+/**
+ * @brief Construct the collection for edges of a vertex chunk with only the
+ * given properties.
+ *
+ * @param graph_info The GraphInfo for this graph.
+ * @param src_label The source vertex label.
+ * @param edge_label The edge label.
+ * @param dst_label The destination vertex label.
+ * @param adj_list_type The adjList type.
+ * @param vertex_chunk_index The index of the vertex chunk.
+ * @param properties The properties to read, could be empty.
+ * @return The constructed collection or error.
+ */
+static inline Result<Edges> ConstructEdgesCollectionWithProperties(
+    const GraphInfo& graph_info, const std::string& src_label,
+    const std::string& edge_label, const std::string& dst_label,
+    AdjListType adj_list_type, IdType vertex_chunk_index,
+    const std::vector<std::string>& properties) noexcept {
+  EdgeInfo edge_info;
+  GAR_ASSIGN_OR_RAISE(edge_info,
+                      graph_info.GetEdgeInfo(src_label, edge_label, dst_label));
+  GAR_ASSIGN_OR_RAISE(auto property_groups,
+                      utils::GetPropertyGroupsOfProperties(
+                          edge_info, adj_list_type, properties));
+  switch (adj_list_type) {
+  case AdjListType::ordered_by_source:
+    return EdgesCollection<AdjListType::ordered_by_source>(
+        edge_info, graph_info.GetPrefix(), vertex_chunk_index,
+        property_groups);
+  case AdjListType::ordered_by_dest:
+    return EdgesCollection<AdjListType::ordered_by_dest>(
+        edge_info, graph_info.GetPrefix(), vertex_chunk_index,
+        property_groups);
+  case AdjListType::unordered_by_source:
+    return EdgesCollection<AdjListType::unordered_by_source>(
+        edge_info, graph_info.GetPrefix(), vertex_chunk_index,
+        property_groups);
+  case AdjListType::unordered_by_dest:
+    return EdgesCollection<AdjListType::unordered_by_dest>(
+        edge_info, graph_info.GetPrefix(), vertex_chunk_index,
+        property_groups);
+  default:
+    return Status::Invalid("Invalid adj list type");
+  }
+  return Status::Invalid("Invalid adj list type");
+}
 }  // namespace GAR_NAMESPACE_INTERNAL
 
 #endif  // GAR_GRAPH_H_
@@ -0,0 +1,539 @@
+/** Copyright 2022 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef GAR_READER_CSR_READER_H_
+#define GAR_READER_CSR_READER_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gar/graph_info.h"
+#include "gar/utils/adj_list_type.h"
+#include "gar/utils/result.h"
+#include "gar/utils/status.h"
+#include "gar/utils/utils.h"
+
+// forward declaration
+namespace arrow {
+class Int64Array;
+}  // namespace arrow
+
+namespace GAR_NAMESPACE_INTERNAL {
+
+/**
+ * @brief The in-memory compressed sparse row (CSR) of a type of edges.
+ *
+ * Loaded from the ordered_by_source adjList it is the CSR of the out-going
+ * edges, and loaded from the ordered_by_dest adjList it is the CSC of the
+ * incoming edges. The neighbors of the vertex v are
+ * neighbors[offsets[v], offsets[v + 1]).
+ */
+class CSR {
+ public:
+  /**
+   * @brief Initialize the CSR.
+   *
+   * @param adj_list_type The type of adjList the CSR is loaded from.
+   * @param offsets The offsets of the vertices, of length vertex num + 1.
+   * @param neighbors The neighbors of all vertices.
+   */
+  CSR(AdjListType adj_list_type, std::shared_ptr<arrow::Int64Array> offsets,
+      std::shared_ptr<arrow::Int64Array> neighbors);
+
+  /// Get the type of adjList the CSR is loaded from.
+  inline AdjListType GetAdjListType() const noexcept { return adj_list_type_; }
+
+  /// Get the number of vertices.
+  inline IdType GetVertexNum() const noexcept { return vertex_num_; }
+
+  /// Get the number of edges.
+  inline IdType GetEdgeNum() const noexcept { return edge_num_; }
+
+  /// Get the number of neighbors of a vertex.
+  inline IdType GetDegree(IdType vid) const noexcept {
+    return offsets_data_[vid + 1] - offsets_data_[vid];
+  }
+
+  /// Get the offsets of the vertices, of length vertex num + 1.
+  inline const int64_t* GetOffsets() const noexcept { return offsets_data_; }
+
+  /// Get the neighbors of all vertices.
+  inline const int64_t* GetNeighbors() const noexcept {
+    return neighbors_data_;
+  }
+
+  /// Get the range of the neighbors of a vertex.
+  inline std::pair<const int64_t*, const int64_t*> GetNeighbors(
+      IdType vid) const noexcept {
+    return std::make_pair(neighbors_data_ + offsets_data_[vid],
+                          neighbors_data_ + offsets_data_[vid + 1]);
+  }
+
+  /**
+   * @brief Apply a function to each neighbor of a vertex.
+   *
+   * @param vid The id of the vertex.
+   * @param func The function to apply, called with the id of each neighbor.
+   */
+  template <typename Func>
+  inline void ForEachNeighbor(IdType vid, Func&& func) const {
+    for (int64_t i = offsets_data_[vid]; i < offsets_data_[vid + 1]; ++i) {
+      func(static_cast<IdType>(neighbors_data_[i]));
+    }
+  }
+
+  /**
+   * @brief Find the first neighbor of a vertex that satisfies a predicate.
+   *
+   * @param vid The id of the vertex.
+   * @param pred The predicate, called with the id of each neighbor until it
+   *     returns true.
+   * @return The neighbor found, or -1 if there is none.
+   */
+  template <typename Pred>
+  inline IdType FindNeighbor(IdType vid, Pred&& pred) const {
+    for (int64_t i = offsets_data_[vid]; i < offsets_data_[vid + 1]; ++i) {
+      if (pred(static_cast<IdType>(neighbors_data_[i]))) {
+        return neighbors_data_[i];
+      }
+    }
+    return -1;
+  }
+
+  /**
+   * @brief Copy the neighbors of a vertex, in the order of the adjList.
+   *
+   * @param vid The id of the vertex.
+   * @param neighbors The vector to store the neighbors, cleared first.
+   */
+  inline void GetNeighbors(IdType vid, std::vector<IdType>* neighbors) const {
+    auto range = GetNeighbors(vid);
+    neighbors->assign(range.first, range.second);
+  }
+
+  /// Get the array that holds the offsets.
+  inline const std::shared_ptr<arrow::Int64Array>& GetOffsetsArray()
+      const noexcept {
+    return offsets_;
+  }
+
+  /// Get the array that holds the neighbors.
+  inline const std::shared_ptr<arrow::Int64Array>& GetNeighborsArray()
+      const noexcept {
+    return neighbors_;
+  }
+
+ private:
+  AdjListType adj_list_type_;
+  std::shared_ptr<arrow::Int64Array> offsets_;
+  std::shared_ptr<arrow::Int64Array> neighbors_;
+  const int64_t* offsets_data_;
+  const int64_t* neighbors_data_;
+  IdType vertex_num_;
+  IdType edge_num_;
+};
+
+/**
+ * @brief The in-memory compressed adjacency of a type of edges.
+ *
+ * It provides the same traversal API as CSR (GetVertexNum, GetEdgeNum,
+ * GetDegree, ForEachNeighbor, FindNeighbor and GetNeighbors to a vector)
+ * for the graphs whose CSR does not fit in memory, so BFS and PageRank run
+ * on either. The neighbors of each vertex are sorted and split into
+ * blocks of kBlockSize neighbors. A block stores its first neighbor as a
+ * varint and the gaps between the following neighbors bit-packed with the
+ * width of the largest gap, so a block is decoded by a branch-free unpack
+ * loop followed by a prefix sum. The vertices with more than one block start
+ * with a skip table of the first neighbor and the position of each block,
+ * which lets HasNeighbor decode a single block.
+ *
+ * The record of a vertex is laid out as:
+ *   varint degree
+ *   [varint skip table size, (varint first neighbor, varint block position)*]
+ *   (varint first neighbor, [byte gap width, packed gaps])*
+ */
+class CompressedCSR {
+ public:
+  /// The number of neighbors in a block.
+  static constexpr IdType kBlockSize = 128;
+  /// The largest gap width that is bit-packed, wider gaps are stored as
+  /// plain 64-bit values.
+  static constexpr int kMaxPackedWidth = 56;
+
+  /**
+   * @brief Initialize the CompressedCSR.
+   *
+   * @param adj_list_type The type of adjList it is loaded from.
+   * @param edge_num The number of edges.
+   * @param offsets The position of the record of each vertex in the data,
+   *     of length vertex num + 1.
+   * @param data The encoded records, followed by 8 bytes of padding.
+   */
+  CompressedCSR(AdjListType adj_list_type, IdType edge_num,
+                std::vector<uint64_t>&& offsets, std::vector<uint8_t>&& data)
+      : adj_list_type_(adj_list_type),
+        edge_num_(edge_num),
+        offsets_(std::move(offsets)),
+        data_(std::move(data)) {}
+
+  /// Get the type of adjList it is loaded from.
+  inline AdjListType GetAdjListType() const noexcept { return adj_list_type_; }
+
+  /// Get the number of vertices.
+  inline IdType GetVertexNum() const noexcept {
+    return static_cast<IdType>(offsets_.size()) - 1;
+  }
+
+  /// Get the number of edges.
+  inline IdType GetEdgeNum() const noexcept { return edge_num_; }
+
+  /// Get the number of neighbors of a vertex.
+  inline IdType GetDegree(IdType vid) const noexcept {
+    const uint8_t* p = data_.data() + offsets_[vid];
+    return static_cast<IdType>(decodeVarint(&p));
+  }
+
+  /// Get the number of bytes used by the offsets and the encoded records.
+  inline size_t GetMemoryUsage() const noexcept {
+    return offsets_.size() * sizeof(uint64_t) + data_.size();
+  }
+
+  /**
+   * @brief Apply a function to each neighbor of a vertex, in ascending order.
+   *
+   * @param vid The id of the vertex.
+   * @param func The function to apply, called with the id of each neighbor.
+   */
+  template <typename Func>
+  inline void ForEachNeighbor(IdType vid, Func&& func) const {
+    const uint8_t* p = data_.data() + offsets_[vid];
+    IdType degree = static_cast<IdType>(decodeVarint(&p));
+    if (degree > kBlockSize) {
+      uint64_t skip_table_size = decodeVarint(&p);
+      p += skip_table_size;
+    }
+    IdType buffer[kBlockSize];
+    for (IdType begin = 0; begin < degree; begin += kBlockSize) {
+      IdType num = std::min(kBlockSize, degree - begin);
+      p = decodeBlock(p, num, buffer);
+      for (IdType i = 0; i < num; ++i) {
+        func(buffer[i]);
+      }
+    }
+  }
+
+  /**
+   * @brief Find the first neighbor of a vertex that satisfies a predicate,
+   * the blocks after the one containing it are not decoded.
+   *
+   * @param vid The id of the vertex.
+   * @param pred The predicate, called with the id of each neighbor in
+   *     ascending order until it returns true.
+   * @return The neighbor found, or -1 if there is none.
+   */
+  template <typename Pred>
+  inline IdType FindNeighbor(IdType vid, Pred&& pred) const {
+    const uint8_t* p = data_.data() + offsets_[vid];
+    IdType degree = static_cast<IdType>(decodeVarint(&p));
+    if (degree > kBlockSize) {
+      uint64_t skip_table_size = decodeVarint(&p);
+      p += skip_table_size;
+    }
+    IdType buffer[kBlockSize];
+    for (IdType begin = 0; begin < degree; begin += kBlockSize) {
+      IdType num = std::min(kBlockSize, degree - begin);
+      p = decodeBlock(p, num, buffer);
+      for (IdType i = 0; i < num; ++i) {
+        if (pred(buffer[i])) {
+          return buffer[i];
+        }
+      }
+    }
+    return -1;
+  }
+
+  /**
+   * @brief Decode the neighbors of a vertex, in ascending order.
+   *
+   * @param vid The id of the vertex.
+   * @param neighbors The vector to store the neighbors, cleared first.
+   */
+  inline void GetNeighbors(IdType vid, std::vector<IdType>* neighbors) const {
+    neighbors->clear();
+    neighbors->reserve(GetDegree(vid));
+    ForEachNeighbor(vid, [neighbors](IdType neighbor) {
+      neighbors->push_back(neighbor);
+    });
+  }
+
+  /**
+   * @brief Check if a vertex is a neighbor of another, only the block that
+   * may contain it is decoded.
+   *
+   * @param vid The id of the vertex.
+   * @param neighbor The id of the vertex to look for.
+   * @return True if neighbor is a neighbor of vid.
+   */
+  bool HasNeighbor(IdType vid, IdType neighbor) const {
+    const uint8_t* p = data_.data() + offsets_[vid];
+    IdType degree = static_cast<IdType>(decodeVarint(&p));
+    if (degree == 0) {
+      return false;
+    }
+    IdType block_index = 0;
+    const uint8_t* block = p;
+    if (degree > kBlockSize) {
+      uint64_t skip_table_size = decodeVarint(&p);
+      const uint8_t* blocks = p + skip_table_size;
+      uint64_t position = 0;
+      IdType block_num = (degree + kBlockSize - 1) / kBlockSize;
+      for (IdType i = 0; i < block_num; ++i) {
+        IdType first = static_cast<IdType>(decodeVarint(&p));
+        uint64_t block_position = decodeVarint(&p);
+        if (first > neighbor) {
+          break;
+        }
+        block_index = i;
+        position = block_position;
+      }
+      block = blocks + position;
+    }
+    IdType buffer[kBlockSize];
+    IdType num = std::min(kBlockSize, degree - block_index * kBlockSize);
+    decodeBlock(block, num, buffer);
+    return std::binary_search(buffer, buffer + num, neighbor);
+  }
+
+ private:
+  static inline uint64_t decodeVarint(const uint8_t** p) noexcept {
+    uint64_t value = 0;
+    int shift = 0;
+    uint8_t byte;
+    do {
+      byte = *(*p)++;
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      shift += 7;
+    } while (byte & 0x80);
+    return value;
+  }
+
+  /// Decode a block of num neighbors to out, return the end of the block.
+  static inline const uint8_t* decodeBlock(const uint8_t* p, IdType num,
+                                           IdType* out) noexcept {
+    out[0] = static_cast<IdType>(decodeVarint(&p));
+    if (num == 1) {
+      return p;
+    }
+    int width = *p++;
+    IdType gap_num = num - 1;
+    if (width > kMaxPackedWidth) {
+      std::memcpy(out + 1, p, gap_num * sizeof(IdType));
+      p += gap_num * sizeof(IdType);
+    } else {
+      // every gap is in the 8 bytes from its first byte, the data is padded
+      // so that the load never runs past the buffer
+      uint64_t mask = (uint64_t(1) << width) - 1;
+      for (IdType i = 0; i < gap_num; ++i) {
+        uint64_t bit = static_cast<uint64_t>(i) * width;
+        uint64_t word;
+        std::memcpy(&word, p + (bit >> 3), sizeof(word));
+        out[i + 1] = static_cast<IdType>((word >> (bit & 7)) & mask);
+      }
+      p += (gap_num * width + 7) / 8;
+    }
+    for (IdType i = 1; i < num; ++i) {
+      out[i] += out[i - 1];
+    }
+    return p;
+  }
+
+  AdjListType adj_list_type_;
+  IdType edge_num_;
+  std::vector<uint64_t> offsets_;
+  std::vector<uint8_t> data_;
+};
+
+/**
+ * @brief Load the CSR of a type of edges from its ordered adjList.
+ *
+ * The offset chunks and the adjList chunks are read and decoded in parallel,
+ * each chunk is copied to its place in the CSR once. If the edges are stored
+ * in a single chunk, its buffers are adopted without copy. The number of
+ * vertices is read from the vertex info rather than the offset chunks, whose
+ * last chunk may be padded to the vertex chunk size.
+ *
+ * @param edge_info The edge info that describes the edge type.
+ * @param vertex_info The vertex info of the source vertices for the CSR, or
+ *     the destination vertices for the CSC.
+ * @param prefix The absolute prefix.
+ * @param adj_list_type The type of adjList, ordered_by_source for the CSR or
+ *     ordered_by_dest for the CSC.
+ * @param thread_num The number of threads to load the chunks, the number of
+ *     hardware threads is used if it is not positive.
+ * @return The CSR or error.
+ */
+Result<CSR> LoadCSR(const EdgeInfo& edge_info, const VertexInfo& vertex_info,
+                    const std::string& prefix, AdjListType adj_list_type,
+                    int thread_num = 0) noexcept;
+
+/**
+ * @brief Helper function to load the CSR of a type of edges.
+ *
+ * @param graph_info The graph info to describe the graph.
+ * @param src_label label of source vertex.
+ * @param edge_label label of edge.
+ * @param dst_label label of destination vertex.
+ * @param adj_list_type The type of adjList, ordered_by_source for the CSR or
+ *     ordered_by_dest for the CSC.
+ * @param thread_num The number of threads to load the chunks, the number of
+ *     hardware threads is used if it is not positive.
+ * @return The CSR or error.
+ */
+static inline Result<CSR> LoadCSR(
+    const GraphInfo& graph_info, const std::string& src_label,
+    const std::string& edge_label, const std::string& dst_label,
+    AdjListType adj_list_type = AdjListType::ordered_by_source,
+    int thread_num = 0) noexcept {
+  EdgeInfo edge_info;
+  GAR_ASSIGN_OR_RAISE(edge_info,
+                      graph_info.GetEdgeInfo(src_label, edge_label, dst_label));
+  VertexInfo vertex_info;
+  GAR_ASSIGN_OR_RAISE(
+      vertex_info,
+      graph_info.GetVertexInfo(adj_list_type == AdjListType::ordered_by_dest
+                                   ? dst_label
+                                   : src_label));
+  return LoadCSR(edge_info, vertex_info, graph_info.GetPrefix(), adj_list_type,
+                 thread_num);
+}
+
+/**
+ * @brief Load the compressed adjacency of a type of edges from its ordered
+ * adjList.
+ *
+ * The vertex chunks are read by AdjListOffsetArrowChunkReader and
+ * AdjListArrowChunkReader and encoded in parallel, only the decoded edges of
+ * the vertex chunks being encoded are held in memory at the same time. As
+ * LoadCSR, the number of vertices is read from the vertex info.
+ *
+ * @param edge_info The edge info that describes the edge type.
+ * @param vertex_info The vertex info of the source vertices for the
+ *     out-going neighbors, or the destination vertices for the incoming
+ *     neighbors.
+ * @param prefix The absolute prefix.
+ * @param adj_list_type The type of adjList, ordered_by_source for the
+ *     out-going neighbors or ordered_by_dest for the incoming neighbors.
+ * @param thread_num The number of threads to encode the vertex chunks, the
+ *     number of hardware threads is used if it is not positive.
+ * @return The compressed adjacency or error.
+ */
+Result<CompressedCSR> LoadCompressedCSR(const EdgeInfo& edge_info,
+                                        const VertexInfo& vertex_info,
+                                        const std::string& prefix,
+                                        AdjListType adj_list_type,
+                                        int thread_num = 0) noexcept;
+
+/**
+ * @brief Helper function to load the compressed adjacency of a type of edges.
+ *
+ * @param graph_info The graph info to describe the graph.
+ * @param src_label label of source vertex.
+ * @param edge_label label of edge.
+ * @param dst_label label of destination vertex.
+ * @param adj_list_type The type of adjList, ordered_by_source for the
+ *     out-going neighbors or ordered_by_dest for the incoming neighbors.
+ * @param thread_num The number of threads to encode the vertex chunks, the
+ *     number of hardware threads is used if it is not positive.
+ * @return The compressed adjacency or error.
+ */
+static inline Result<CompressedCSR> LoadCompressedCSR(
+    const GraphInfo& graph_info, const std::string& src_label,
+    const std::string& edge_label, const std::string& dst_label,
+    AdjListType adj_list_type = AdjListType::ordered_by_source,
+    int thread_num = 0) noexcept {
+  EdgeInfo edge_info;
+  GAR_ASSIGN_OR_RAISE(edge_info,
+                      graph_info.GetEdgeInfo(src_label, edge_label, dst_label));
+  VertexInfo vertex_info;
+  GAR_ASSIGN_OR_RAISE(
+      vertex_info,
+      graph_info.GetVertexInfo(adj_list_type == AdjListType::ordered_by_dest
+                                   ? dst_label
+                                   : src_label));
+  return LoadCompressedCSR(edge_info, vertex_info, graph_info.GetPrefix(),
+                           adj_list_type, thread_num);
+}
+
+/**
+ * @brief Compute the degrees of the vertices of a type of edges.
+ *
+ * The degrees of the ordered adjList are the differences of the offset
+ * chunks, so only the offset chunks are read. The unordered adjList has no
+ * offsets, so the vertices of its edge chunks are counted instead. The vertex
+ * chunks are processed in parallel. Either way there is a degree for each
+ * vertex of the vertex count, so every adjList type gives the same degrees.
+ *
+ * @param edge_info The edge info that describes the edge type.
+ * @param vertex_info The vertex info of the source vertices for the
+ *     out-degrees, or the destination vertices for the in-degrees.
+ * @param prefix The absolute prefix.
+ * @param adj_list_type The type of adjList, the out-degrees are computed for
+ *     ordered_by_source and unordered_by_source, and the in-degrees for
+ *     ordered_by_dest and unordered_by_dest.
+ * @param thread_num The number of threads, the number of hardware threads is
+ *     used if it is not positive.
+ * @return The degree of each vertex or error.
+ */
+Result<std::shared_ptr<arrow::Int64Array>> ComputeDegrees(
+    const EdgeInfo& edge_info, const VertexInfo& vertex_info,
+    const std::string& prefix, AdjListType adj_list_type,
+    int thread_num = 0) noexcept;
+
+/**
+ * @brief Helper function to compute the degrees of the vertices of a type of
+ * edges.
+ *
+ * @param graph_info The graph info to describe the graph.
+ * @param src_label label of source vertex.
+ * @param edge_label label of edge.
+ * @param dst_label label of destination vertex.
+ * @param adj_list_type The type of adjList.
+ * @param thread_num The number of threads.
+ * @return The degree of each vertex or error.
+ */
+static inline Result<std::shared_ptr<arrow::Int64Array>> ComputeDegrees(
+    const GraphInfo& graph_info, const std::string& src_label,
+    const std::string& edge_label, const std::string& dst_label,
+    AdjListType adj_list_type = AdjListType::ordered_by_source,
+    int thread_num = 0) noexcept {
+  EdgeInfo edge_info;
+  GAR_ASSIGN_OR_RAISE(edge_info,
+                      graph_info.GetEdgeInfo(src_label, edge_label, dst_label));
+  bool by_source = adj_list_type == AdjListType::ordered_by_source ||
+                   adj_list_type == AdjListType::unordered_by_source;
+  VertexInfo vertex_info;
+  GAR_ASSIGN_OR_RAISE(vertex_info, graph_info.GetVertexInfo(
+                                       by_source ? src_label : dst_label));
+  return ComputeDegrees(edge_info, vertex_info, graph_info.GetPrefix(),
+                        adj_list_type, thread_num);
+}
+
+}  // namespace GAR_NAMESPACE_INTERNAL
+#endif  // GAR_READER_CSR_READER_H_
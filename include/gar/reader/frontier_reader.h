@@ -0,0 +1,89 @@
+/** Copyright 2022 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef GAR_READER_FRONTIER_READER_H_
+#define GAR_READER_FRONTIER_READER_H_
+
+#include <functional>
+#include <string>
+
+#include "gar/graph_info.h"
+#include "gar/utils/adj_list_type.h"
+#include "gar/utils/bitmap.h"
+#include "gar/utils/result.h"
+#include "gar/utils/status.h"
+#include "gar/utils/utils.h"
+
+namespace GAR_NAMESPACE_INTERNAL {
+
+/**
+ * @brief Apply a function to the edges of the active vertices.
+ *
+ * Only the adjList chunks that may contain edges of the active vertices are
+ * read. For the ordered adjList types, the offset chunks tell the exact
+ * chunks and rows of the edges of each active vertex. For the unordered
+ * types, the vertex chunks without any active vertex are skipped and the
+ * edges of the other chunks are filtered by the bitmap. The chunks are read
+ * in parallel.
+ *
+ * @param edge_info The edge info that describes the edge type.
+ * @param prefix The absolute prefix.
+ * @param adj_list_type The type of adjList. The active vertices are the
+ *     sources for ordered_by_source and unordered_by_source, or the
+ *     destinations for ordered_by_dest and unordered_by_dest.
+ * @param active The bitmap of the active vertices.
+ * @param func The function to apply, called with the active vertex and its
+ *     neighbor of each edge. It is called by multiple threads at the same
+ *     time.
+ * @param thread_num The number of threads to read the chunks, the number of
+ *     hardware threads is used if it is not positive.
+ * @return The number of adjList chunks read, or error.
+ */
+Result<IdType> ForEachActiveEdge(
+    const EdgeInfo& edge_info, const std::string& prefix,
+    AdjListType adj_list_type, const util::Bitmap& active,
+    const std::function<void(IdType, IdType)>& func,
+    int thread_num = 0) noexcept;
+
+/**
+ * @brief Helper function to apply a function to the edges of the active
+ * vertices.
+ *
+ * @param graph_info The graph info to describe the graph.
+ * @param src_label label of source vertex.
+ * @param edge_label label of edge.
+ * @param dst_label label of destination vertex.
+ * @param adj_list_type The type of adjList.
+ * @param active The bitmap of the active vertices.
+ * @param func The function to apply, called with the active vertex and its
+ *     neighbor of each edge.
+ * @param thread_num The number of threads to read the chunks.
+ * @return The number of adjList chunks read, or error.
+ */
+static inline Result<IdType> ForEachActiveEdge(
+    const GraphInfo& graph_info, const std::string& src_label,
+    const std::string& edge_label, const std::string& dst_label,
+    AdjListType adj_list_type, const util::Bitmap& active,
+    const std::function<void(IdType, IdType)>& func,
+    int thread_num = 0) noexcept {
+  EdgeInfo edge_info;
+  GAR_ASSIGN_OR_RAISE(edge_info,
+                      graph_info.GetEdgeInfo(src_label, edge_label, dst_label));
+  return ForEachActiveEdge(edge_info, graph_info.GetPrefix(), adj_list_type,
+                           active, func, thread_num);
+}
+
+}  // namespace GAR_NAMESPACE_INTERNAL
+#endif  // GAR_READER_FRONTIER_READER_H_
@@ -0,0 +1,143 @@
+/** Copyright 2022 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef GAR_UTILS_BITMAP_H_
+#define GAR_UTILS_BITMAP_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "gar/utils/utils.h"
+
+namespace GAR_NAMESPACE_INTERNAL {
+
+namespace util {
+
+/**
+ * @brief A fixed-size bitmap of vertices, e.g., the active vertices of a
+ * traversal.
+ *
+ * The bits can be set by multiple threads at the same time with AtomicSet,
+ * the other modifications are not thread-safe.
+ */
+class Bitmap {
+ public:
+  /// Initialize the bitmap with all bits unset.
+  explicit Bitmap(IdType size)
+      : size_(size),
+        word_num_((size + 63) / 64),
+        words_(new std::atomic<uint64_t>[word_num_]) {
+    Clear();
+  }
+
+  Bitmap(const Bitmap& other)
+      : size_(other.size_),
+        word_num_(other.word_num_),
+        words_(new std::atomic<uint64_t>[word_num_]) {
+    for (IdType i = 0; i < word_num_; ++i) {
+      words_[i].store(other.words_[i].load(std::memory_order_relaxed),
+                      std::memory_order_relaxed);
+    }
+  }
+
+  Bitmap(Bitmap&& other) = default;
+
+  Bitmap& operator=(Bitmap&& other) = default;
+
+  /// Get the number of bits.
+  inline IdType size() const noexcept { return size_; }
+
+  /// Get the number of 64-bit words holding the bits.
+  inline IdType word_num() const noexcept { return word_num_; }
+
+  /// Get a 64-bit word, whose bit i is the bit 64 * word_index + i.
+  inline uint64_t GetWord(IdType word_index) const noexcept {
+    return words_[word_index].load(std::memory_order_relaxed);
+  }
+
+  /// Check if a bit is set.
+  inline bool Get(IdType index) const noexcept {
+    return (words_[index >> 6].load(std::memory_order_relaxed) >>
+            (index & 63)) &
+           1;
+  }
+
+  /// Set a bit.
+  inline void Set(IdType index) noexcept {
+    auto& word = words_[index >> 6];
+    word.store(word.load(std::memory_order_relaxed) |
+                   (uint64_t(1) << (index & 63)),
+               std::memory_order_relaxed);
+  }
+
+  /// Set a bit atomically, return true if the bit is set by this call.
+  inline bool AtomicSet(IdType index) noexcept {
+    uint64_t mask = uint64_t(1) << (index & 63);
+    return (words_[index >> 6].fetch_or(mask, std::memory_order_relaxed) &
+            mask) == 0;
+  }
+
+  /// Unset all bits.
+  inline void Clear() noexcept {
+    for (IdType i = 0; i < word_num_; ++i) {
+      words_[i].store(0, std::memory_order_relaxed);
+    }
+  }
+
+  /// Get the number of set bits.
+  inline IdType Count() const noexcept {
+    IdType count = 0;
+    for (IdType i = 0; i < word_num_; ++i) {
+      count += __builtin_popcountll(words_[i].load(std::memory_order_relaxed));
+    }
+    return count;
+  }
+
+  /// Check if any bit in [begin, end) is set.
+  inline bool Any(IdType begin, IdType end) const noexcept {
+    for (IdType i = begin; i < end;) {
+      if ((i & 63) == 0 && i + 64 <= end) {
+        if (words_[i >> 6].load(std::memory_order_relaxed) != 0) {
+          return true;
+        }
+        i += 64;
+      } else {
+        if (Get(i)) {
+          return true;
+        }
+        ++i;
+      }
+    }
+    return false;
+  }
+
+  /// Swap the bits with another bitmap.
+  inline void Swap(Bitmap& other) noexcept {
+    std::swap(size_, other.size_);
+    std::swap(word_num_, other.word_num_);
+    std::swap(words_, other.words_);
+  }
+
+ private:
+  IdType size_;
+  IdType word_num_;
+  std::unique_ptr<std::atomic<uint64_t>[]> words_;
+};
+
+}  // namespace util
+}  // namespace GAR_NAMESPACE_INTERNAL
+#endif  // GAR_UTILS_BITMAP_H_
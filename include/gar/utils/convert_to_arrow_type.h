@@ -23,6 +23,7 @@ limitations under the License.
 #include "arrow/type.h"
 
 #include "gar/utils/data_type.h"
+#include "gar/utils/status.h"
 
 namespace GAR_NAMESPACE_INTERNAL {
 
@@ -57,6 +58,29 @@ CONVERT_TO_ARROW_TYPE(Type::STRING, std::string, arrow::StringType,
                       arrow::StringArray, arrow::StringBuilder, arrow::utf8(),
                       "string")
 
+/// \brief Apply a generic function to the ConvertToArrowType of a DataType,
+/// e.g., to create a typed builder for a property once.
+template <typename Func>
+Status VisitType(const DataType& type, Func&& func) {
+  switch (type.id()) {
+  case Type::BOOL:
+    return func(ConvertToArrowType<Type::BOOL>());
+  case Type::INT32:
+    return func(ConvertToArrowType<Type::INT32>());
+  case Type::INT64:
+    return func(ConvertToArrowType<Type::INT64>());
+  case Type::FLOAT:
+    return func(ConvertToArrowType<Type::FLOAT>());
+  case Type::DOUBLE:
+    return func(ConvertToArrowType<Type::DOUBLE>());
+  case Type::STRING:
+    return func(ConvertToArrowType<Type::STRING>());
+  default:
+    return Status::TypeError("Unsupported data type " + type.ToTypeName() +
+                             ".");
+  }
+}
+
 }  // namespace GAR_NAMESPACE_INTERNAL
 
 #endif  // GAR_UTILS_CONVERT_TO_ARROW_TYPE_H_
@@ -18,6 +18,7 @@ limitations under the License.
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "gar/utils/file_type.h"
 #include "gar/utils/result.h"
@@ -32,6 +33,7 @@ namespace fs {
 class FileSystem;
 }
 namespace io {
+class OutputStream;
 class RandomAccessFile;
 }
 }  // namespace arrow
@@ -52,6 +54,12 @@ class FileSystem {
   Result<std::shared_ptr<arrow::Table>> ReadFileToTable(
       const std::string& path, FileType file_type) const noexcept;
 
+  /// Read the specific columns of a file as an arrow::Table, the other
+  /// columns of the file are not decoded.
+  Result<std::shared_ptr<arrow::Table>> ReadFileToTable(
+      const std::string& path, FileType file_type,
+      const std::vector<std::string>& columns) const noexcept;
+
   /// Read a file to value
   ///   if the file bytes can not be converted to value, return
   ///   Status::ArrowError
@@ -72,6 +80,11 @@ class FileSystem {
                           FileType file_type, const std::string& path) const
       noexcept;
 
+  /// Open an output stream to write a file, e.g., a file written
+  /// incrementally, the directory of the file is created if not exists.
+  Result<std::shared_ptr<arrow::io::OutputStream>> OpenOutputStream(
+      const std::string& path) const noexcept;
+
   /// Copy a file.
   ///
   /// If the destination exists and is a directory, an Status::ArrowError is
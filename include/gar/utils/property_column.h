@@ -0,0 +1,189 @@
+/** Copyright 2022 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef GAR_UTILS_PROPERTY_COLUMN_H_
+#define GAR_UTILS_PROPERTY_COLUMN_H_
+
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include "arrow/api.h"
+
+#include "gar/utils/result.h"
+#include "gar/utils/status.h"
+#include "gar/utils/utils.h"
+
+namespace GAR_NAMESPACE_INTERNAL {
+
+/**
+ * @brief PropertyColumn is a typed accessor for a property column of a chunk.
+ *
+ * The accessor is bound to a property name once. Each time it is bound to a
+ * chunk, the column is resolved and its type is checked against T; after
+ * that, values are accessed by index without any lookup or type dispatch.
+ * For the fixed-width types, reading a value is a single load from the
+ * column buffer.
+ *
+ * @tparam T The C++ type of the property, one of bool, int32_t, int64_t,
+ * float, double and std::string.
+ */
+template <typename T>
+class PropertyColumn {
+ public:
+  using ArrowType = typename arrow::CTypeTraits<T>::ArrowType;
+  using ArrayType = typename arrow::TypeTraits<ArrowType>::ArrayType;
+
+  /**
+   * @brief Initialize the PropertyColumn.
+   *
+   * @param name The name of the property.
+   */
+  explicit PropertyColumn(const std::string& name)
+      : name_(name), chunk_index_(-1), array_(nullptr), values_(nullptr) {}
+
+  /// Get the name of the property.
+  inline const std::string& name() const noexcept { return name_; }
+
+  /// Get the index of the chunk that the accessor is bound to, -1 if none.
+  inline IdType chunk_index() const noexcept { return chunk_index_; }
+
+  /// Check if the accessor is bound to the chunk with specific index.
+  inline bool IsBound(IdType chunk_index) const noexcept {
+    return array_ != nullptr && chunk_index_ == chunk_index;
+  }
+
+  /**
+   * @brief Bind the accessor to a chunk table.
+   *
+   * @param table The chunk table which contains the property.
+   * @param chunk_index The index of the chunk, used to tell if the accessor
+   *     needs to be bound again.
+   * @return Status: ok or KeyError if the table does not contain the
+   *     property, or TypeError if the type of the column does not match T.
+   */
+  Status Bind(const std::shared_ptr<arrow::Table>& table,
+              IdType chunk_index) noexcept {
+    auto column = table->GetColumnByName(name_);
+    if (column == nullptr) {
+      return Status::KeyError("The property " + name_ + " is not exist.");
+    }
+    return Bind(column, chunk_index);
+  }
+
+  /**
+   * @brief Bind the accessor to a column of a chunk.
+   *
+   * @param column The column of the property.
+   * @param chunk_index The index of the chunk.
+   * @return Status: ok or TypeError if the type of the column does not
+   *     match T.
+   */
+  Status Bind(const std::shared_ptr<arrow::ChunkedArray>& column,
+              IdType chunk_index) noexcept {
+    if (column->num_chunks() == 1) {
+      return Bind(column->chunk(0), chunk_index);
+    }
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        auto array,
+        arrow::Concatenate(column->chunks(), arrow::default_memory_pool()));
+    return Bind(array, chunk_index);
+  }
+
+  /**
+   * @brief Bind the accessor to the array of a chunk.
+   *
+   * @param array The array of the property.
+   * @param chunk_index The index of the chunk.
+   * @return Status: ok or TypeError if the type of the array does not
+   *     match T.
+   */
+  Status Bind(const std::shared_ptr<arrow::Array>& array,
+              IdType chunk_index) noexcept {
+    if (!TypeMatch(*array)) {
+      return Status::TypeError("The property type " +
+                               array->type()->ToString() +
+                               " is not match for " + name_ + ".");
+    }
+    array_ = std::static_pointer_cast<ArrayType>(array);
+    if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) {
+      values_ = array_->raw_values();
+    }
+    chunk_index_ = chunk_index;
+    return Status::OK();
+  }
+
+  /// Check if the type of an array matches T.
+  static inline bool TypeMatch(const arrow::Array& array) noexcept {
+    return array.type_id() == ArrowType::type_id;
+  }
+
+  /**
+   * @brief Get the value at specific index of an array whose type has been
+   * checked by TypeMatch.
+   *
+   * @param array The array.
+   * @param index The index of the value.
+   * @return The value.
+   */
+  static inline T Value(const arrow::Array& array, int64_t index) noexcept {
+    const auto& typed_array = static_cast<const ArrayType&>(array);
+    if constexpr (std::is_same_v<T, std::string>) {
+      return std::string(typed_array.GetView(index));
+    } else {
+      return typed_array.Value(index);
+    }
+  }
+
+  /// Reset the accessor to the unbound state.
+  inline void Reset() noexcept {
+    array_.reset();
+    values_ = nullptr;
+    chunk_index_ = -1;
+  }
+
+  /// Get the number of values in the bound chunk.
+  inline int64_t length() const noexcept { return array_->length(); }
+
+  /// Check if the value at specific index is null.
+  inline bool IsNull(int64_t index) const noexcept {
+    return array_->IsNull(index);
+  }
+
+  /// Get the value at specific index of the bound chunk.
+  inline T operator[](int64_t index) const noexcept {
+    if constexpr (std::is_same_v<T, bool>) {
+      return array_->Value(index);
+    } else if constexpr (std::is_same_v<T, std::string>) {
+      return std::string(array_->GetView(index));
+    } else {
+      return values_[index];
+    }
+  }
+
+  /// Get the underlying array of the bound chunk.
+  inline const std::shared_ptr<ArrayType>& array() const noexcept {
+    return array_;
+  }
+
+ private:
+  std::string name_;
+  IdType chunk_index_;
+  std::shared_ptr<ArrayType> array_;
+  const T* values_;
+};
+
+}  // namespace GAR_NAMESPACE_INTERNAL
+#endif  // GAR_UTILS_PROPERTY_COLUMN_H_
@@ -18,6 +18,7 @@ limitations under the License.
 
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "gar/graph_info.h"
 
@@ -29,6 +30,13 @@ Result<std::pair<IdType, IdType>> GetAdjListOffsetOfVertex(
     const EdgeInfo& edge_info, const std::string& prefix,
     AdjListType adj_list_type, IdType vid) noexcept;
 
+Result<std::vector<PropertyGroup>> GetPropertyGroupsOfProperties(
+    const EdgeInfo& edge_info, AdjListType adj_list_type,
+    const std::vector<std::string>& properties) noexcept;
+
+Result<IdType> GetVertexNum(const std::string& prefix,
+                            const VertexInfo& vertex_info) noexcept;
+
 }  // namespace utils
 }  // namespace GAR_NAMESPACE_INTERNAL
 #endif  // GAR_UTILS_READER_UTILS_H_
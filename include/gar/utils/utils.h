@@ -16,6 +16,9 @@ limitations under the License.
 #ifndef GAR_UTILS_UTILS_H_
 #define GAR_UTILS_UTILS_H_
 
+#include <algorithm>
+#include <functional>
+#include <iterator>
 #include <memory>
 #include <numeric>
 #include <string>
@@ -28,6 +31,9 @@ limitations under the License.
 
 namespace arrow {
 class Array;
+class ChunkedArray;
+class Int64Array;
+class Table;
 }
 
 namespace GAR_NAMESPACE_INTERNAL {
@@ -39,32 +45,49 @@ namespace util {
 
 struct IndexConverter {
   explicit IndexConverter(std::vector<IdType>&& edge_chunk_nums)
-      : edge_chunk_nums_(std::move(edge_chunk_nums)) {}
+      : edge_chunk_nums_(std::move(edge_chunk_nums)) {
+    // prefix sums of the edge chunk numbers, so the conversions do not need
+    // to scan all vertex chunks
+    chunk_num_prefix_sum_.resize(edge_chunk_nums_.size() + 1, 0);
+    std::partial_sum(edge_chunk_nums_.begin(), edge_chunk_nums_.end(),
+                     chunk_num_prefix_sum_.begin() + 1);
+  }
+
   IdType IndexPairToGlobalChunkIndex(IdType vertex_chunk_index,
-                                     IdType edge_chunk_index) {
-    IdType global_edge_chunk_index = 0;
-    for (IdType i = 0; i < vertex_chunk_index; ++i) {
-      global_edge_chunk_index += edge_chunk_nums_[i];
-    }
-    return global_edge_chunk_index + edge_chunk_index;
+                                     IdType edge_chunk_index) const {
+    return chunk_num_prefix_sum_[vertex_chunk_index] + edge_chunk_index;
   }
 
-  // covert edge global chunk index to <vertex_chunk_index, edge_chunk_index>
-  std::pair<IdType, IdType> GlobalChunkIndexToIndexPair(IdType global_index) {
-    std::pair<IdType, IdType> index_pair(0, 0);
-    for (size_t i = 0; i < edge_chunk_nums_.size(); ++i) {
-      if (global_index < edge_chunk_nums_[i]) {
-        index_pair.first = static_cast<IdType>(i);
-        index_pair.second = global_index;
-        break;
-      }
-      global_index -= edge_chunk_nums_[i];
-    }
-    return index_pair;
+  // covert edge global chunk index to <vertex_chunk_index, edge_chunk_index>,
+  // the indices past the last chunk are converted to
+  // <vertex_chunk_num, global_index - total_chunk_num>
+  std::pair<IdType, IdType> GlobalChunkIndexToIndexPair(
+      IdType global_index) const {
+    auto it = std::upper_bound(chunk_num_prefix_sum_.begin() + 1,
+                               chunk_num_prefix_sum_.end(), global_index);
+    IdType vertex_chunk_index = static_cast<IdType>(
+        std::distance(chunk_num_prefix_sum_.begin() + 1, it));
+    return std::make_pair(
+        vertex_chunk_index,
+        global_index - chunk_num_prefix_sum_[vertex_chunk_index]);
+  }
+
+  // get the number of vertex chunks
+  IdType GetVertexChunkNum() const {
+    return static_cast<IdType>(edge_chunk_nums_.size());
+  }
+
+  // get the number of edge chunks of a vertex chunk
+  IdType GetEdgeChunkNum(IdType vertex_chunk_index) const {
+    return edge_chunk_nums_[vertex_chunk_index];
   }
 
+  // get the total number of edge chunks
+  IdType GetTotalChunkNum() const { return chunk_num_prefix_sum_.back(); }
+
  private:
   std::vector<IdType> edge_chunk_nums_;
+  std::vector<IdType> chunk_num_prefix_sum_;
 };
 
 static inline IdType IndexPairToGlobalChunkIndex(
@@ -92,6 +115,93 @@ static inline std::pair<IdType, IdType> GlobalChunkIndexToIndexPair(
   return index_pair;
 }
 
+/**
+ * @brief Run a task for each index in [begin, end) on a group of threads.
+ *
+ * The indices are handed out one by one, so tasks with different costs are
+ * balanced among the threads. No new task is started once a task fails.
+ * With a single thread or a single index, the tasks run on the calling
+ * thread without creating any thread.
+ *
+ * @param begin The first index.
+ * @param end The past-the-end index.
+ * @param task The task to run for each index.
+ * @param thread_num The number of threads, the number of hardware threads is
+ *     used if it is not positive.
+ * @return Status: ok or the error of the first failed task.
+ */
+Status ParallelFor(IdType begin, IdType end,
+                   const std::function<Status(IdType)>& task,
+                   int thread_num = 0);
+
+/**
+ * @brief Compute the permutation that stably sorts int64 keys, with a
+ * parallel LSD radix sort.
+ *
+ * The keys are split into a block per thread. Each pass counts the digits of
+ * a byte in each block, and then scatters the blocks in parallel to the
+ * offsets of their digits, which keeps the sort stable. Only the bytes that
+ * vary among the keys, i.e., of the range between the smallest and the
+ * largest key, are sorted.
+ *
+ * @param keys The keys to sort.
+ * @param length The number of keys.
+ * @param indices The output permutation of length keys, such that
+ *     keys[indices[0]], keys[indices[1]], ... is sorted.
+ * @param thread_num The number of threads, the number of hardware threads is
+ *     used if it is not positive.
+ * @return Status: ok or error.
+ */
+Status SortIndices(const int64_t* keys, int64_t length, int64_t* indices,
+                   int thread_num = 0);
+
+/**
+ * @brief Take the rows of a table by indices, with multiple threads.
+ *
+ * The indices are split into slices, and each column is taken by each slice
+ * in parallel, so the result columns consist of a chunk per slice.
+ *
+ * @param table The table to take from.
+ * @param indices The indices of the rows to take, which must not be null.
+ * @param thread_num The number of threads, the number of hardware threads is
+ *     used if it is not positive.
+ * @return The taken table, or error.
+ */
+Result<std::shared_ptr<arrow::Table>> TakeTable(
+    const std::shared_ptr<arrow::Table>& table,
+    const std::shared_ptr<arrow::Int64Array>& indices, int thread_num = 0);
+
+/**
+ * @brief Compute the offsets of a range of vertices from the vertex ids of
+ * edges, by counting.
+ *
+ * The ids are counted into a histogram of the range in a single pass, and
+ * the offsets are its exclusive prefix sum, i.e., offsets[k] is the number of
+ * ids in [begin, begin + k). The ids need not be sorted, and the ids out of
+ * the range are ignored. The offsets of several vertex chunks can be
+ * computed at once from the range of all of them.
+ *
+ * @param ids The vertex ids of the edges.
+ * @param length The number of ids.
+ * @param begin The first vertex of the range.
+ * @param num The number of vertices of the range.
+ * @param offsets The output offsets of num + 1 values.
+ */
+void ComputeOffsets(const int64_t* ids, int64_t length, IdType begin,
+                    IdType num, int64_t* offsets);
+
+/**
+ * @brief Compute the offsets of a range of vertices from a column of the
+ * vertex ids of edges, by counting. The null ids are ignored.
+ *
+ * @param ids The int64 column of the vertex ids.
+ * @param begin The first vertex of the range.
+ * @param num The number of vertices of the range.
+ * @return The offsets of num + 1 values, or error.
+ */
+Result<std::shared_ptr<arrow::Int64Array>> ComputeOffsets(
+    const std::shared_ptr<arrow::ChunkedArray>& ids, IdType begin, IdType num);
+
 Result<const void*> GetArrowArrayData(
     std::shared_ptr<arrow::Array> const& array);
 
@@ -509,11 +509,29 @@ class EdgeChunkWriter {
   /**
    * @brief Sort a table according to a specific column.
    *
+   * A non-null int64 column, e.g., the sources or destinations, is sorted
+   * stably by util::SortIndices, and the permutation is applied to all
+   * columns by util::TakeTable; other columns are sorted by an Acero plan.
+   *
    * @param input_table The table to sort.
    * @param column_name The column that is used to sort.
+   * @param thread_num The number of threads of the int64 sort, the number of
+   *     hardware threads is used if it is not positive.
    * @return The sorted table.
    */
   static Result<std::shared_ptr<arrow::Table>> sortTable(
+      const std::shared_ptr<arrow::Table>& input_table,
+      const std::string& column_name, int thread_num = 0);
+
+  /**
+   * @brief Sort a table according to a specific column, by an Acero plan
+   * with an order_by_sink.
+   *
+   * @param input_table The table to sort.
+   * @param column_name The column that is used to sort.
+   * @return The sorted table.
+   */
+  static Result<std::shared_ptr<arrow::Table>> sortTableByExecPlan(
       const std::shared_ptr<arrow::Table>& input_table,
       const std::string& column_name);
 
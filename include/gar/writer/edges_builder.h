@@ -18,11 +18,14 @@ limitations under the License.
 
 #include <algorithm>
 #include <any>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "arrow/api.h"
+
 #include "gar/writer/arrow_chunk_writer.h"
 
 namespace GAR_NAMESPACE_INTERNAL {
@@ -137,6 +140,15 @@ inline bool cmp_dst(const Edge& a, const Edge& b) {
  * @brief EdgeBuilder is designed for building and writing a collection of
  * edges.
  *
+ * The edges are stored by column: the sources, the destinations, and a
+ * typed column for each property of the edge info, resolved once at
+ * construction. The edges added one by one are appended to Arrow builders,
+ * and the tables added in bulk are kept as their arrays without copy.
+ *
+ * With a memory budget, the buffered edges are sorted and spilled to a run
+ * file in Arrow IPC format whenever they exceed the budget, one record batch
+ * per vertex chunk. Dumping merges the runs one vertex chunk at a time, so
+ * only the edges of a vertex chunk are held in memory.
  */
 class EdgesBuilder {
  public:
@@ -156,8 +168,9 @@ class EdgesBuilder {
         prefix_(prefix),
         adj_list_type_(adj_list_type),
         num_vertices_(num_vertices) {
-    edges_.clear();
     num_edges_ = 0;
+    memory_budget_ = -1;
+    buffered_bytes_ = 0;
     is_saved_ = false;
     switch (adj_list_type) {
     case AdjListType::unordered_by_source:
@@ -175,6 +188,26 @@ class EdgesBuilder {
     default:
       vertex_chunk_size_ = edge_info_.GetSrcChunkSize();
     }
+    initColumns();
+  }
+
+  /// Remove the run files that are not merged yet.
+  ~EdgesBuilder();
+
+  /**
+   * @brief Set the memory budget of the buffered edges.
+   *
+   * Once the buffered edges exceed the budget, they are sorted as when
+   * dumping and spilled to a run file in the spill directory, which is
+   * removed after dumping.
+   *
+   * @param memory_budget The budget in bytes, no budget if not positive.
+   * @param spill_dir The local directory of the run files.
+   */
+  void SetMemoryBudget(int64_t memory_budget,
+                       const std::string& spill_dir = "/tmp/") {
+    memory_budget_ = memory_budget;
+    spill_dir_ = spill_dir;
   }
 
   /**
@@ -224,18 +257,36 @@ class EdgesBuilder {
   /**
    * @brief Add an edge to the collection.
    *
+   * The edge is appended to the columns, so it is not kept by the builder.
+   *
    * @param e The edge to add.
-   * @return Status: ok or Status::InvalidOperation error.
+   * @return Status: ok or Status::InvalidOperation error, or
+   *     Status::TypeError if the value of a property is not of its type.
    */
-  Status AddEdge(const Edge& e) {
-    // validate
-    GAR_RETURN_NOT_OK(Validate(e));
-    // add an edge
-    IdType vertex_chunk_index = getVertexChunkIndex(e);
-    edges_[vertex_chunk_index].push_back(e);
-    num_edges_++;
-    return Status::OK();
-  }
+  Status AddEdge(const Edge& e);
+
+  /**
+   * @brief Add the edges of a table to the collection.
+   *
+   * The table contains the int64 columns of the sources and destinations,
+   * named GeneralParams::kSrcIndexCol and GeneralParams::kDstIndexCol, and
+   * the columns of some properties of the edge info, whose types must match
+   * the properties. The properties not in the table are null. The arrays of
+   * the table are kept without copy until dumping.
+   *
+   * @param table The table of the edges.
+   * @return Status: ok or Status::InvalidOperation error, or
+   *     Status::TypeError if a column is not of its type.
+   */
+  Status AddEdges(const std::shared_ptr<arrow::Table>& table);
+
+  /**
+   * @brief Add the edges of a record batch to the collection.
+   *
+   * @param batch The record batch of the edges, see AddEdges(table).
+   * @return Status: ok or error.
+   */
+  Status AddEdges(const std::shared_ptr<arrow::RecordBatch>& batch);
 
   /**
    * @brief Get the current number of edges in the collection.
@@ -247,117 +298,116 @@ class EdgesBuilder {
   /**
    * @brief Dump the collection into files.
    *
+   * The edges are grouped by vertex chunk with a counting sort, and sorted
+   * in each vertex chunk for the ordered adj list, then the columns are
+   * permuted once and each vertex chunk is written as a slice of them. If
+   * runs were spilled, the edges of each vertex chunk in the runs and in
+   * memory are merged before writing it.
+   *
+   * The vertex chunks are sorted, merged and written by multiple threads,
+   * each thread handling a vertex chunk at a time, so no more vertex chunks
+   * than the threads are read from the runs at a time.
+   *
+   * @param thread_num The number of threads, the number of hardware threads is
+   *     used if it is not positive.
    * @return Status: ok or error.
    */
-  Status Dump() {
-    // construct the writer
-    EdgeChunkWriter writer(edge_info_, prefix_, adj_list_type_);
-    // construct empty edge collections for vertex chunks without edges
-    if (num_vertices_ != -1) {
-      IdType num_vertex_chunks =
-          (num_vertices_ + vertex_chunk_size_ - 1) / vertex_chunk_size_;
-      for (IdType i = 0; i < num_vertex_chunks; i++)
-        if (edges_.find(i) == edges_.end()) {
-          std::vector<Edge> empty_chunk_edges;
-          edges_[i] = empty_chunk_edges;
-        }
-    }
-    // dump the offsets
-    if (adj_list_type_ == AdjListType::ordered_by_source ||
-        adj_list_type_ == AdjListType::ordered_by_dest) {
-      for (auto& chunk_edges : edges_) {
-        IdType vertex_chunk_index = chunk_edges.first;
-        // sort the edges
-        if (adj_list_type_ == AdjListType::ordered_by_source)
-          sort(chunk_edges.second.begin(), chunk_edges.second.end(), cmp_src);
-        if (adj_list_type_ == AdjListType::ordered_by_dest)
-          sort(chunk_edges.second.begin(), chunk_edges.second.end(), cmp_dst);
-        // construct and write offset chunk
-        GAR_ASSIGN_OR_RAISE(
-            auto offset_table,
-            getOffsetTable(vertex_chunk_index, chunk_edges.second));
-        GAR_RETURN_NOT_OK(
-            writer.WriteOffsetChunk(offset_table, vertex_chunk_index));
-      }
-    }
-    // dump the edges
-    for (auto& chunk_edges : edges_) {
-      IdType vertex_chunk_index = chunk_edges.first;
-      // convert to table
-      GAR_ASSIGN_OR_RAISE(auto input_table, convertToTable(chunk_edges.second));
-      // write table
-      GAR_RETURN_NOT_OK(writer.WriteTable(input_table, vertex_chunk_index, 0));
-      chunk_edges.second.clear();
-    }
-    is_saved_ = true;
-    return Status::OK();
-  }
+  Status Dump(int thread_num = 0);
 
  private:
+  /// The buffered edges sorted by vertex chunk.
+  struct SortedEdges {
+    // the sorted edges, or nullptr if there are no edges
+    std::shared_ptr<arrow::Table> table;
+    // the begin of the edges of each vertex chunk, and the end
+    std::vector<IdType> chunk_begins;
+    // the sources or destinations of the sorted edges, for the ordered
+    // adj list only
+    std::vector<IdType> vertices;
+  };
+
+  /// A run of sorted edges spilled to a file.
+  struct SpilledRun {
+    std::string path;
+    // the vertex chunk of each record batch of the file
+    std::vector<IdType> chunk_indices;
+  };
+
   /**
-   * @brief Construct an array for a given property.
-   *
-   * @param type The type of the property.
-   * @param property_name The name of the property.
-   * @param array The constructed array.
-   * @param edges The edges of a specific vertex chunk.
-   * @return Status: ok or Status::TypeError error.
+   * @brief Resolve the columns of the edges from the edge info, and create
+   * a builder for each.
    */
-  Status appendToArray(const DataType& type, const std::string& property_name,
-                       std::shared_ptr<arrow::Array>& array,  // NOLINT
-                       const std::vector<Edge>& edges);
+  void initColumns();
 
   /**
-   * @brief Append the values for a propety for edges in a specific vertex
-   * chunk into the given array.
+   * @brief Finish the builders, and move their arrays to the columns.
    *
-   * @tparam type The data type.
-   * @param property_name The name of the property.
-   * @param array The array to append.
-   * @param edges The edges of a specific vertex chunk.
    * @return Status: ok or Status::ArrowError error.
    */
-  template <Type type>
-  Status tryToAppend(const std::string& property_name,
-                     std::shared_ptr<arrow::Array>& array,  // NOLINT
-                     const std::vector<Edge>& edges);
+  Status finishBuilders();
 
   /**
-   * @brief Append the adj list for edges in a specific vertex chunk
-   * into the given array.
+   * @brief Sort the buffered edges by vertex chunk, and by source or
+   * destination for the ordered adj list. The buffers are released.
    *
-   * @param src_or_dest Choose to append sources or destinations.
-   * @param array The array to append.
-   * @param edges The edges of a specific vertex chunk.
-   * @return Status: ok or Status::ArrowError error.
+   * @param thread_num The number of threads to sort the vertex chunks and
+   *     permute the columns.
+   * @return The sorted edges, or error.
    */
-  Status tryToAppend(int src_or_dest,
-                     std::shared_ptr<arrow::Array>& array,  // NOLINT
-                     const std::vector<Edge>& edges);
+  Result<SortedEdges> sortEdges(int thread_num);
 
   /**
-   * @brief Convert the edges in a specific vertex chunk into
-   * an Arrow Table.
+   * @brief Sort the buffered edges and write them to a new run file.
    *
-   * @param edges The edges of a specific vertex chunk.
+   * @return Status: ok or error.
    */
-  Result<std::shared_ptr<arrow::Table>> convertToTable(
-      const std::vector<Edge>& edges);
+  Status spill();
+
+  /**
+   * @brief Merge the edges of a vertex chunk from the runs and the memory.
+   *
+   * @param pieces The edges of the vertex chunk, each sorted, in the order
+   *     they are added.
+   * @param vertices The sources or destinations of the edges of each piece.
+   * @param merged_vertices The sources or destinations of the merged edges,
+   *     for the ordered adj list only.
+   * @return The merged edges, or error.
+   */
+  Result<std::shared_ptr<arrow::Table>> mergePieces(
+      const std::vector<std::shared_ptr<arrow::Table>>& pieces,
+      const std::vector<const IdType*>& vertices,
+      std::vector<IdType>* merged_vertices) const;
+
+  /// Remove the run files.
+  void removeRuns();
 
   /**
    * @brief Construct the offset table if the adj list type is ordered.
    *
    * @param vertex_chunk_index The corresponding vertex chunk index.
-   * @param edges The edges of a specific vertex chunk.
+   * @param vertices The sources or destinations of the edges of the vertex
+   *     chunk, which are counted by util::ComputeOffsets.
+   * @param num The number of edges of the vertex chunk.
    */
   Result<std::shared_ptr<arrow::Table>> getOffsetTable(
-      IdType vertex_chunk_index, const std::vector<Edge>& edges);
+      IdType vertex_chunk_index, const IdType* vertices, IdType num) const;
 
  private:
   EdgeInfo edge_info_;
   std::string prefix_;
   AdjListType adj_list_type_;
-  std::unordered_map<IdType, std::vector<Edge>> edges_;
+  // the sources, the destinations, and the properties
+  std::shared_ptr<arrow::Schema> schema_;
+  std::vector<DataType> types_;
+  std::unordered_map<std::string, int> column_indices_;
+  std::vector<std::unique_ptr<arrow::ArrayBuilder>> builders_;
+  std::vector<arrow::ArrayVector> columns_;
+  // the memory budget, and the runs spilled beyond it
+  int64_t memory_budget_;
+  int64_t buffered_bytes_;
+  int64_t row_bytes_;
+  std::string spill_dir_;
+  std::vector<SpilledRun> runs_;
   IdType vertex_chunk_size_;
   IdType num_vertices_;
   IdType num_edges_;
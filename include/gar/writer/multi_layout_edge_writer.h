@@ -0,0 +1,107 @@
+/** Copyright 2022 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef GAR_WRITER_MULTI_LAYOUT_EDGE_WRITER_H_
+#define GAR_WRITER_MULTI_LAYOUT_EDGE_WRITER_H_
+
+#include <memory>
+#include <string>
+
+#include "gar/graph_info.h"
+#include "gar/utils/result.h"
+#include "gar/utils/status.h"
+#include "gar/utils/utils.h"
+#include "gar/writer/arrow_chunk_writer.h"
+
+// forward declaration
+namespace arrow {
+class Table;
+}  // namespace arrow
+
+namespace GAR_NAMESPACE_INTERNAL {
+
+/**
+ * @brief The writer that writes all adj list types of an edge info from one
+ * table of edges.
+ *
+ * Instead of an EdgeChunkWriter per adj list type, each re-partitioning and
+ * re-sorting the edges, the edges are sorted once by the sources and once by
+ * the destinations. The sorting is stable, so it partitions the edges by
+ * vertex chunk for both the unordered and the ordered adj lists of the
+ * direction, and the boundaries of the vertex chunks come from the counted
+ * offsets. The adj lists, offsets and properties of each adj list type and
+ * vertex chunk are then written concurrently. The directions are written
+ * one after the other, so only one sorted copy of the edges is held at a
+ * time.
+ */
+class MultiLayoutEdgeWriter {
+ public:
+  /**
+   * @brief Initialize the MultiLayoutEdgeWriter.
+   *
+   * @param edge_info The edge info that describes the edge type.
+   * @param prefix The absolute prefix.
+   * @param validate_level The validate level, with no validate by default.
+   */
+  MultiLayoutEdgeWriter(
+      const EdgeInfo& edge_info, const std::string& prefix,
+      const ValidateLevel& validate_level = ValidateLevel::no_validate)
+      : edge_info_(edge_info),
+        prefix_(prefix),
+        validate_level_(validate_level) {}
+
+  /**
+   * @brief Write the edges of a table to all adj list types of the edge
+   * info.
+   *
+   * @param input_table The table of all edges, with the non-null int64
+   *     columns GeneralParams::kSrcIndexCol and GeneralParams::kDstIndexCol,
+   *     and the columns of the properties of all adj list types.
+   * @param src_num The number of source vertices, to write the offsets of
+   *     the vertex chunks without edges too, or -1 to decide it by the
+   *     largest source.
+   * @param dst_num The number of destination vertices, or -1 to decide it by
+   *     the largest destination.
+   * @param thread_num The number of threads, the number of hardware threads is
+   *     used if it is not positive.
+   * @return Status: ok or error.
+   */
+  Status WriteTable(const std::shared_ptr<arrow::Table>& input_table,
+                    IdType src_num = -1, IdType dst_num = -1,
+                    int thread_num = 0) const noexcept;
+
+ private:
+  /**
+   * @brief Sort the edges by the sources or the destinations, and write the
+   * adj list types of the direction.
+   *
+   * @param input_table The table of all edges.
+   * @param by_source Whether to write the adj lists by source or by dest.
+   * @param vertex_num The number of vertices of the direction, or -1.
+   * @param thread_num The number of threads.
+   * @return Status: ok or error.
+   */
+  Status writeDirection(const std::shared_ptr<arrow::Table>& input_table,
+                        bool by_source, IdType vertex_num,
+                        int thread_num) const noexcept;
+
+ private:
+  EdgeInfo edge_info_;
+  std::string prefix_;
+  ValidateLevel validate_level_;
+};
+
+}  // namespace GAR_NAMESPACE_INTERNAL
+#endif  // GAR_WRITER_MULTI_LAYOUT_EDGE_WRITER_H_
@@ -16,19 +16,18 @@ limitations under the License.
 #ifndef GAR_WRITER_VERTICES_BUILDER_H_
 #define GAR_WRITER_VERTICES_BUILDER_H_
 
+#include <algorithm>
 #include <any>
+#include <deque>
+#include <future>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
-#include "gar/writer/arrow_chunk_writer.h"
+#include "arrow/api.h"
 
-// forward declaration
-namespace arrow {
-class Array;
-class Table;
-}  // namespace arrow
+#include "gar/writer/arrow_chunk_writer.h"
 
 namespace GAR_NAMESPACE_INTERNAL {
 namespace builder {
@@ -120,6 +119,18 @@ class Vertex {
  * @brief VertexBuilder is designed for building and writing a collection of
  * vertices.
  *
+ * The vertices are stored by column: a typed column for each property of the
+ * vertex info, indexed by the position of the property and resolved once at
+ * construction. The vertices added one by one are appended to Arrow builders,
+ * and the tables added in bulk are kept as their arrays without copy. The
+ * vertices added at explicit indices only record their positions, and the
+ * columns are scattered to the positions once when dumping, leaving the
+ * vertices never added as nulls.
+ *
+ * In the streaming mode, once the vertices are appended consecutively past
+ * the end of a vertex chunk, the chunk is written in the background and its
+ * memory is released, so only the unfinished chunk and the chunks being
+ * written are held in memory.
  */
 class VerticesBuilder {
  public:
@@ -136,9 +147,30 @@ class VerticesBuilder {
       : vertex_info_(vertex_info),
         prefix_(prefix),
         start_vertex_index_(start_vertex_index) {
-    vertices_.clear();
+    num_rows_ = 0;
+    num_buffered_ = 0;
+    num_flushed_ = 0;
     num_vertices_ = 0;
+    max_in_flight_chunks_ = 0;
     is_saved_ = false;
+    initColumns();
+  }
+
+  /**
+   * @brief Enable the streaming mode, which writes each vertex chunk in the
+   * background once it is full.
+   *
+   * A chunk is full once the vertices are appended consecutively past its
+   * end; the vertices added at explicit indices stop the flushing, and the
+   * remaining vertices are written when dumping. After a chunk is flushed,
+   * the vertices of it can not be added anymore. The errors of writing a
+   * chunk are returned by a later adding or by dumping.
+   *
+   * @param max_in_flight_chunks The maximum number of chunks being written
+   *     at a time, beyond which the adding waits for the oldest one.
+   */
+  void EnableStreaming(int max_in_flight_chunks = 2) {
+    max_in_flight_chunks_ = std::max(max_in_flight_chunks, 1);
   }
 
   /**
@@ -161,6 +193,9 @@ class VerticesBuilder {
     if (index != -1 && index < start_vertex_index_)
       return Status::InvalidOperation(
           "vertex index must larger than start index");
+    // the chunk of the vertex index is flushed
+    if (index != -1 && index < start_vertex_index_ + num_flushed_)
+      return Status::InvalidOperation("vertex index is already flushed");
     // contain invalid properties
     for (auto& property : v.GetProperties()) {
       if (!vertex_info_.ContainProperty(property.first))
@@ -172,26 +207,42 @@ class VerticesBuilder {
   /**
    * @brief Add a vertex with the given index.
    *
-   * @param v The vertex to add.
+   * The vertex is appended to the columns, so it is not kept by the builder.
+   * A vertex added at an index that was added before replaces it.
+   *
+   * @param v The vertex to add, whose id is set to its index.
    * @param index The given index, -1 means the next unused index.
-   * @return Status: ok or Status::InvalidOperation error.
+   * @return Status: ok or Status::InvalidOperation error, or
+   *     Status::TypeError if the value of a property is not of its type.
    */
-  Status AddVertex(Vertex& v, IdType index = -1) {  // NOLINT
-    // validate
-    GAR_RETURN_NOT_OK(Validate(v, index));
-    // add a vertex
-    if (index == -1) {
-      v.SetId(vertices_.size());
-      vertices_.push_back(v);
-    } else {
-      v.SetId(index);
-      if (index >= static_cast<IdType>(vertices_.size()))
-        vertices_.resize(index + 1);
-      vertices_[index] = v;
-    }
-    num_vertices_++;
-    return Status::OK();
-  }
+  Status AddVertex(Vertex& v, IdType index = -1);  // NOLINT
+
+  /**
+   * @brief Add the vertices of a table with consecutive indices.
+   *
+   * The table contains the columns of some properties of the vertex info,
+   * whose types must match the properties. The properties not in the table
+   * are null. The arrays of the table are kept without copy until dumping.
+   *
+   * @param table The table of the vertices.
+   * @param index The index of the first vertex, -1 means the next unused
+   *     index.
+   * @return Status: ok or Status::InvalidOperation error, or
+   *     Status::TypeError if a column is not of its type.
+   */
+  Status AddVertices(const std::shared_ptr<arrow::Table>& table,
+                     IdType index = -1);
+
+  /**
+   * @brief Add the vertices of a record batch with consecutive indices.
+   *
+   * @param batch The record batch of the vertices, see AddVertices(table).
+   * @param index The index of the first vertex, -1 means the next unused
+   *     index.
+   * @return Status: ok or error.
+   */
+  Status AddVertices(const std::shared_ptr<arrow::RecordBatch>& batch,
+                     IdType index = -1);
 
   /**
    * @brief Get the current number of vertices in the collection.
@@ -205,57 +256,70 @@ class VerticesBuilder {
    *
    * @return Status: ok or error.
    */
-  Status Dump() {
-    // construct the writer
-    VertexPropertyWriter writer(vertex_info_, prefix_);
-    IdType start_chunk_index =
-        start_vertex_index_ / vertex_info_.GetChunkSize();
-    // convert to table
-    GAR_ASSIGN_OR_RAISE(auto input_table, convertToTable());
-    // write table
-    GAR_RETURN_NOT_OK(writer.WriteTable(input_table, start_chunk_index));
-    GAR_RETURN_NOT_OK(
-        writer.WriteVerticesNum(num_vertices_ + start_vertex_index_));
-    is_saved_ = true;
-    vertices_.clear();
-    return Status::OK();
-  }
+  Status Dump();
 
  private:
   /**
-   * @brief Construct an array for a given property.
-   *
-   * @param type The type of the property.
-   * @param property_name The name of the property.
-   * @param array The constructed array.
-   * @return Status: ok or Status::TypeError error.
+   * @brief Resolve the columns of the properties from the vertex info, and
+   * create a builder for each.
    */
-  Status appendToArray(const DataType& type, const std::string& property_name,
-                       std::shared_ptr<arrow::Array>& array);  // NOLINT
+  void initColumns();
 
   /**
-   * @brief Append values for a property into the given array.
+   * @brief Finish the builders, and move their arrays to the columns.
    *
-   * @tparam type The data type.
-   * @param property_name The name of the property.
-   * @param array The array to append.
    * @return Status: ok or Status::ArrowError error.
    */
-  template <Type type>
-  Status tryToAppend(const std::string& property_name,
-                     std::shared_ptr<arrow::Array>& array);  // NOLINT
+  Status finishBuilders();
 
   /**
-   * @brief Convert the vertices collection into an Arrow Table.
+   * @brief Record the positions of the vertices appended to the columns.
+   *
+   * The positions are only materialized once a vertex is not appended at
+   * the next position.
+   *
+   * @param position The position of the first vertex, relative to the start
+   *     vertex index.
+   * @param num The number of vertices.
+   */
+  void recordPositions(IdType position, IdType num);
+
+  /**
+   * @brief Write the full vertex chunks in the background in the streaming
+   * mode, and release them.
+   *
+   * @return Status: ok or error.
+   */
+  Status flushChunks();
+
+  /**
+   * @brief Wait for the chunks being written until no more than the given
+   * number are left.
+   *
+   * @param max_in_flight_chunks The number of chunks left being written.
+   * @return Status: ok or the first error of writing the chunks.
    */
-  Result<std::shared_ptr<arrow::Table>> convertToTable();
+  Status waitChunks(size_t max_in_flight_chunks);
 
  private:
   VertexInfo vertex_info_;
   std::string prefix_;
-  std::vector<Vertex> vertices_;
   IdType start_vertex_index_;
+  // the properties, in the order of the property groups
+  std::shared_ptr<arrow::Schema> schema_;
+  std::vector<DataType> types_;
+  std::unordered_map<std::string, int> column_indices_;
+  std::vector<std::unique_ptr<arrow::ArrayBuilder>> builders_;
+  std::vector<arrow::ArrayVector> columns_;
+  // the positions of the buffered vertices, empty if they are consecutive
+  std::vector<IdType> positions_;
+  IdType num_rows_;
+  IdType num_buffered_;
+  // the vertices before the position are flushed in the streaming mode
+  IdType num_flushed_;
   IdType num_vertices_;
+  int max_in_flight_chunks_;
+  std::deque<std::future<Status>> in_flight_chunks_;
   bool is_saved_;
 };
 
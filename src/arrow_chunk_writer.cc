@@ -421,56 +421,48 @@ Result<std::shared_ptr<arrow::Table>> EdgeChunkWriter::getOffsetTable(
     const std::string& column_name, IdType vertex_chunk_index) const noexcept {
   std::shared_ptr<arrow::ChunkedArray> column =
       input_table->GetColumnByName(column_name);
-  int64_t array_index = 0, index = 0;
-  auto ids =
-      std::static_pointer_cast<arrow::Int64Array>(column->chunk(array_index));
-
-  arrow::Int64Builder builder;
-  IdType begin_index = vertex_chunk_index * vertex_chunk_size_,
-         end_index = begin_index + vertex_chunk_size_;
-  RETURN_NOT_ARROW_OK(builder.Append(0));
-  std::vector<std::shared_ptr<arrow::Array>> arrays;
-  std::vector<std::shared_ptr<arrow::Field>> schema_vector;
-  std::string property = GeneralParams::kOffsetCol;
-  schema_vector.push_back(arrow::field(
-      property, DataType::DataTypeToArrowDataType(DataType(Type::INT64))));
-
-  int64_t global_index = 0;
-  for (IdType i = begin_index; i < end_index; i++) {
-    while (true) {
-      if (array_index >= column->num_chunks())
-        break;
-      if (index >= ids->length()) {
-        array_index++;
-        if (array_index == column->num_chunks())
-          break;
-        ids = std::static_pointer_cast<arrow::Int64Array>(
-            column->chunk(array_index));
-        index = 0;
-      }
-      if (ids->IsNull(index) || !ids->IsValid(index)) {
-        index++;
-        global_index++;
-        continue;
-      }
-      int64_t x = ids->Value(index);
-      if (x <= i) {
-        index++;
-        global_index++;
-      } else {
-        break;
-      }
-    }
-    RETURN_NOT_ARROW_OK(builder.Append(global_index));
+  if (column == nullptr) {
+    return Status::KeyError("The column " + column_name + " does not exist.");
   }
-
-  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto array, builder.Finish());
-  arrays.push_back(array);
-  auto schema = std::make_shared<arrow::Schema>(schema_vector);
-  return arrow::Table::Make(schema, arrays);
+  IdType begin_index = vertex_chunk_index * vertex_chunk_size_;
+  GAR_ASSIGN_OR_RAISE(auto array, util::ComputeOffsets(column, begin_index,
+                                                       vertex_chunk_size_));
+  std::string property = GeneralParams::kOffsetCol;
+  auto schema = arrow::schema({arrow::field(
+      property, DataType::DataTypeToArrowDataType(DataType(Type::INT64)))});
+  return arrow::Table::Make(schema, {array});
 }
 
 Result<std::shared_ptr<arrow::Table>> EdgeChunkWriter::sortTable(
+    const std::shared_ptr<arrow::Table>& input_table,
+    const std::string& column_name, int thread_num) {
+  auto column = input_table->GetColumnByName(column_name);
+  if (column == nullptr || !column->type()->Equals(arrow::int64()) ||
+      column->null_count() > 0) {
+    return sortTableByExecPlan(input_table, column_name);
+  }
+  if (input_table->num_rows() == 0) {
+    return input_table;
+  }
+  std::shared_ptr<arrow::Array> keys;
+  if (column->num_chunks() == 1) {
+    keys = column->chunk(0);
+  } else {
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(keys,
+                                         arrow::Concatenate(column->chunks()));
+  }
+  int64_t length = keys->length();
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      std::shared_ptr<arrow::Buffer> buffer,
+      arrow::AllocateBuffer(length * sizeof(int64_t)));
+  GAR_RETURN_NOT_OK(util::SortIndices(
+      std::static_pointer_cast<arrow::Int64Array>(keys)->raw_values(), length,
+      reinterpret_cast<int64_t*>(buffer->mutable_data()), thread_num));
+  auto indices = std::make_shared<arrow::Int64Array>(length, buffer);
+  return util::TakeTable(input_table, indices, thread_num);
+}
+
+Result<std::shared_ptr<arrow::Table>> EdgeChunkWriter::sortTableByExecPlan(
     const std::shared_ptr<arrow::Table>& input_table,
     const std::string& column_name) {
   auto exec_context = arrow::compute::default_exec_context();
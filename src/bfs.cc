@@ -0,0 +1,236 @@
+/** Copyright 2022 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/api.h"
+
+#include "gar/algorithm/bfs.h"
+#include "gar/utils/bitmap.h"
+#include "gar/writer/arrow_chunk_writer.h"
+
+namespace GAR_NAMESPACE_INTERNAL {
+
+namespace {
+
+// switch to bottom-up once the edges of the frontier are more than 1/alpha
+// of the edges of the unvisited vertices
+constexpr double kAlpha = 15.0;
+// switch back to top-down once the frontier shrinks below 1/beta of the
+// vertices
+constexpr double kBeta = 18.0;
+// the number of vertices handed to a thread at a time
+constexpr IdType kBlockSize = 1024;
+// the top-down levels visiting fewer edges run on the calling thread, since
+// creating the threads costs more than visiting the edges
+constexpr IdType kParallelEdges = 64 * 1024;
+
+/// Run the direction-optimizing BFS on a CSR or a CompressedCSR.
+template <typename AdjList>
+Result<BFSResult> RunBFS(const AdjList& out_edges, const AdjList& in_edges,
+                         IdType root, int thread_num) {
+  IdType vertex_num = out_edges.GetVertexNum();
+  if (in_edges.GetVertexNum() != vertex_num) {
+    return Status::Invalid(
+        "The incoming and outgoing edges have different numbers of "
+        "vertices.");
+  }
+  if (root < 0 || root >= vertex_num) {
+    return Status::OutOfRange("The root " + std::to_string(root) +
+                              " is out of range.");
+  }
+
+  BFSResult result;
+  result.distance.assign(vertex_num, -1);
+  std::unique_ptr<std::atomic<IdType>[]> parent(
+      new std::atomic<IdType>[vertex_num]);
+  for (IdType i = 0; i < vertex_num; ++i) {
+    parent[i].store(-1, std::memory_order_relaxed);
+  }
+  parent[root].store(root, std::memory_order_relaxed);
+  result.distance[root] = 0;
+
+  // the frontier is held by a vector in top-down iterations, and by a bitmap
+  // in bottom-up iterations
+  std::vector<IdType> frontier = {root};
+  util::Bitmap frontier_bitmap(vertex_num), next_bitmap(vertex_num);
+  bool top_down = true;
+  IdType frontier_size = 1;
+  // the edges of the frontier, and of the unvisited vertices
+  IdType frontier_edges = out_edges.GetDegree(root);
+  IdType unvisited_edges = out_edges.GetEdgeNum() - frontier_edges;
+
+  for (int32_t level = 0; frontier_size > 0; ++level) {
+    if (top_down && frontier_edges > unvisited_edges / kAlpha) {
+      frontier_bitmap.Clear();
+      for (auto vid : frontier) {
+        frontier_bitmap.Set(vid);
+      }
+      top_down = false;
+    }
+
+    std::atomic<IdType> next_size(0), next_edges(0);
+    if (top_down) {
+      IdType block_num = (frontier_size + kBlockSize - 1) / kBlockSize;
+      int level_thread_num = frontier_edges < kParallelEdges ? 1 : thread_num;
+      std::vector<std::vector<IdType>> next_frontiers(block_num);
+      GAR_RETURN_NOT_OK(util::ParallelFor(
+          0, block_num,
+          [&](IdType block) -> Status {
+            IdType end = std::min((block + 1) * kBlockSize, frontier_size);
+            auto& next = next_frontiers[block];
+            IdType edges = 0;
+            for (IdType i = block * kBlockSize; i < end; ++i) {
+              IdType vid = frontier[i];
+              out_edges.ForEachNeighbor(vid, [&](IdType neighbor) {
+                IdType expected = -1;
+                if (parent[neighbor].load(std::memory_order_relaxed) == -1 &&
+                    parent[neighbor].compare_exchange_strong(expected, vid)) {
+                  // only the thread claiming the parent sets the distance
+                  result.distance[neighbor] = level + 1;
+                  next.push_back(neighbor);
+                  edges += out_edges.GetDegree(neighbor);
+                }
+              });
+            }
+            next_edges += edges;
+            return Status::OK();
+          },
+          level_thread_num));
+      frontier.clear();
+      for (const auto& next : next_frontiers) {
+        frontier.insert(frontier.end(), next.begin(), next.end());
+      }
+      next_size = frontier.size();
+      ++result.push_iterations;
+    } else {
+      next_bitmap.Clear();
+      IdType block_num = (vertex_num + kBlockSize - 1) / kBlockSize;
+      GAR_RETURN_NOT_OK(util::ParallelFor(
+          0, block_num,
+          [&](IdType block) -> Status {
+            IdType end = std::min((block + 1) * kBlockSize, vertex_num);
+            IdType size = 0, edges = 0;
+            for (IdType vid = block * kBlockSize; vid < end; ++vid) {
+              if (parent[vid].load(std::memory_order_relaxed) != -1) {
+                continue;
+              }
+              IdType neighbor = in_edges.FindNeighbor(
+                  vid, [&](IdType v) { return frontier_bitmap.Get(v); });
+              if (neighbor != -1) {
+                parent[vid].store(neighbor, std::memory_order_relaxed);
+                result.distance[vid] = level + 1;
+                next_bitmap.AtomicSet(vid);
+                ++size;
+                edges += out_edges.GetDegree(vid);
+              }
+            }
+            next_size += size;
+            next_edges += edges;
+            return Status::OK();
+          },
+          thread_num));
+      frontier_bitmap.Swap(next_bitmap);
+      ++result.pull_iterations;
+      // switch back to top-down once the frontier is small and shrinking
+      if (next_size < frontier_size && next_size < vertex_num / kBeta) {
+        frontier.clear();
+        for (IdType vid = 0; vid < vertex_num; ++vid) {
+          if (frontier_bitmap.Get(vid)) {
+            frontier.push_back(vid);
+          }
+        }
+        top_down = true;
+      }
+    }
+    frontier_size = next_size;
+    frontier_edges = next_edges;
+    unvisited_edges -= frontier_edges;
+  }
+
+  result.parent.resize(vertex_num);
+  for (IdType i = 0; i < vertex_num; ++i) {
+    result.parent[i] = parent[i].load(std::memory_order_relaxed);
+  }
+  return result;
+}
+
+}  // namespace
+
+Result<BFSResult> BFS(const CSR& out_edges, const CSR& in_edges, IdType root,
+                      int thread_num) noexcept {
+  return RunBFS(out_edges, in_edges, root, thread_num);
+}
+
+Result<BFSResult> BFS(const CompressedCSR& out_edges,
+                      const CompressedCSR& in_edges, IdType root,
+                      int thread_num) noexcept {
+  return RunBFS(out_edges, in_edges, root, thread_num);
+}
+
+Result<BFSResult> BFS(const EdgeInfo& edge_info, const VertexInfo& vertex_info,
+                      const std::string& prefix, IdType root,
+                      int thread_num) noexcept {
+  if (edge_info.GetSrcLabel() != edge_info.GetDstLabel()) {
+    return Status::Invalid(
+        "The source and destination of the edges must be of the same "
+        "vertex type.");
+  }
+  GAR_ASSIGN_OR_RAISE(auto out_edges,
+                      LoadCSR(edge_info, vertex_info, prefix,
+                              AdjListType::ordered_by_source, thread_num));
+  GAR_ASSIGN_OR_RAISE(auto in_edges,
+                      LoadCSR(edge_info, vertex_info, prefix,
+                              AdjListType::ordered_by_dest, thread_num));
+  return BFS(out_edges, in_edges, root, thread_num);
+}
+
+Status WriteBFSResult(const BFSResult& result,
+                      const VertexPropertyWriter& writer,
+                      const PropertyGroup& property_group) noexcept {
+  const auto& properties = property_group.GetProperties();
+  if (properties.empty() || properties.size() > 2 ||
+      !(properties[0].type == DataType(Type::INT32)) ||
+      (properties.size() == 2 &&
+       !(properties[1].type == DataType(Type::INT64)))) {
+    return Status::Invalid(
+        "The property group must contain an int32 property for the "
+        "distances, and optionally an int64 property for the parents.");
+  }
+  std::vector<std::shared_ptr<arrow::Field>> fields;
+  std::vector<std::shared_ptr<arrow::Array>> arrays;
+  arrow::Int32Builder distance_builder;
+  RETURN_NOT_ARROW_OK(distance_builder.AppendValues(result.distance));
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto distance_array,
+                                       distance_builder.Finish());
+  fields.push_back(arrow::field(properties[0].name, arrow::int32()));
+  arrays.push_back(distance_array);
+  if (properties.size() == 2) {
+    arrow::Int64Builder parent_builder;
+    RETURN_NOT_ARROW_OK(parent_builder.AppendValues(result.parent));
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto parent_array,
+                                         parent_builder.Finish());
+    fields.push_back(arrow::field(properties[1].name, arrow::int64()));
+    arrays.push_back(parent_array);
+  }
+  auto table = arrow::Table::Make(arrow::schema(fields), arrays);
+  return writer.WriteTable(table, property_group, 0);
+}
+
+}  // namespace GAR_NAMESPACE_INTERNAL
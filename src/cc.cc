@@ -0,0 +1,201 @@
+/** Copyright 2022 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "arrow/api.h"
+
+#include "gar/algorithm/cc.h"
+#include "gar/utils/filesystem.h"
+#include "gar/utils/general_params.h"
+#include "gar/utils/property_column.h"
+#include "gar/utils/reader_utils.h"
+#include "gar/writer/arrow_chunk_writer.h"
+
+namespace GAR_NAMESPACE_INTERNAL {
+
+namespace {
+
+// the number of vertices handled by a thread at a time
+constexpr IdType kBlockSize = 1024;
+
+/**
+ * A lock-free union-find, in which the root of a set is always its smallest
+ * element.
+ */
+class UnionFind {
+ public:
+  explicit UnionFind(IdType size) : parent_(new std::atomic<IdType>[size]) {
+    for (IdType i = 0; i < size; ++i) {
+      parent_[i].store(i, std::memory_order_relaxed);
+    }
+  }
+
+  /// Find the root of an element, halving the path on the way.
+  IdType Find(IdType x) noexcept {
+    while (true) {
+      IdType p = parent_[x].load(std::memory_order_relaxed);
+      if (p == x) {
+        return x;
+      }
+      IdType gp = parent_[p].load(std::memory_order_relaxed);
+      if (p != gp) {
+        parent_[x].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+      }
+      x = gp;
+    }
+  }
+
+  /// Merge the sets of two elements, linking the larger root to the smaller.
+  void Union(IdType x, IdType y) noexcept {
+    while (true) {
+      x = Find(x);
+      y = Find(y);
+      if (x == y) {
+        return;
+      }
+      if (x < y) {
+        std::swap(x, y);
+      }
+      // the link fails if x is no longer a root, then retry
+      IdType expected = x;
+      if (parent_[x].compare_exchange_strong(expected, y,
+                                             std::memory_order_relaxed)) {
+        return;
+      }
+    }
+  }
+
+ private:
+  std::unique_ptr<std::atomic<IdType>[]> parent_;
+};
+
+}  // namespace
+
+Result<CCResult> ConnectedComponents(const EdgeInfo& edge_info,
+                                     const VertexInfo& vertex_info,
+                                     const std::string& prefix,
+                                     AdjListType adj_list_type,
+                                     int thread_num) noexcept {
+  if (edge_info.GetSrcLabel() != edge_info.GetDstLabel()) {
+    return Status::Invalid(
+        "The source and destination of the edges must be of the same "
+        "vertex type.");
+  }
+  GAR_ASSIGN_OR_RAISE(IdType vertex_num,
+                      utils::GetVertexNum(prefix, vertex_info));
+  std::string out_prefix;
+  GAR_ASSIGN_OR_RAISE(auto fs, FileSystemFromUriOrPath(prefix, &out_prefix));
+  GAR_ASSIGN_OR_RAISE(auto file_type,
+                      edge_info.GetAdjListFileType(adj_list_type));
+  GAR_ASSIGN_OR_RAISE(auto dir_path,
+                      edge_info.GetAdjListDirPath(adj_list_type));
+  std::string base_dir = out_prefix + dir_path;
+  GAR_ASSIGN_OR_RAISE(IdType vertex_chunk_num, fs->GetFileNumOfDir(base_dir));
+
+  // list the adjList chunks as (vertex chunk index, edge chunk index)
+  std::vector<IdType> edge_chunk_nums(vertex_chunk_num, 0);
+  GAR_RETURN_NOT_OK(util::ParallelFor(
+      0, vertex_chunk_num,
+      [&](IdType i) -> Status {
+        std::string chunk_dir = base_dir + "/part" + std::to_string(i);
+        GAR_ASSIGN_OR_RAISE(edge_chunk_nums[i],
+                            fs->GetFileNumOfDir(chunk_dir));
+        return Status::OK();
+      },
+      thread_num));
+  std::vector<std::pair<IdType, IdType>> chunks;
+  for (IdType i = 0; i < vertex_chunk_num; ++i) {
+    for (IdType j = 0; j < edge_chunk_nums[i]; ++j) {
+      chunks.emplace_back(i, j);
+    }
+  }
+
+  // merge the edges of each chunk as soon as it is read
+  UnionFind union_find(vertex_num);
+  GAR_RETURN_NOT_OK(util::ParallelFor(
+      0, chunks.size(),
+      [&](IdType k) -> Status {
+        GAR_ASSIGN_OR_RAISE(
+            auto chunk_path,
+            edge_info.GetAdjListFilePath(chunks[k].first, chunks[k].second,
+                                         adj_list_type));
+        GAR_ASSIGN_OR_RAISE(
+            auto chunk_table,
+            fs->ReadFileToTable(out_prefix + chunk_path, file_type));
+        PropertyColumn<IdType> src(GeneralParams::kSrcIndexCol);
+        PropertyColumn<IdType> dst(GeneralParams::kDstIndexCol);
+        GAR_RETURN_NOT_OK(src.Bind(chunk_table, k));
+        GAR_RETURN_NOT_OK(dst.Bind(chunk_table, k));
+        for (int64_t row = 0; row < src.length(); ++row) {
+          IdType u = src[row], v = dst[row];
+          if (u < 0 || u >= vertex_num || v < 0 || v >= vertex_num) {
+            return Status::Invalid("The edge (" + std::to_string(u) + ", " +
+                                   std::to_string(v) +
+                                   ") has a vertex out of range.");
+          }
+          union_find.Union(u, v);
+        }
+        return Status::OK();
+      },
+      thread_num));
+
+  CCResult result;
+  result.component.resize(vertex_num);
+  IdType block_num = (vertex_num + kBlockSize - 1) / kBlockSize;
+  std::vector<IdType> block_component_nums(block_num, 0);
+  GAR_RETURN_NOT_OK(util::ParallelFor(
+      0, block_num,
+      [&](IdType block) -> Status {
+        IdType end = std::min((block + 1) * kBlockSize, vertex_num);
+        for (IdType vid = block * kBlockSize; vid < end; ++vid) {
+          result.component[vid] = union_find.Find(vid);
+          if (result.component[vid] == vid) {
+            ++block_component_nums[block];
+          }
+        }
+        return Status::OK();
+      },
+      thread_num));
+  for (auto num : block_component_nums) {
+    result.component_num += num;
+  }
+  return result;
+}
+
+Status WriteCCResult(const CCResult& result, const VertexPropertyWriter& writer,
+                     const PropertyGroup& property_group) noexcept {
+  const auto& properties = property_group.GetProperties();
+  if (properties.size() != 1 ||
+      !(properties[0].type == DataType(Type::INT64))) {
+    return Status::Invalid(
+        "The property group must contain a single int64 property for the "
+        "components.");
+  }
+  arrow::Int64Builder builder;
+  RETURN_NOT_ARROW_OK(builder.AppendValues(result.component));
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto array, builder.Finish());
+  auto table = arrow::Table::Make(
+      arrow::schema({arrow::field(properties[0].name, arrow::int64())}),
+      {array});
+  return writer.WriteTable(table, property_group, 0);
+}
+
+}  // namespace GAR_NAMESPACE_INTERNAL
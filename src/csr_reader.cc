@@ -0,0 +1,586 @@
+/** Copyright 2022 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "arrow/api.h"
+
+#include "gar/reader/arrow_chunk_reader.h"
+#include "gar/reader/csr_reader.h"
+#include "gar/utils/filesystem.h"
+#include "gar/utils/general_params.h"
+#include "gar/utils/reader_utils.h"
+
+namespace GAR_NAMESPACE_INTERNAL {
+
+CSR::CSR(AdjListType adj_list_type, std::shared_ptr<arrow::Int64Array> offsets,
+         std::shared_ptr<arrow::Int64Array> neighbors)
+    : adj_list_type_(adj_list_type),
+      offsets_(std::move(offsets)),
+      neighbors_(std::move(neighbors)) {
+  offsets_data_ = offsets_->raw_values();
+  neighbors_data_ = neighbors_->raw_values();
+  vertex_num_ = offsets_->length() - 1;
+  edge_num_ = neighbors_->length();
+}
+
+namespace {
+
+/// Allocate an uninitialized int64 array with specific length.
+Result<std::shared_ptr<arrow::Int64Array>> AllocateInt64Array(IdType length) {
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      std::shared_ptr<arrow::Buffer> buffer,
+      arrow::AllocateBuffer(length * sizeof(int64_t)));
+  return std::make_shared<arrow::Int64Array>(length, std::move(buffer));
+}
+
+/// Get the single int64 array of a column.
+Result<std::shared_ptr<arrow::Int64Array>> GetInt64Array(
+    const std::shared_ptr<arrow::ChunkedArray>& column) {
+  if (column->type()->id() != arrow::Type::INT64) {
+    return Status::TypeError("The column type " + column->type()->ToString() +
+                             " is not int64.");
+  }
+  if (column->num_chunks() == 1) {
+    return std::static_pointer_cast<arrow::Int64Array>(column->chunk(0));
+  }
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      auto array,
+      arrow::Concatenate(column->chunks(), arrow::default_memory_pool()));
+  return std::static_pointer_cast<arrow::Int64Array>(array);
+}
+
+void EncodeVarint(uint64_t value, std::vector<uint8_t>* out) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  out->push_back(static_cast<uint8_t>(value));
+}
+
+/// Encode a block of sorted neighbors as the first neighbor and the packed
+/// gaps, see CompressedCSR for the layout.
+void EncodeBlock(const IdType* neighbors, IdType num,
+                 std::vector<uint8_t>* out) {
+  EncodeVarint(static_cast<uint64_t>(neighbors[0]), out);
+  if (num == 1) {
+    return;
+  }
+  uint64_t max_gap = 0;
+  for (IdType i = 1; i < num; ++i) {
+    max_gap = std::max(max_gap,
+                       static_cast<uint64_t>(neighbors[i] - neighbors[i - 1]));
+  }
+  int width = 0;
+  while (width < 64 && (max_gap >> width) != 0) {
+    ++width;
+  }
+  IdType gap_num = num - 1;
+  if (width > CompressedCSR::kMaxPackedWidth) {
+    out->push_back(64);
+    size_t begin = out->size();
+    out->resize(begin + gap_num * sizeof(IdType));
+    for (IdType i = 0; i < gap_num; ++i) {
+      IdType gap = neighbors[i + 1] - neighbors[i];
+      std::memcpy(out->data() + begin + i * sizeof(IdType), &gap,
+                  sizeof(IdType));
+    }
+    return;
+  }
+  out->push_back(static_cast<uint8_t>(width));
+  size_t begin = out->size();
+  out->resize(begin + (gap_num * width + 7) / 8, 0);
+  uint8_t* packed = out->data() + begin;
+  for (IdType i = 0; i < gap_num; ++i) {
+    uint64_t gap = static_cast<uint64_t>(neighbors[i + 1] - neighbors[i]);
+    uint64_t bit = static_cast<uint64_t>(i) * width;
+    for (int j = 0; j < width; ++j, ++bit) {
+      if ((gap >> j) & 1) {
+        packed[bit >> 3] |= static_cast<uint8_t>(1 << (bit & 7));
+      }
+    }
+  }
+}
+
+/// Sort the neighbors of a vertex and append its record to out.
+void EncodeNeighbors(IdType* neighbors, IdType degree,
+                     std::vector<uint8_t>* out) {
+  std::sort(neighbors, neighbors + degree);
+  EncodeVarint(static_cast<uint64_t>(degree), out);
+  if (degree <= CompressedCSR::kBlockSize) {
+    if (degree > 0) {
+      EncodeBlock(neighbors, degree, out);
+    }
+    return;
+  }
+  // the blocks are encoded first to know their positions for the skip table
+  std::vector<uint8_t> blocks, skip_table;
+  for (IdType begin = 0; begin < degree; begin += CompressedCSR::kBlockSize) {
+    IdType num = std::min(CompressedCSR::kBlockSize, degree - begin);
+    EncodeVarint(static_cast<uint64_t>(neighbors[begin]), &skip_table);
+    EncodeVarint(blocks.size(), &skip_table);
+    EncodeBlock(neighbors + begin, num, &blocks);
+  }
+  EncodeVarint(skip_table.size(), out);
+  out->insert(out->end(), skip_table.begin(), skip_table.end());
+  out->insert(out->end(), blocks.begin(), blocks.end());
+}
+
+/// Get the vertex chunk size and the neighbor column of an ordered adj list.
+Status GetOrderedAdjListLayout(const EdgeInfo& edge_info,
+                               AdjListType adj_list_type,
+                               IdType* vertex_chunk_size,
+                               std::string* neighbor_column) {
+  if (adj_list_type == AdjListType::ordered_by_source) {
+    *vertex_chunk_size = edge_info.GetSrcChunkSize();
+    *neighbor_column = GeneralParams::kDstIndexCol;
+  } else if (adj_list_type == AdjListType::ordered_by_dest) {
+    *vertex_chunk_size = edge_info.GetDstChunkSize();
+    *neighbor_column = GeneralParams::kSrcIndexCol;
+  } else {
+    return Status::Invalid("The CSR can only be loaded from ordered adj list.");
+  }
+  if (!edge_info.ContainAdjList(adj_list_type)) {
+    return Status::KeyError(
+        "The adj list type " + std::string(AdjListTypeToString(adj_list_type)) +
+        " is not found in the edge info.");
+  }
+  return Status::OK();
+}
+
+}  // namespace
+
+Result<CSR> LoadCSR(const EdgeInfo& edge_info, const VertexInfo& vertex_info,
+                    const std::string& prefix, AdjListType adj_list_type,
+                    int thread_num) noexcept {
+  IdType vertex_chunk_size;
+  std::string neighbor_column;
+  GAR_RETURN_NOT_OK(GetOrderedAdjListLayout(
+      edge_info, adj_list_type, &vertex_chunk_size, &neighbor_column));
+  IdType edge_chunk_size = edge_info.GetChunkSize();
+  std::string out_prefix;
+  GAR_ASSIGN_OR_RAISE(auto fs, FileSystemFromUriOrPath(prefix, &out_prefix));
+  GAR_ASSIGN_OR_RAISE(auto file_type,
+                      edge_info.GetAdjListFileType(adj_list_type));
+  GAR_ASSIGN_OR_RAISE(auto offset_dir,
+                      edge_info.GetAdjListOffsetDirPath(adj_list_type));
+  GAR_ASSIGN_OR_RAISE(auto adj_list_dir,
+                      edge_info.GetAdjListDirPath(adj_list_type));
+  GAR_ASSIGN_OR_RAISE(IdType vertex_chunk_num,
+                      fs->GetFileNumOfDir(out_prefix + offset_dir));
+
+  // read the offset chunks, which tell the number of vertices and edges of
+  // each vertex chunk
+  std::vector<std::shared_ptr<arrow::Int64Array>> local_offsets(
+      vertex_chunk_num);
+  std::vector<IdType> edge_chunk_nums(vertex_chunk_num, 0);
+  GAR_RETURN_NOT_OK(util::ParallelFor(
+      0, vertex_chunk_num,
+      [&](IdType i) -> Status {
+        GAR_ASSIGN_OR_RAISE(
+            auto offset_path,
+            edge_info.GetAdjListOffsetFilePath(i, adj_list_type));
+        std::string path = out_prefix + offset_path;
+        GAR_ASSIGN_OR_RAISE(auto table, fs->ReadFileToTable(path, file_type));
+        GAR_ASSIGN_OR_RAISE(local_offsets[i], GetInt64Array(table->column(0)));
+        IdType length = local_offsets[i]->length();
+        if (length == 0 || (i + 1 < vertex_chunk_num &&
+                            length != vertex_chunk_size + 1)) {
+          return Status::Invalid("The offset chunk " + std::to_string(i) +
+                                 " has an unexpected length " +
+                                 std::to_string(length) + ".");
+        }
+        if (local_offsets[i]->Value(length - 1) > 0) {
+          std::string chunk_dir =
+              out_prefix + adj_list_dir + "/part" + std::to_string(i);
+          GAR_ASSIGN_OR_RAISE(edge_chunk_nums[i],
+                              fs->GetFileNumOfDir(chunk_dir));
+        }
+        return Status::OK();
+      },
+      thread_num));
+
+  IdType vertex_num = 0, edge_num = 0;
+  std::vector<IdType> edge_bases(vertex_chunk_num, 0);
+  for (IdType i = 0; i < vertex_chunk_num; ++i) {
+    const auto& offsets = local_offsets[i];
+    edge_bases[i] = edge_num;
+    vertex_num += offsets->length() - 1;
+    edge_num += offsets->Value(offsets->length() - 1);
+  }
+
+  // the offsets of a single vertex chunk are adopted as they are, otherwise
+  // the local offsets are rebased to the global ones
+  std::shared_ptr<arrow::Int64Array> offsets;
+  if (vertex_chunk_num == 1) {
+    offsets = local_offsets[0];
+  } else {
+    GAR_ASSIGN_OR_RAISE(offsets, AllocateInt64Array(vertex_num + 1));
+    int64_t* data = offsets->data()->GetMutableValues<int64_t>(1);
+    GAR_RETURN_NOT_OK(util::ParallelFor(
+        0, vertex_chunk_num,
+        [&](IdType i) -> Status {
+          const int64_t* local = local_offsets[i]->raw_values();
+          int64_t* out = data + i * vertex_chunk_size;
+          IdType num = local_offsets[i]->length() - 1;
+          for (IdType j = 0; j < num; ++j) {
+            out[j] = local[j] + edge_bases[i];
+          }
+          return Status::OK();
+        },
+        thread_num));
+    data[vertex_num] = edge_num;
+  }
+
+  // the last offset chunk may be padded to the vertex chunk size, so the
+  // offsets are trimmed or extended to the number of vertices
+  GAR_ASSIGN_OR_RAISE(IdType real_vertex_num,
+                      utils::GetVertexNum(prefix, vertex_info));
+  if (real_vertex_num < vertex_num) {
+    if (offsets->Value(real_vertex_num) != edge_num) {
+      return Status::Invalid("The vertices beyond the vertex number " +
+                             std::to_string(real_vertex_num) +
+                             " have edges.");
+    }
+    offsets = std::static_pointer_cast<arrow::Int64Array>(
+        offsets->Slice(0, real_vertex_num + 1));
+  } else if (real_vertex_num > vertex_num) {
+    GAR_ASSIGN_OR_RAISE(auto extended, AllocateInt64Array(real_vertex_num + 1));
+    int64_t* data = extended->data()->GetMutableValues<int64_t>(1);
+    std::memcpy(data, offsets->raw_values(), vertex_num * sizeof(int64_t));
+    std::fill(data + vertex_num, data + real_vertex_num + 1, edge_num);
+    offsets = std::move(extended);
+  }
+
+  // decode the adjList chunks, each of which is copied to its place in the
+  // neighbors directly
+  util::IndexConverter index_converter(std::move(edge_chunk_nums));
+  IdType total_chunk_num = index_converter.GetTotalChunkNum();
+  auto read_neighbors = [&](IdType vertex_chunk_index, IdType edge_chunk_index)
+      -> Result<std::shared_ptr<arrow::ChunkedArray>> {
+    GAR_ASSIGN_OR_RAISE(
+        auto chunk_path,
+        edge_info.GetAdjListFilePath(vertex_chunk_index, edge_chunk_index,
+                                     adj_list_type));
+    GAR_ASSIGN_OR_RAISE(
+        auto table, fs->ReadFileToTable(out_prefix + chunk_path, file_type));
+    auto column = table->GetColumnByName(neighbor_column);
+    if (column == nullptr) {
+      return Status::KeyError("The column " + neighbor_column +
+                              " is not found in " + chunk_path + ".");
+    }
+    if (column->type()->id() != arrow::Type::INT64) {
+      return Status::TypeError("The column type " +
+                               column->type()->ToString() + " is not int64.");
+    }
+    return column;
+  };
+
+  std::shared_ptr<arrow::Int64Array> neighbors;
+  if (total_chunk_num == 1) {
+    auto index_pair = index_converter.GlobalChunkIndexToIndexPair(0);
+    GAR_ASSIGN_OR_RAISE(auto column,
+                        read_neighbors(index_pair.first, index_pair.second));
+    GAR_ASSIGN_OR_RAISE(neighbors, GetInt64Array(column));
+    if (neighbors->length() != edge_num) {
+      return Status::Invalid("The adj list chunk does not match the offsets.");
+    }
+  } else {
+    GAR_ASSIGN_OR_RAISE(neighbors, AllocateInt64Array(edge_num));
+    int64_t* data = neighbors->data()->GetMutableValues<int64_t>(1);
+    GAR_RETURN_NOT_OK(util::ParallelFor(
+        0, total_chunk_num,
+        [&](IdType global_chunk_index) -> Status {
+          auto index_pair =
+              index_converter.GlobalChunkIndexToIndexPair(global_chunk_index);
+          IdType i = index_pair.first;
+          GAR_ASSIGN_OR_RAISE(auto column,
+                              read_neighbors(i, index_pair.second));
+          IdType begin = edge_bases[i] + index_pair.second * edge_chunk_size;
+          IdType end =
+              edge_bases[i] +
+              local_offsets[i]->Value(local_offsets[i]->length() - 1);
+          if (begin + column->length() > end) {
+            return Status::Invalid("The adj list chunk " +
+                                   std::to_string(index_pair.second) +
+                                   " of vertex chunk " + std::to_string(i) +
+                                   " does not match the offsets.");
+          }
+          for (const auto& chunk : column->chunks()) {
+            auto array = std::static_pointer_cast<arrow::Int64Array>(chunk);
+            std::memcpy(data + begin, array->raw_values(),
+                        array->length() * sizeof(int64_t));
+            begin += array->length();
+          }
+          return Status::OK();
+        },
+        thread_num));
+  }
+  return CSR(adj_list_type, std::move(offsets), std::move(neighbors));
+}
+
+Result<CompressedCSR> LoadCompressedCSR(const EdgeInfo& edge_info,
+                                        const VertexInfo& vertex_info,
+                                        const std::string& prefix,
+                                        AdjListType adj_list_type,
+                                        int thread_num) noexcept {
+  IdType vertex_chunk_size;
+  std::string neighbor_column;
+  GAR_RETURN_NOT_OK(GetOrderedAdjListLayout(
+      edge_info, adj_list_type, &vertex_chunk_size, &neighbor_column));
+  std::string out_prefix;
+  GAR_ASSIGN_OR_RAISE(auto fs, FileSystemFromUriOrPath(prefix, &out_prefix));
+  GAR_ASSIGN_OR_RAISE(auto offset_dir,
+                      edge_info.GetAdjListOffsetDirPath(adj_list_type));
+  GAR_ASSIGN_OR_RAISE(IdType vertex_chunk_num,
+                      fs->GetFileNumOfDir(out_prefix + offset_dir));
+
+  // encode each vertex chunk to its own records, the decoded edges of a
+  // vertex chunk are released once it is encoded
+  std::vector<std::vector<uint8_t>> chunk_data(vertex_chunk_num);
+  std::vector<std::vector<uint64_t>> chunk_offsets(vertex_chunk_num);
+  std::vector<IdType> chunk_edge_nums(vertex_chunk_num, 0);
+  GAR_RETURN_NOT_OK(util::ParallelFor(
+      0, vertex_chunk_num,
+      [&](IdType i) -> Status {
+        AdjListOffsetArrowChunkReader offset_reader(edge_info, adj_list_type,
+                                                    prefix);
+        GAR_RETURN_NOT_OK(offset_reader.seek(i * vertex_chunk_size));
+        GAR_ASSIGN_OR_RAISE(auto offset_array, offset_reader.GetChunk());
+        if (offset_array->type_id() != arrow::Type::INT64 ||
+            offset_array->length() == 0) {
+          return Status::Invalid("The offset chunk " + std::to_string(i) +
+                                 " is invalid.");
+        }
+        auto offsets =
+            std::static_pointer_cast<arrow::Int64Array>(offset_array);
+        IdType vertex_num = offsets->length() - 1;
+        IdType edge_num = offsets->Value(vertex_num);
+
+        std::vector<IdType> neighbors;
+        neighbors.reserve(edge_num);
+        if (edge_num > 0) {
+          AdjListArrowChunkReader adj_list_reader(edge_info, adj_list_type,
+                                                  prefix, i);
+          for (IdType k = 0; static_cast<IdType>(neighbors.size()) < edge_num;
+               ++k) {
+            GAR_RETURN_NOT_OK(adj_list_reader.seek_chunk_index(i, k));
+            GAR_ASSIGN_OR_RAISE(auto chunk_table, adj_list_reader.GetChunk());
+            auto column = chunk_table->GetColumnByName(neighbor_column);
+            if (column == nullptr ||
+                column->type()->id() != arrow::Type::INT64) {
+              return Status::Invalid("The column " + neighbor_column +
+                                     " of the adj list chunk is invalid.");
+            }
+            if (chunk_table->num_rows() == 0) {
+              break;
+            }
+            for (const auto& chunk : column->chunks()) {
+              auto array = std::static_pointer_cast<arrow::Int64Array>(chunk);
+              neighbors.insert(neighbors.end(), array->raw_values(),
+                               array->raw_values() + array->length());
+            }
+          }
+        }
+        if (static_cast<IdType>(neighbors.size()) != edge_num) {
+          return Status::Invalid("The adj list chunks of vertex chunk " +
+                                 std::to_string(i) +
+                                 " do not match the offsets.");
+        }
+
+        auto& data = chunk_data[i];
+        auto& record_offsets = chunk_offsets[i];
+        record_offsets.resize(vertex_num);
+        for (IdType v = 0; v < vertex_num; ++v) {
+          record_offsets[v] = data.size();
+          EncodeNeighbors(neighbors.data() + offsets->Value(v),
+                          offsets->Value(v + 1) - offsets->Value(v), &data);
+        }
+        data.shrink_to_fit();
+        chunk_edge_nums[i] = edge_num;
+        return Status::OK();
+      },
+      thread_num));
+
+  // concatenate the records of the vertex chunks
+  IdType vertex_num = 0, edge_num = 0;
+  uint64_t data_size = 0;
+  std::vector<IdType> vertex_bases(vertex_chunk_num);
+  std::vector<uint64_t> data_bases(vertex_chunk_num);
+  for (IdType i = 0; i < vertex_chunk_num; ++i) {
+    vertex_bases[i] = vertex_num;
+    data_bases[i] = data_size;
+    vertex_num += static_cast<IdType>(chunk_offsets[i].size());
+    edge_num += chunk_edge_nums[i];
+    data_size += chunk_data[i].size();
+  }
+  std::vector<uint64_t> offsets(vertex_num + 1);
+  // padded for the 8-byte loads of the packed gaps
+  std::vector<uint8_t> data(data_size + sizeof(uint64_t), 0);
+  GAR_RETURN_NOT_OK(util::ParallelFor(
+      0, vertex_chunk_num,
+      [&](IdType i) -> Status {
+        for (size_t v = 0; v < chunk_offsets[i].size(); ++v) {
+          offsets[vertex_bases[i] + v] = chunk_offsets[i][v] + data_bases[i];
+        }
+        std::memcpy(data.data() + data_bases[i], chunk_data[i].data(),
+                    chunk_data[i].size());
+        std::vector<uint8_t>().swap(chunk_data[i]);
+        return Status::OK();
+      },
+      thread_num));
+  offsets[vertex_num] = data_size;
+
+  // the records are trimmed or extended to the number of vertices as the
+  // offsets of LoadCSR, a vertex without edges has a single byte record
+  GAR_ASSIGN_OR_RAISE(IdType real_vertex_num,
+                      utils::GetVertexNum(prefix, vertex_info));
+  if (real_vertex_num < vertex_num) {
+    if (data_size - offsets[real_vertex_num] !=
+        static_cast<uint64_t>(vertex_num - real_vertex_num)) {
+      return Status::Invalid("The vertices beyond the vertex number " +
+                             std::to_string(real_vertex_num) +
+                             " have edges.");
+    }
+    data_size = offsets[real_vertex_num];
+    offsets.resize(real_vertex_num + 1);
+    data.resize(data_size + sizeof(uint64_t));
+    std::fill(data.begin() + data_size, data.end(), 0);
+  } else if (real_vertex_num > vertex_num) {
+    offsets.resize(real_vertex_num + 1);
+    for (IdType v = vertex_num + 1; v <= real_vertex_num; ++v) {
+      offsets[v] = offsets[v - 1] + 1;
+    }
+    data_size = offsets[real_vertex_num];
+    data.resize(data_size + sizeof(uint64_t), 0);
+  }
+  data.shrink_to_fit();
+  return CompressedCSR(adj_list_type, edge_num, std::move(offsets),
+                       std::move(data));
+}
+
+Result<std::shared_ptr<arrow::Int64Array>> ComputeDegrees(
+    const EdgeInfo& edge_info, const VertexInfo& vertex_info,
+    const std::string& prefix, AdjListType adj_list_type,
+    int thread_num) noexcept {
+  if (!edge_info.ContainAdjList(adj_list_type)) {
+    return Status::KeyError(
+        "The adj list type " + std::string(AdjListTypeToString(adj_list_type)) +
+        " is not found in the edge info.");
+  }
+  bool by_source = adj_list_type == AdjListType::ordered_by_source ||
+                   adj_list_type == AdjListType::unordered_by_source;
+  IdType vertex_chunk_size =
+      by_source ? edge_info.GetSrcChunkSize() : edge_info.GetDstChunkSize();
+  GAR_ASSIGN_OR_RAISE(IdType vertex_num,
+                      utils::GetVertexNum(prefix, vertex_info));
+  std::string out_prefix;
+  GAR_ASSIGN_OR_RAISE(auto fs, FileSystemFromUriOrPath(prefix, &out_prefix));
+  GAR_ASSIGN_OR_RAISE(auto file_type,
+                      edge_info.GetAdjListFileType(adj_list_type));
+  bool ordered = adj_list_type == AdjListType::ordered_by_source ||
+                 adj_list_type == AdjListType::ordered_by_dest;
+  std::string vertex_column =
+      by_source ? GeneralParams::kSrcIndexCol : GeneralParams::kDstIndexCol;
+  GAR_ASSIGN_OR_RAISE(auto dir,
+                      ordered ? edge_info.GetAdjListOffsetDirPath(adj_list_type)
+                              : edge_info.GetAdjListDirPath(adj_list_type));
+  GAR_ASSIGN_OR_RAISE(IdType vertex_chunk_num,
+                      fs->GetFileNumOfDir(out_prefix + dir));
+
+  // the degrees of a vertex chunk are written by the thread of the chunk,
+  // the vertices without any chunk have no edges
+  GAR_ASSIGN_OR_RAISE(auto degrees, AllocateInt64Array(vertex_num));
+  int64_t* degree_data = degrees->data()->GetMutableValues<int64_t>(1);
+  std::fill(degree_data, degree_data + vertex_num, 0);
+  // the degrees of the vertices in [begin, begin + length) of a vertex chunk,
+  // which must be zero beyond the number of vertices
+  auto store = [&](IdType i, IdType begin, IdType length,
+                   const int64_t* local) -> Status {
+    for (IdType j = 0; j < length; ++j) {
+      if (begin + j < vertex_num) {
+        degree_data[begin + j] = local[j];
+      } else if (local[j] != 0) {
+        return Status::Invalid("The vertex " + std::to_string(begin + j) +
+                               " of the vertex chunk " + std::to_string(i) +
+                               " is beyond the vertex number " +
+                               std::to_string(vertex_num) + ".");
+      }
+    }
+    return Status::OK();
+  };
+
+  GAR_RETURN_NOT_OK(util::ParallelFor(
+      0, vertex_chunk_num,
+      [&](IdType i) -> Status {
+        IdType begin = i * vertex_chunk_size;
+        std::vector<int64_t> local;
+        if (ordered) {
+          GAR_ASSIGN_OR_RAISE(
+              auto offset_path,
+              edge_info.GetAdjListOffsetFilePath(i, adj_list_type));
+          GAR_ASSIGN_OR_RAISE(
+              auto table,
+              fs->ReadFileToTable(out_prefix + offset_path, file_type));
+          GAR_ASSIGN_OR_RAISE(auto offsets, GetInt64Array(table->column(0)));
+          if (offsets->length() == 0) {
+            return Status::Invalid("The offset chunk " + std::to_string(i) +
+                                   " is empty.");
+          }
+          // a plain differencing loop, which the compiler vectorizes
+          const int64_t* data = offsets->raw_values();
+          local.resize(offsets->length() - 1);
+          for (size_t j = 0; j < local.size(); ++j) {
+            local[j] = data[j + 1] - data[j];
+          }
+          return store(i, begin, local.size(), local.data());
+        }
+
+        // the unordered adj list has no offsets, so the vertices of its
+        // edge chunks are counted
+        std::string chunk_dir = out_prefix + dir + "/part" + std::to_string(i);
+        GAR_ASSIGN_OR_RAISE(IdType chunk_num, fs->GetFileNumOfDir(chunk_dir));
+        local.assign(vertex_chunk_size, 0);
+        for (IdType j = 0; j < chunk_num; ++j) {
+          GAR_ASSIGN_OR_RAISE(
+              auto chunk_path,
+              edge_info.GetAdjListFilePath(i, j, adj_list_type));
+          GAR_ASSIGN_OR_RAISE(
+              auto table, fs->ReadFileToTable(out_prefix + chunk_path,
+                                              file_type, {vertex_column}));
+          GAR_ASSIGN_OR_RAISE(auto vertices, GetInt64Array(table->column(0)));
+          const int64_t* data = vertices->raw_values();
+          for (int64_t k = 0; k < vertices->length(); ++k) {
+            IdType offset = data[k] - begin;
+            if (offset < 0 || offset >= vertex_chunk_size) {
+              return Status::Invalid("The vertex " + std::to_string(data[k]) +
+                                     " is not in the vertex chunk " +
+                                     std::to_string(i) + ".");
+            }
+            ++local[offset];
+          }
+        }
+        return store(i, begin, vertex_chunk_size, local.data());
+      },
+      thread_num));
+  return degrees;
+}
+
+}  // namespace GAR_NAMESPACE_INTERNAL
@@ -13,142 +13,514 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "arrow/compute/api.h"
+#include "arrow/io/api.h"
+#include "arrow/ipc/api.h"
+
 #include "gar/writer/edges_builder.h"
 #include "gar/utils/convert_to_arrow_type.h"
 #include "gar/utils/general_params.h"
+#include "gar/utils/utils.h"
 
 namespace GAR_NAMESPACE_INTERNAL {
 namespace builder {
 
-Status EdgesBuilder::appendToArray(
-    const DataType& type, const std::string& property_name,
-    std::shared_ptr<arrow::Array>& array,  // NOLINT
-    const std::vector<Edge>& edges) {
-  switch (type.id()) {
-  case Type::BOOL:
-    return tryToAppend<Type::BOOL>(property_name, array, edges);
-  case Type::INT32:
-    return tryToAppend<Type::INT32>(property_name, array, edges);
-  case Type::INT64:
-    return tryToAppend<Type::INT64>(property_name, array, edges);
-  case Type::FLOAT:
-    return tryToAppend<Type::FLOAT>(property_name, array, edges);
-  case Type::DOUBLE:
-    return tryToAppend<Type::DOUBLE>(property_name, array, edges);
-  case Type::STRING:
-    return tryToAppend<Type::STRING>(property_name, array, edges);
-  default:
-    return Status::TypeError();
-  }
-  return Status::TypeError();
+namespace {
+
+/// The size of the buffers of an array, which are shared by its slices.
+int64_t BufferSize(const std::shared_ptr<arrow::Array>& array) {
+  int64_t size = 0;
+  for (const auto& buffer : array->data()->buffers) {
+    if (buffer != nullptr) {
+      size += buffer->size();
+    }
+  }
+  return size;
 }
 
-template <Type type>
-Status EdgesBuilder::tryToAppend(
-    const std::string& property_name,
-    std::shared_ptr<arrow::Array>& array,  // NOLINT
-    const std::vector<Edge>& edges) {
-  using CType = typename ConvertToArrowType<type>::CType;
-  arrow::MemoryPool* pool = arrow::default_memory_pool();
-  typename ConvertToArrowType<type>::BuilderType builder(pool);
-  for (const auto& e : edges) {
-    if (e.Empty() || (!e.ContainProperty(property_name))) {
-      auto status = builder.AppendNull();
-      if (!status.ok())
-        return Status::ArrowError(status.ToString());
-    } else {
-      auto status =
-          builder.Append(std::any_cast<CType>(e.GetProperty(property_name)));
-      if (!status.ok())
-        return Status::ArrowError(status.ToString());
-    }
-  }
-  array = builder.Finish().ValueOrDie();
+}  // namespace
+
+EdgesBuilder::~EdgesBuilder() { removeRuns(); }
+
+void EdgesBuilder::initColumns() {
+  std::vector<std::shared_ptr<arrow::Field>> fields;
+  fields.push_back(arrow::field(GeneralParams::kSrcIndexCol, arrow::int64()));
+  fields.push_back(arrow::field(GeneralParams::kDstIndexCol, arrow::int64()));
+  types_ = {DataType(Type::INT64), DataType(Type::INT64)};
+  auto maybe_property_groups = edge_info_.GetPropertyGroups(adj_list_type_);
+  if (maybe_property_groups.status().ok()) {
+    for (const auto& property_group : maybe_property_groups.value()) {
+      for (const auto& property : property_group.GetProperties()) {
+        fields.push_back(arrow::field(
+            property.name, DataType::DataTypeToArrowDataType(property.type)));
+        types_.push_back(property.type);
+      }
+    }
+  }
+  schema_ = arrow::schema(fields);
+  row_bytes_ = 0;
+  for (size_t i = 0; i < types_.size(); ++i) {
+    column_indices_[fields[i]->name()] = i;
+    // the builder of an unsupported type stays null, which fails the adding
+    std::unique_ptr<arrow::ArrayBuilder> builder;
+    Status status = VisitType(types_[i], [&](auto t) -> Status {
+      using T = decltype(t);
+      builder = std::make_unique<typename T::BuilderType>();
+      // a string costs its offset, and its characters as they are added
+      row_bytes_ += std::is_same<typename T::CType, std::string>::value
+                        ? sizeof(int32_t)
+                        : sizeof(typename T::CType);
+      return Status::OK();
+    });
+    builders_.push_back(status.ok() ? std::move(builder) : nullptr);
+  }
+  columns_.resize(types_.size());
+}
+
+Status EdgesBuilder::finishBuilders() {
+  for (size_t i = 0; i < builders_.size(); ++i) {
+    if (builders_[i] == nullptr) {
+      return Status::TypeError("Unsupported data type " +
+                               types_[i].ToTypeName() + " of " +
+                               schema_->field(i)->name() + ".");
+    }
+    if (builders_[i]->length() > 0) {
+      std::shared_ptr<arrow::Array> array;
+      RETURN_NOT_ARROW_OK(builders_[i]->Finish(&array));
+      columns_[i].push_back(std::move(array));
+    }
+  }
   return Status::OK();
 }
 
-Status EdgesBuilder::tryToAppend(
-    int src_or_dest,
-    std::shared_ptr<arrow::Array>& array,  // NOLINT
-    const std::vector<Edge>& edges) {
-  arrow::MemoryPool* pool = arrow::default_memory_pool();
-  typename arrow::TypeTraits<arrow::Int64Type>::BuilderType builder(pool);
-  for (const auto& e : edges) {
-    auto status = builder.Append(std::any_cast<int64_t>(
-        src_or_dest == 1 ? e.GetSource() : e.GetDestination()));
-    if (!status.ok())
-      return Status::ArrowError(status.ToString());
-  }
-  array = builder.Finish().ValueOrDie();
+Status EdgesBuilder::AddEdge(const Edge& e) {
+  // validate
+  GAR_RETURN_NOT_OK(Validate(e));
+  // check the types first, so that a failed edge is not partially appended
+  for (size_t i = 0; i < builders_.size(); ++i) {
+    if (builders_[i] == nullptr) {
+      return Status::TypeError("Unsupported data type " +
+                               types_[i].ToTypeName() + " of " +
+                               schema_->field(i)->name() + ".");
+    }
+  }
+  for (const auto& property : e.GetProperties()) {
+    // the properties of the other adj list types are not written
+    auto it = column_indices_.find(property.first);
+    if (it == column_indices_.end()) {
+      continue;
+    }
+    const auto& type = types_[it->second];
+    GAR_RETURN_NOT_OK(VisitType(type, [&](auto t) -> Status {
+      if (property.second.type() != typeid(typename decltype(t)::CType)) {
+        return Status::TypeError("The value of " + property.first +
+                                 " is not of type " + type.ToTypeName() + ".");
+      }
+      return Status::OK();
+    }));
+  }
+  // add an edge
+  RETURN_NOT_ARROW_OK(static_cast<arrow::Int64Builder*>(builders_[0].get())
+                          ->Append(e.GetSource()));
+  RETURN_NOT_ARROW_OK(static_cast<arrow::Int64Builder*>(builders_[1].get())
+                          ->Append(e.GetDestination()));
+  for (size_t i = 2; i < builders_.size(); ++i) {
+    const auto& name = schema_->field(i)->name();
+    if (!e.ContainProperty(name)) {
+      RETURN_NOT_ARROW_OK(builders_[i]->AppendNull());
+      continue;
+    }
+    GAR_RETURN_NOT_OK(VisitType(types_[i], [&](auto t) -> Status {
+      using T = decltype(t);
+      const auto& value =
+          std::any_cast<const typename T::CType&>(e.GetProperty(name));
+      RETURN_NOT_ARROW_OK(
+          static_cast<typename T::BuilderType*>(builders_[i].get())
+              ->Append(value));
+      if constexpr (std::is_same<typename T::CType, std::string>::value) {
+        buffered_bytes_ += value.size();
+      }
+      return Status::OK();
+    }));
+  }
+  num_edges_++;
+  buffered_bytes_ += row_bytes_;
+  if (memory_budget_ > 0 && buffered_bytes_ > memory_budget_) {
+    return spill();
+  }
   return Status::OK();
 }
 
-Result<std::shared_ptr<arrow::Table>> EdgesBuilder::convertToTable(
-    const std::vector<Edge>& edges) {
-  GAR_ASSIGN_OR_RAISE(auto& property_groups,
-                      edge_info_.GetPropertyGroups(adj_list_type_));
-  std::vector<std::shared_ptr<arrow::Array>> arrays;
-  std::vector<std::shared_ptr<arrow::Field>> schema_vector;
-  // add src
-  std::shared_ptr<arrow::Array> array;
-  schema_vector.push_back(
-      arrow::field(GeneralParams::kSrcIndexCol,
-                   DataType::DataTypeToArrowDataType(DataType(Type::INT64))));
-  GAR_RETURN_NOT_OK(tryToAppend(1, array, edges));
-  arrays.push_back(array);
-  // add dst
-  schema_vector.push_back(
-      arrow::field(GeneralParams::kDstIndexCol,
-                   DataType::DataTypeToArrowDataType(DataType(Type::INT64))));
-  GAR_RETURN_NOT_OK(tryToAppend(0, array, edges));
-  arrays.push_back(array);
-  // add properties
-  for (auto& property_group : property_groups) {
-    for (auto& property : property_group.GetProperties()) {
-      // add a column to schema
-      schema_vector.push_back(arrow::field(
-          property.name, DataType::DataTypeToArrowDataType(property.type)));
-      // add a column to data
-      std::shared_ptr<arrow::Array> array;
-      GAR_RETURN_NOT_OK(
-          appendToArray(property.type, property.name, array, edges));
-      arrays.push_back(array);
+Status EdgesBuilder::AddEdges(const std::shared_ptr<arrow::Table>& table) {
+  // can not add new edges
+  if (is_saved_) {
+    return Status::InvalidOperation("can not add new edges after dumping");
+  }
+  // invalid adj list type
+  if (!edge_info_.ContainAdjList(adj_list_type_)) {
+    return Status::InvalidOperation("invalid adj list type");
+  }
+  // match the columns of the table
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> columns(types_.size());
+  for (int i = 0; i < table->num_columns(); ++i) {
+    const auto& name = table->field(i)->name();
+    auto it = column_indices_.find(name);
+    if (it == column_indices_.end()) {
+      return Status::InvalidOperation("invalid property " + name);
+    }
+    const auto& type = schema_->field(it->second)->type();
+    if (!table->column(i)->type()->Equals(type)) {
+      return Status::TypeError("The column " + name + " of type " +
+                               table->column(i)->type()->ToString() +
+                               " does not match " + type->ToString() + ".");
+    }
+    columns[it->second] = table->column(i);
+  }
+  if (columns[0] == nullptr || columns[1] == nullptr) {
+    return Status::Invalid("The table must contain the columns " +
+                           std::string(GeneralParams::kSrcIndexCol) +
+                           " and " + GeneralParams::kDstIndexCol + ".");
+  }
+  if (columns[0]->null_count() > 0 || columns[1]->null_count() > 0) {
+    return Status::Invalid("The sources and destinations must not be null.");
+  }
+  // keep the order of the edges added one by one before
+  GAR_RETURN_NOT_OK(finishBuilders());
+  for (size_t i = 0; i < columns.size(); ++i) {
+    if (columns[i] != nullptr) {
+      for (const auto& chunk : columns[i]->chunks()) {
+        buffered_bytes_ += BufferSize(chunk);
+        columns_[i].push_back(chunk);
+      }
+    } else if (table->num_rows() > 0) {
+      GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+          auto nulls, arrow::MakeArrayOfNull(schema_->field(i)->type(),
+                                             table->num_rows()));
+      buffered_bytes_ += BufferSize(nulls);
+      columns_[i].push_back(std::move(nulls));
+    }
+  }
+  num_edges_ += table->num_rows();
+  if (memory_budget_ > 0 && buffered_bytes_ > memory_budget_) {
+    return spill();
+  }
+  return Status::OK();
+}
+
+Status EdgesBuilder::AddEdges(
+    const std::shared_ptr<arrow::RecordBatch>& batch) {
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      auto table, arrow::Table::FromRecordBatches({batch}));
+  return AddEdges(table);
+}
+
+Result<EdgesBuilder::SortedEdges> EdgesBuilder::sortEdges(int thread_num) {
+  bool by_source = adj_list_type_ == AdjListType::ordered_by_source ||
+                   adj_list_type_ == AdjListType::unordered_by_source;
+  bool ordered = adj_list_type_ == AdjListType::ordered_by_source ||
+                 adj_list_type_ == AdjListType::ordered_by_dest;
+
+  // the vertex chunk of an edge is decided by its source or destination
+  std::vector<IdType> vertices;
+  for (const auto& array : columns_[by_source ? 0 : 1]) {
+    const int64_t* values =
+        std::static_pointer_cast<arrow::Int64Array>(array)->raw_values();
+    vertices.insert(vertices.end(), values, values + array->length());
+  }
+  IdType num_vertex_chunks = 0;
+  for (auto vid : vertices) {
+    if (vid < 0) {
+      return Status::Invalid("The vertex id " + std::to_string(vid) +
+                             " is negative.");
     }
+    num_vertex_chunks =
+        std::max(num_vertex_chunks, vid / vertex_chunk_size_ + 1);
   }
-  auto schema = std::make_shared<arrow::Schema>(schema_vector);
-  return arrow::Table::Make(schema, arrays);
+
+  // group the edges by vertex chunk with a counting sort, and sort the edges
+  // of each vertex chunk for the ordered adj list
+  SortedEdges sorted;
+  auto& chunk_begins = sorted.chunk_begins;
+  chunk_begins.assign(num_vertex_chunks + 1, 0);
+  for (auto vid : vertices) {
+    ++chunk_begins[vid / vertex_chunk_size_ + 1];
+  }
+  for (IdType i = 0; i < num_vertex_chunks; ++i) {
+    chunk_begins[i + 1] += chunk_begins[i];
+  }
+  std::vector<int64_t> order(vertices.size());
+  {
+    std::vector<IdType> positions(chunk_begins.begin(),
+                                  chunk_begins.end() - 1);
+    for (size_t i = 0; i < vertices.size(); ++i) {
+      order[positions[vertices[i] / vertex_chunk_size_]++] = i;
+    }
+  }
+  if (ordered) {
+    GAR_RETURN_NOT_OK(util::ParallelFor(
+        0, num_vertex_chunks,
+        [&](IdType i) -> Status {
+          std::stable_sort(order.begin() + chunk_begins[i],
+                           order.begin() + chunk_begins[i + 1],
+                           [&vertices](int64_t a, int64_t b) {
+                             return vertices[a] < vertices[b];
+                           });
+          return Status::OK();
+        },
+        thread_num));
+    sorted.vertices.resize(order.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+      sorted.vertices[i] = vertices[order[i]];
+    }
+  }
+  IdType num_rows = vertices.size();
+  std::vector<IdType>().swap(vertices);
+  if (num_rows == 0) {
+    // nothing is buffered, e.g., the last edges added were spilled
+    for (auto& column : columns_) {
+      column.clear();
+    }
+    buffered_bytes_ = 0;
+    return sorted;
+  }
+
+  // permute the columns once, then each vertex chunk is a slice of them
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> chunked_arrays;
+  for (size_t i = 0; i < columns_.size(); ++i) {
+    chunked_arrays.push_back(std::make_shared<arrow::ChunkedArray>(
+        std::move(columns_[i]), schema_->field(i)->type()));
+    columns_[i].clear();
+  }
+  buffered_bytes_ = 0;
+  auto table = arrow::Table::Make(schema_, chunked_arrays, num_rows);
+  chunked_arrays.clear();
+  arrow::Int64Builder order_builder;
+  RETURN_NOT_ARROW_OK(order_builder.AppendValues(order));
+  std::vector<int64_t>().swap(order);
+  std::shared_ptr<arrow::Int64Array> indices;
+  RETURN_NOT_ARROW_OK(order_builder.Finish(&indices));
+  GAR_ASSIGN_OR_RAISE(sorted.table,
+                      util::TakeTable(table, indices, thread_num));
+  return sorted;
+}
+
+Status EdgesBuilder::spill() {
+  GAR_RETURN_NOT_OK(finishBuilders());
+  GAR_ASSIGN_OR_RAISE(auto sorted, sortEdges(1));
+  // the run is recorded first, so that its file is removed on failure
+  runs_.push_back(SpilledRun());
+  auto& run = runs_.back();
+  run.path = spill_dir_ + "/edges_builder_run_" +
+             std::to_string(std::random_device()()) + "_" +
+             std::to_string(runs_.size()) + ".arrow";
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      auto output, arrow::io::FileOutputStream::Open(run.path));
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      auto writer, arrow::ipc::MakeFileWriter(output, schema_));
+  const auto& chunk_begins = sorted.chunk_begins;
+  for (size_t i = 0; i + 1 < chunk_begins.size(); ++i) {
+    IdType begin = chunk_begins[i], num = chunk_begins[i + 1] - begin;
+    if (num == 0) {
+      continue;
+    }
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        auto batch, sorted.table->Slice(begin, num)->CombineChunksToBatch());
+    RETURN_NOT_ARROW_OK(writer->WriteRecordBatch(*batch));
+    run.chunk_indices.push_back(i);
+  }
+  RETURN_NOT_ARROW_OK(writer->Close());
+  RETURN_NOT_ARROW_OK(output->Close());
+  return Status::OK();
+}
+
+Result<std::shared_ptr<arrow::Table>> EdgesBuilder::mergePieces(
+    const std::vector<std::shared_ptr<arrow::Table>>& pieces,
+    const std::vector<const IdType*>& vertices,
+    std::vector<IdType>* merged_vertices) const {
+  bool ordered = adj_list_type_ == AdjListType::ordered_by_source ||
+                 adj_list_type_ == AdjListType::ordered_by_dest;
+  merged_vertices->clear();
+  if (pieces.size() == 1) {
+    if (ordered) {
+      merged_vertices->assign(vertices[0],
+                              vertices[0] + pieces[0]->num_rows());
+    }
+    return pieces[0];
+  }
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto table,
+                                       arrow::ConcatenateTables(pieces));
+  if (!ordered) {
+    return table;
+  }
+
+  // k-way merge of the sorted pieces, the ties are broken by the order of
+  // the pieces to keep the order the edges are added
+  std::vector<IdType> piece_begins(pieces.size() + 1, 0);
+  for (size_t p = 0; p < pieces.size(); ++p) {
+    piece_begins[p + 1] = piece_begins[p] + pieces[p]->num_rows();
+  }
+  using Entry = std::pair<IdType, size_t>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+  std::vector<IdType> cursors(pieces.size(), 0);
+  for (size_t p = 0; p < pieces.size(); ++p) {
+    if (pieces[p]->num_rows() > 0) {
+      heap.emplace(vertices[p][0], p);
+    }
+  }
+  arrow::Int64Builder order_builder;
+  RETURN_NOT_ARROW_OK(order_builder.Reserve(table->num_rows()));
+  merged_vertices->reserve(table->num_rows());
+  while (!heap.empty()) {
+    auto [vid, p] = heap.top();
+    heap.pop();
+    order_builder.UnsafeAppend(piece_begins[p] + cursors[p]);
+    merged_vertices->push_back(vid);
+    if (++cursors[p] < pieces[p]->num_rows()) {
+      heap.emplace(vertices[p][cursors[p]], p);
+    }
+  }
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto indices, order_builder.Finish());
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto datum,
+                                       arrow::compute::Take(table, indices));
+  return datum.table();
+}
+
+void EdgesBuilder::removeRuns() {
+  for (const auto& run : runs_) {
+    std::remove(run.path.c_str());
+  }
+  runs_.clear();
+}
+
+Status EdgesBuilder::Dump(int thread_num) {
+  GAR_RETURN_NOT_OK(finishBuilders());
+  GAR_ASSIGN_OR_RAISE(auto sorted, sortEdges(thread_num));
+  // construct the writer
+  EdgeChunkWriter writer(edge_info_, prefix_, adj_list_type_);
+  bool by_source = adj_list_type_ == AdjListType::ordered_by_source ||
+                   adj_list_type_ == AdjListType::unordered_by_source;
+  bool ordered = adj_list_type_ == AdjListType::ordered_by_source ||
+                 adj_list_type_ == AdjListType::ordered_by_dest;
+
+  // the empty vertex chunks are written if the number of vertices is given
+  IdType num_written_chunks = 0;
+  if (num_vertices_ != -1) {
+    num_written_chunks =
+        (num_vertices_ + vertex_chunk_size_ - 1) / vertex_chunk_size_;
+  }
+  IdType num_vertex_chunks = std::max(
+      num_written_chunks, static_cast<IdType>(sorted.chunk_begins.size()) - 1);
+  std::vector<std::shared_ptr<arrow::ipc::RecordBatchFileReader>> readers;
+  for (const auto& run : runs_) {
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        auto input, arrow::io::ReadableFile::Open(run.path));
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        auto reader, arrow::ipc::RecordBatchFileReader::Open(input));
+    readers.push_back(std::move(reader));
+    if (!run.chunk_indices.empty()) {
+      num_vertex_chunks =
+          std::max(num_vertex_chunks, run.chunk_indices.back() + 1);
+    }
+  }
+  // the record batches of the runs of each vertex chunk
+  std::vector<std::vector<std::pair<size_t, int>>> run_batches(
+      num_vertex_chunks);
+  for (size_t r = 0; r < runs_.size(); ++r) {
+    const auto& chunk_indices = runs_[r].chunk_indices;
+    for (size_t b = 0; b < chunk_indices.size(); ++b) {
+      run_batches[chunk_indices[b]].emplace_back(r, static_cast<int>(b));
+    }
+  }
+  // a run file reader is not safe to read from concurrently
+  std::vector<std::mutex> reader_mutexes(readers.size());
+
+  // write each vertex chunk, merged from the runs and the memory, by
+  // multiple threads, one vertex chunk at a time per thread
+  GAR_RETURN_NOT_OK(util::ParallelFor(
+      0, num_vertex_chunks,
+      [&](IdType i) -> Status {
+        std::vector<std::shared_ptr<arrow::Table>> pieces;
+        std::vector<const IdType*> vertices;
+        for (const auto& run_batch : run_batches[i]) {
+          std::shared_ptr<arrow::RecordBatch> batch;
+          {
+            std::lock_guard<std::mutex> lock(reader_mutexes[run_batch.first]);
+            GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+                batch,
+                readers[run_batch.first]->ReadRecordBatch(run_batch.second));
+          }
+          vertices.push_back(std::static_pointer_cast<arrow::Int64Array>(
+                                 batch->column(by_source ? 0 : 1))
+                                 ->raw_values());
+          GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+              auto piece, arrow::Table::FromRecordBatches({batch}));
+          pieces.push_back(std::move(piece));
+        }
+        if (i + 1 < static_cast<IdType>(sorted.chunk_begins.size())) {
+          IdType begin = sorted.chunk_begins[i],
+                 num = sorted.chunk_begins[i + 1] - begin;
+          if (num > 0) {
+            pieces.push_back(sorted.table->Slice(begin, num));
+            vertices.push_back(ordered ? sorted.vertices.data() + begin
+                                       : nullptr);
+          }
+        }
+        if (pieces.empty() && i >= num_written_chunks) {
+          return Status::OK();
+        }
+        std::shared_ptr<arrow::Table> chunk_table;
+        std::vector<IdType> merged_vertices;
+        if (!pieces.empty()) {
+          GAR_ASSIGN_OR_RAISE(chunk_table,
+                              mergePieces(pieces, vertices, &merged_vertices));
+        }
+        // dump the offsets
+        if (ordered) {
+          GAR_ASSIGN_OR_RAISE(auto offset_table,
+                              getOffsetTable(i, merged_vertices.data(),
+                                             merged_vertices.size()));
+          GAR_RETURN_NOT_OK(writer.WriteOffsetChunk(offset_table, i));
+        }
+        // dump the edges
+        if (chunk_table != nullptr) {
+          GAR_RETURN_NOT_OK(writer.WriteTable(chunk_table, i, 0));
+        }
+        return Status::OK();
+      },
+      thread_num));
+  readers.clear();
+  removeRuns();
+  is_saved_ = true;
+  return Status::OK();
 }
 
 Result<std::shared_ptr<arrow::Table>> EdgesBuilder::getOffsetTable(
-    IdType vertex_chunk_index, const std::vector<Edge>& edges) {
-  arrow::Int64Builder builder;
-  IdType begin_index = vertex_chunk_index * vertex_chunk_size_,
-         end_index = begin_index + vertex_chunk_size_;
-  RETURN_NOT_ARROW_OK(builder.Append(0));
-
-  std::vector<std::shared_ptr<arrow::Array>> arrays;
-  std::vector<std::shared_ptr<arrow::Field>> schema_vector;
-  schema_vector.push_back(
-      arrow::field(GeneralParams::kOffsetCol,
-                   DataType::DataTypeToArrowDataType(DataType(Type::INT64))));
-
-  size_t index = 0;
-  for (IdType i = begin_index; i < end_index; i++) {
-    while (index < edges.size()) {
-      int64_t x = (adj_list_type_ == AdjListType::ordered_by_source
-                       ? edges[index].GetSource()
-                       : edges[index].GetDestination());
-      if (x <= i)
-        index++;
-      else
-        break;
-    }
-    RETURN_NOT_ARROW_OK(builder.Append(index));
-  }
-  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto array, builder.Finish());
-  arrays.push_back(array);
-  auto schema = std::make_shared<arrow::Schema>(schema_vector);
-  return arrow::Table::Make(schema, arrays);
+    IdType vertex_chunk_index, const IdType* vertices, IdType num) const {
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      std::shared_ptr<arrow::Buffer> buffer,
+      arrow::AllocateBuffer((vertex_chunk_size_ + 1) * sizeof(int64_t)));
+  util::ComputeOffsets(vertices, num, vertex_chunk_index * vertex_chunk_size_,
+                       vertex_chunk_size_,
+                       reinterpret_cast<int64_t*>(buffer->mutable_data()));
+  auto array =
+      std::make_shared<arrow::Int64Array>(vertex_chunk_size_ + 1, buffer);
+  auto schema = arrow::schema({arrow::field(
+      GeneralParams::kOffsetCol,
+      DataType::DataTypeToArrowDataType(DataType(Type::INT64)))});
+  return arrow::Table::Make(schema, {array});
 }
 
 }  // namespace builder
@@ -67,6 +67,59 @@ Result<std::shared_ptr<arrow::Table>> FileSystem::ReadFileToTable(
   return table;
 }
 
+Result<std::shared_ptr<arrow::Table>> FileSystem::ReadFileToTable(
+    const std::string& path, FileType file_type,
+    const std::vector<std::string>& columns) const noexcept {
+  arrow::MemoryPool* pool = arrow::default_memory_pool();
+  std::shared_ptr<arrow::Table> table;
+  switch (file_type) {
+  case FileType::CSV: {
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto is,
+                                         arrow_fs_->OpenInputStream(path));
+    auto read_options = arrow::csv::ReadOptions::Defaults();
+    auto parse_options = arrow::csv::ParseOptions::Defaults();
+    auto convert_options = arrow::csv::ConvertOptions::Defaults();
+    convert_options.include_columns = columns;
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        auto reader, arrow::csv::TableReader::Make(
+                         arrow::io::IOContext(pool), is, read_options,
+                         parse_options, convert_options));
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(table, reader->Read());
+    break;
+  }
+  case FileType::PARQUET: {
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto input,
+                                         arrow_fs_->OpenInputFile(path));
+    std::unique_ptr<parquet::arrow::FileReader> reader;
+    RETURN_NOT_ARROW_OK(parquet::arrow::OpenFile(input, pool, &reader));
+    std::shared_ptr<arrow::Schema> schema;
+    RETURN_NOT_ARROW_OK(reader->GetSchema(&schema));
+    std::vector<int> indices;
+    for (const auto& column : columns) {
+      int index = schema->GetFieldIndex(column);
+      if (index < 0) {
+        return Status::KeyError("The column " + column + " is not found in " +
+                                path + ".");
+      }
+      indices.push_back(index);
+    }
+    RETURN_NOT_ARROW_OK(reader->ReadTable(indices, &table));
+    break;
+  }
+  case FileType::ORC: {
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto input,
+                                         arrow_fs_->OpenInputFile(path));
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        auto reader, arrow::adapters::orc::ORCFileReader::Open(input, pool));
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(table, reader->Read(columns));
+    break;
+  }
+  default:
+    return Status::Invalid("File type is invalid.");
+  }
+  return table;
+}
+
 template <typename T>
 Result<T> FileSystem::ReadFileToValue(const std::string& path) const noexcept {
   T ret;
@@ -158,6 +211,15 @@ Status FileSystem::WriteTableToFile(const std::shared_ptr<arrow::Table>& table,
   return Status::OK();
 }
 
+Result<std::shared_ptr<arrow::io::OutputStream>> FileSystem::OpenOutputStream(
+    const std::string& path) const noexcept {
+  RETURN_NOT_ARROW_OK(
+      arrow_fs_->CreateDir(path.substr(0, path.find_last_of("/"))));
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto output_stream,
+                                       arrow_fs_->OpenOutputStream(path));
+  return output_stream;
+}
+
 Status FileSystem::CopyFile(const std::string& src_path,
                             const std::string& dst_path) const noexcept {
   RETURN_NOT_ARROW_OK(
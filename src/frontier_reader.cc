@@ -0,0 +1,171 @@
+/** Copyright 2022 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "arrow/api.h"
+
+#include "gar/reader/frontier_reader.h"
+#include "gar/utils/filesystem.h"
+#include "gar/utils/general_params.h"
+#include "gar/utils/property_column.h"
+
+namespace GAR_NAMESPACE_INTERNAL {
+
+namespace {
+
+/// An adjList chunk to read, and the edge ranges of the active vertices in
+/// it for the ordered adjList types.
+struct ChunkTask {
+  IdType vertex_chunk_index;
+  IdType edge_chunk_index;
+  // <vertex, begin, end> of the edges in the vertex chunk
+  std::vector<std::tuple<IdType, IdType, IdType>> ranges;
+};
+
+}  // namespace
+
+Result<IdType> ForEachActiveEdge(
+    const EdgeInfo& edge_info, const std::string& prefix,
+    AdjListType adj_list_type, const util::Bitmap& active,
+    const std::function<void(IdType, IdType)>& func,
+    int thread_num) noexcept {
+  bool by_source = adj_list_type == AdjListType::ordered_by_source ||
+                   adj_list_type == AdjListType::unordered_by_source;
+  bool ordered = adj_list_type == AdjListType::ordered_by_source ||
+                 adj_list_type == AdjListType::ordered_by_dest;
+  IdType vertex_chunk_size =
+      by_source ? edge_info.GetSrcChunkSize() : edge_info.GetDstChunkSize();
+  IdType edge_chunk_size = edge_info.GetChunkSize();
+  std::string out_prefix;
+  GAR_ASSIGN_OR_RAISE(auto fs, FileSystemFromUriOrPath(prefix, &out_prefix));
+  GAR_ASSIGN_OR_RAISE(auto file_type,
+                      edge_info.GetAdjListFileType(adj_list_type));
+  GAR_ASSIGN_OR_RAISE(auto dir_path,
+                      edge_info.GetAdjListDirPath(adj_list_type));
+  std::string base_dir = out_prefix + dir_path;
+  GAR_ASSIGN_OR_RAISE(IdType vertex_chunk_num, fs->GetFileNumOfDir(base_dir));
+
+  // find the adjList chunks to read of each vertex chunk
+  std::vector<std::vector<ChunkTask>> chunk_tasks(vertex_chunk_num);
+  GAR_RETURN_NOT_OK(util::ParallelFor(
+      0, vertex_chunk_num,
+      [&](IdType i) -> Status {
+        IdType vertex_begin = std::min(i * vertex_chunk_size, active.size());
+        IdType vertex_end =
+            std::min((i + 1) * vertex_chunk_size, active.size());
+        if (!active.Any(vertex_begin, vertex_end)) {
+          return Status::OK();
+        }
+        auto& tasks = chunk_tasks[i];
+        if (!ordered) {
+          std::string chunk_dir = base_dir + "/part" + std::to_string(i);
+          GAR_ASSIGN_OR_RAISE(IdType chunk_num, fs->GetFileNumOfDir(chunk_dir));
+          for (IdType k = 0; k < chunk_num; ++k) {
+            tasks.push_back({i, k, {}});
+          }
+          return Status::OK();
+        }
+        GAR_ASSIGN_OR_RAISE(
+            auto offset_path,
+            edge_info.GetAdjListOffsetFilePath(i, adj_list_type));
+        GAR_ASSIGN_OR_RAISE(auto offset_table,
+                            fs->ReadFileToTable(out_prefix + offset_path,
+                                                file_type));
+        PropertyColumn<IdType> offsets(GeneralParams::kOffsetCol);
+        GAR_RETURN_NOT_OK(offsets.Bind(offset_table->column(0), i));
+        vertex_end = std::min(vertex_end, vertex_begin + offsets.length() - 1);
+        for (IdType vid = vertex_begin; vid < vertex_end; ++vid) {
+          if (!active.Get(vid)) {
+            continue;
+          }
+          IdType begin = offsets[vid - vertex_begin];
+          IdType end = offsets[vid - vertex_begin + 1];
+          // split the edges of the vertex by the chunks
+          while (begin < end) {
+            IdType k = begin / edge_chunk_size;
+            IdType chunk_end = std::min(end, (k + 1) * edge_chunk_size);
+            if (tasks.empty() || tasks.back().edge_chunk_index != k) {
+              tasks.push_back({i, k, {}});
+            }
+            tasks.back().ranges.emplace_back(vid, begin, chunk_end);
+            begin = chunk_end;
+          }
+        }
+        return Status::OK();
+      },
+      thread_num));
+
+  std::vector<ChunkTask> tasks;
+  for (auto& vertex_chunk_tasks : chunk_tasks) {
+    std::move(vertex_chunk_tasks.begin(), vertex_chunk_tasks.end(),
+              std::back_inserter(tasks));
+  }
+
+  // read the chunks and apply the function to the edges
+  GAR_RETURN_NOT_OK(util::ParallelFor(
+      0, tasks.size(),
+      [&](IdType t) -> Status {
+        const auto& task = tasks[t];
+        GAR_ASSIGN_OR_RAISE(auto chunk_path,
+                            edge_info.GetAdjListFilePath(
+                                task.vertex_chunk_index, task.edge_chunk_index,
+                                adj_list_type));
+        // only the sources and destinations are read, not the properties
+        GAR_ASSIGN_OR_RAISE(
+            auto chunk_table,
+            fs->ReadFileToTable(
+                out_prefix + chunk_path, file_type,
+                {GeneralParams::kSrcIndexCol, GeneralParams::kDstIndexCol}));
+        PropertyColumn<IdType> src(GeneralParams::kSrcIndexCol);
+        PropertyColumn<IdType> dst(GeneralParams::kDstIndexCol);
+        GAR_RETURN_NOT_OK(src.Bind(chunk_table, t));
+        GAR_RETURN_NOT_OK(dst.Bind(chunk_table, t));
+        const auto& vertices = by_source ? src : dst;
+        const auto& neighbors = by_source ? dst : src;
+        if (!ordered) {
+          for (int64_t row = 0; row < vertices.length(); ++row) {
+            IdType vid = vertices[row];
+            if (vid >= 0 && vid < active.size() && active.Get(vid)) {
+              func(vid, neighbors[row]);
+            }
+          }
+          return Status::OK();
+        }
+        IdType chunk_offset = task.edge_chunk_index * edge_chunk_size;
+        for (const auto& range : task.ranges) {
+          IdType row_end = std::get<2>(range) - chunk_offset;
+          if (row_end > neighbors.length()) {
+            return Status::Invalid(
+                "The adj list chunk does not match the offsets.");
+          }
+          for (IdType row = std::get<1>(range) - chunk_offset; row < row_end;
+               ++row) {
+            func(std::get<0>(range), neighbors[row]);
+          }
+        }
+        return Status::OK();
+      },
+      thread_num));
+  return static_cast<IdType>(tasks.size());
+}
+
+}  // namespace GAR_NAMESPACE_INTERNAL
@@ -13,44 +13,48 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 
+#include <algorithm>
+
 #include "gar/graph.h"
 #include "gar/utils/convert_to_arrow_type.h"
 
 namespace GAR_NAMESPACE_INTERNAL {
 
 template <Type type>
-Status CastToAny(std::shared_ptr<arrow::Array> array,
-                 std::any& any) {  // NOLINT
+Status CastToAny(std::shared_ptr<arrow::Array> array, std::any& any,  // NOLINT
+                 int64_t index) {
   using ArrayType = typename ConvertToArrowType<type>::ArrayType;
   auto column = std::dynamic_pointer_cast<ArrayType>(array);
-  any = column->GetView(0);
+  any = column->GetView(index);
   return Status::OK();
 }
 
 template <>
 Status CastToAny<Type::STRING>(std::shared_ptr<arrow::Array> array,
-                               std::any& any) {  // NOLINT
+                               std::any& any,  // NOLINT
+                               int64_t index) {
   using ArrayType = typename ConvertToArrowType<Type::STRING>::ArrayType;
   auto column = std::dynamic_pointer_cast<ArrayType>(array);
-  any = column->GetString(0);
+  any = column->GetString(index);
   return Status::OK();
 }
 
 Status TryToCastToAny(const DataType& type, std::shared_ptr<arrow::Array> array,
-                      std::any& any) {  // NOLINT
+                      std::any& any,  // NOLINT
+                      int64_t index = 0) {
   switch (type.id()) {
   case Type::BOOL:
-    return CastToAny<Type::BOOL>(array, any);
+    return CastToAny<Type::BOOL>(array, any, index);
   case Type::INT32:
-    return CastToAny<Type::INT32>(array, any);
+    return CastToAny<Type::INT32>(array, any, index);
   case Type::INT64:
-    return CastToAny<Type::INT64>(array, any);
+    return CastToAny<Type::INT64>(array, any, index);
   case Type::FLOAT:
-    return CastToAny<Type::FLOAT>(array, any);
+    return CastToAny<Type::FLOAT>(array, any, index);
   case Type::DOUBLE:
-    return CastToAny<Type::DOUBLE>(array, any);
+    return CastToAny<Type::DOUBLE>(array, any, index);
   case Type::STRING:
-    return CastToAny<Type::STRING>(array, any);
+    return CastToAny<Type::STRING>(array, any, index);
   default:
     return Status::TypeError();
   }
@@ -97,4 +101,523 @@ Edge::Edge(
     }
   }
 }
+
+Result<std::shared_ptr<arrow::Table>> VerticesCollection::LoadColumns(
+    const std::vector<std::string>& properties, int thread_num) const noexcept {
+  // group the properties by property group, so that each chunk file is read
+  // once for all of its properties
+  std::vector<PropertyGroup> property_groups;
+  std::vector<std::vector<std::string>> group_columns;
+  std::vector<std::pair<size_t, size_t>> locations;  // <group, column>
+  for (const auto& property : properties) {
+    GAR_ASSIGN_OR_RAISE(const auto& pg,
+                        vertex_info_.GetPropertyGroup(property));
+    size_t group_index = std::find(property_groups.begin(),
+                                   property_groups.end(), pg) -
+                         property_groups.begin();
+    if (group_index == property_groups.size()) {
+      property_groups.push_back(pg);
+      group_columns.emplace_back();
+    }
+    locations.emplace_back(group_index, group_columns[group_index].size());
+    group_columns[group_index].push_back(property);
+  }
+
+  std::string out_prefix;
+  GAR_ASSIGN_OR_RAISE(auto fs, FileSystemFromUriOrPath(prefix_, &out_prefix));
+  IdType chunk_size = vertex_info_.GetChunkSize();
+  IdType chunk_num = (vertex_num_ + chunk_size - 1) / chunk_size;
+  IdType group_num = static_cast<IdType>(property_groups.size());
+  // the decoded columns of each <chunk, group>
+  std::vector<std::shared_ptr<arrow::Table>> tables(chunk_num * group_num);
+  GAR_RETURN_NOT_OK(util::ParallelFor(
+      0, chunk_num * group_num,
+      [&](IdType task) -> Status {
+        IdType chunk_index = task / group_num, group_index = task % group_num;
+        const auto& pg = property_groups[group_index];
+        GAR_ASSIGN_OR_RAISE(auto file_path,
+                            vertex_info_.GetFilePath(pg, chunk_index));
+        GAR_ASSIGN_OR_RAISE(
+            tables[task],
+            fs->ReadFileToTable(out_prefix + file_path, pg.GetFileType(),
+                                group_columns[group_index]));
+        return Status::OK();
+      },
+      thread_num));
+
+  arrow::FieldVector fields;
+  arrow::ChunkedArrayVector columns;
+  for (size_t i = 0; i < properties.size(); ++i) {
+    GAR_ASSIGN_OR_RAISE(auto type, vertex_info_.GetPropertyType(properties[i]));
+    arrow::ArrayVector chunks;
+    for (IdType chunk_index = 0; chunk_index < chunk_num; ++chunk_index) {
+      const auto& table = tables[chunk_index * group_num + locations[i].first];
+      auto column = table->GetColumnByName(properties[i]);
+      if (column == nullptr) {
+        return Status::KeyError("The property " + properties[i] +
+                                " is not found in the chunk " +
+                                std::to_string(chunk_index) + ".");
+      }
+      chunks.insert(chunks.end(), column->chunks().begin(),
+                    column->chunks().end());
+    }
+    auto arrow_type = chunks.empty() ? DataType::DataTypeToArrowDataType(type)
+                                     : chunks.front()->type();
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        auto column, arrow::ChunkedArray::Make(std::move(chunks), arrow_type));
+    fields.push_back(arrow::field(properties[i], arrow_type));
+    columns.push_back(std::move(column));
+  }
+  return arrow::Table::Make(arrow::schema(fields), columns);
+}
+
+Edge::Edge(IdType src_id, IdType dst_id,
+           const std::vector<std::shared_ptr<arrow::Table>>& property_tables,
+           IdType row_offset)
+    : src_id_(src_id), dst_id_(dst_id) {
+  for (const auto& chunk_table : property_tables) {
+    auto schema = chunk_table->schema();
+    for (int i = 0; i < schema->num_fields(); ++i) {
+      auto field = chunk_table->field(i);
+      auto type = DataType::ArrowDataTypeToDataType(field->type());
+      GAR_RAISE_ERROR_NOT_OK(
+          TryToCastToAny(type, chunk_table->column(i)->chunk(0),
+                         properties_[field->name()], row_offset));
+    }
+  }
+}
+
+namespace {
+
+/// Make the context with the edge chunk numbers of all vertex chunks, the
+/// chunk range is left to the caller.
+Result<std::shared_ptr<EdgesCollectionContext>> MakeEdgesCollectionContext(
+    const EdgeInfo& edge_info, const std::string& prefix,
+    AdjListType adj_list_type,
+    const std::optional<std::vector<PropertyGroup>>& property_groups) {
+  auto context = std::make_shared<EdgesCollectionContext>();
+  context->edge_info = edge_info;
+  context->adj_list_type = adj_list_type;
+  GAR_ASSIGN_OR_RAISE(context->adj_list_file_type,
+                      edge_info.GetAdjListFileType(adj_list_type));
+  if (property_groups.has_value()) {
+    context->property_groups = property_groups.value();
+  } else {
+    GAR_ASSIGN_OR_RAISE(context->property_groups,
+                        edge_info.GetPropertyGroups(adj_list_type));
+  }
+  GAR_ASSIGN_OR_RAISE(context->fs,
+                      FileSystemFromUriOrPath(prefix, &context->prefix));
+  GAR_ASSIGN_OR_RAISE(auto dir_path,
+                      edge_info.GetAdjListDirPath(adj_list_type));
+  std::string base_dir = context->prefix + dir_path;
+  GAR_ASSIGN_OR_RAISE(auto vertex_chunk_num,
+                      context->fs->GetFileNumOfDir(base_dir));
+  std::vector<IdType> edge_chunk_nums(vertex_chunk_num, 0);
+  for (size_t i = 0; i < vertex_chunk_num; ++i) {
+    std::string chunk_dir = base_dir + "/part" + std::to_string(i);
+    GAR_ASSIGN_OR_RAISE(edge_chunk_nums[i],
+                        context->fs->GetFileNumOfDir(chunk_dir));
+  }
+  context->index_converter =
+      std::make_shared<util::IndexConverter>(std::move(edge_chunk_nums));
+  context->chunk_size = edge_info.GetChunkSize();
+  context->src_chunk_size = edge_info.GetSrcChunkSize();
+  context->dst_chunk_size = edge_info.GetDstChunkSize();
+  context->neighbor_cache = std::make_shared<NeighborCache>();
+  return context;
+}
+
+}  // namespace
+
+Result<std::shared_ptr<const EdgesCollectionContext>>
+EdgesCollectionContext::Make(
+    const EdgeInfo& edge_info, const std::string& prefix,
+    AdjListType adj_list_type,
+    const std::optional<std::vector<PropertyGroup>>& property_groups) noexcept {
+  GAR_ASSIGN_OR_RAISE(
+      auto context, MakeEdgesCollectionContext(edge_info, prefix, adj_list_type,
+                                               property_groups));
+  context->chunk_begin = 0;
+  context->chunk_end = context->index_converter->GetTotalChunkNum();
+  context->offset_of_chunk_begin = 0;
+  context->offset_of_chunk_end = 0;
+  return std::shared_ptr<const EdgesCollectionContext>(std::move(context));
+}
+
+Result<std::shared_ptr<const EdgesCollectionContext>>
+EdgesCollectionContext::Make(
+    const EdgeInfo& edge_info, const std::string& prefix,
+    AdjListType adj_list_type, IdType chunk_begin, IdType chunk_end,
+    const std::optional<std::vector<PropertyGroup>>& property_groups) noexcept {
+  GAR_ASSIGN_OR_RAISE(
+      auto context, MakeEdgesCollectionContext(edge_info, prefix, adj_list_type,
+                                               property_groups));
+  context->chunk_begin = chunk_begin;
+  context->chunk_end = chunk_end;
+  context->offset_of_chunk_begin =
+      context->index_converter->GlobalChunkIndexToIndexPair(chunk_begin)
+          .second *
+      context->chunk_size;
+  context->offset_of_chunk_end =
+      context->index_converter->GlobalChunkIndexToIndexPair(chunk_end).second *
+      context->chunk_size;
+  return std::shared_ptr<const EdgesCollectionContext>(std::move(context));
+}
+
+Result<std::shared_ptr<const EdgesCollectionContext>>
+EdgesCollectionContext::Make(
+    const EdgeInfo& edge_info, const std::string& prefix,
+    AdjListType adj_list_type, IdType vertex_chunk_index,
+    const std::optional<std::vector<PropertyGroup>>& property_groups) noexcept {
+  GAR_ASSIGN_OR_RAISE(
+      auto context, MakeEdgesCollectionContext(edge_info, prefix, adj_list_type,
+                                               property_groups));
+  const auto& index_converter = context->index_converter;
+  IdType vertex_chunk_num = index_converter->GetVertexChunkNum();
+  if (vertex_chunk_index < vertex_chunk_num) {
+    context->chunk_begin =
+        index_converter->IndexPairToGlobalChunkIndex(vertex_chunk_index, 0);
+    context->chunk_end = context->chunk_begin +
+                         index_converter->GetEdgeChunkNum(vertex_chunk_index);
+  } else {
+    // an empty collection
+    context->chunk_begin = index_converter->GetTotalChunkNum();
+    context->chunk_end = context->chunk_begin;
+  }
+  context->offset_of_chunk_begin = 0;
+  context->offset_of_chunk_end = 0;
+  return std::shared_ptr<const EdgesCollectionContext>(std::move(context));
+}
+
+Status EdgeIter::loadChunk() noexcept {
+  if (chunk_ != nullptr && chunk_->global_chunk_index == global_chunk_index_) {
+    return Status::OK();
+  }
+  IdType edge_chunk_index = cur_offset_ / context_->chunk_size;
+  GAR_ASSIGN_OR_RAISE(
+      auto chunk_file_path,
+      context_->edge_info.GetAdjListFilePath(
+          vertex_chunk_index_, edge_chunk_index, context_->adj_list_type));
+  GAR_ASSIGN_OR_RAISE(auto chunk_table,
+                      context_->fs->ReadFileToTable(
+                          context_->prefix + chunk_file_path,
+                          context_->adj_list_file_type));
+  auto chunk = std::make_shared<AdjListChunk>();
+  GAR_RETURN_NOT_OK(
+      chunk->src.Bind(chunk_table->column(0), global_chunk_index_));
+  GAR_RETURN_NOT_OK(
+      chunk->dst.Bind(chunk_table->column(1), global_chunk_index_));
+  chunk->num_rows = chunk_table->num_rows();
+  chunk->global_chunk_index = global_chunk_index_;
+  chunk_ = std::move(chunk);
+  return Status::OK();
+}
+
+Status EdgeIter::loadPropertyChunk() noexcept {
+  if (property_chunk_ != nullptr &&
+      property_chunk_->global_chunk_index == global_chunk_index_) {
+    return Status::OK();
+  }
+  IdType edge_chunk_index = cur_offset_ / context_->chunk_size;
+  auto property_chunk = std::make_shared<PropertyChunk>();
+  for (const auto& pg : context_->property_groups) {
+    GAR_ASSIGN_OR_RAISE(auto chunk_file_path,
+                        context_->edge_info.GetPropertyFilePath(
+                            pg, context_->adj_list_type, vertex_chunk_index_,
+                            edge_chunk_index));
+    GAR_ASSIGN_OR_RAISE(
+        auto chunk_table,
+        context_->fs->ReadFileToTable(context_->prefix + chunk_file_path,
+                                      pg.GetFileType()));
+    // each column is accessed as a single array
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(chunk_table,
+                                         chunk_table->CombineChunks());
+    property_chunk->tables.push_back(std::move(chunk_table));
+  }
+  property_chunk->global_chunk_index = global_chunk_index_;
+  property_chunk_ = std::move(property_chunk);
+  return Status::OK();
+}
+
+Result<std::pair<IdType, IdType>> EdgeIter::getOffsetRange(
+    IdType id) noexcept {
+  IdType vertex_chunk_size =
+      context_->adj_list_type == AdjListType::ordered_by_source
+          ? context_->src_chunk_size
+          : context_->dst_chunk_size;
+  IdType vertex_chunk_index = id / vertex_chunk_size;
+  if (offsets_ == nullptr || offsets_chunk_index_ != vertex_chunk_index) {
+    GAR_ASSIGN_OR_RAISE(auto offset_file_path,
+                        context_->edge_info.GetAdjListOffsetFilePath(
+                            vertex_chunk_index, context_->adj_list_type));
+    GAR_ASSIGN_OR_RAISE(
+        auto offset_table,
+        context_->fs->ReadFileToTable(context_->prefix + offset_file_path,
+                                      context_->adj_list_file_type));
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(offset_table,
+                                         offset_table->CombineChunks());
+    offsets_ = std::static_pointer_cast<arrow::Int64Array>(
+        offset_table->column(0)->chunk(0));
+    offsets_chunk_index_ = vertex_chunk_index;
+  }
+  IdType index = id % vertex_chunk_size;
+  if (index + 1 >= offsets_->length()) {
+    return Status::KeyError("The id " + std::to_string(id) + " not exist.");
+  }
+  return std::make_pair(static_cast<IdType>(offsets_->Value(index)),
+                        static_cast<IdType>(offsets_->Value(index + 1)));
+}
+
+Result<IdType> NeighborCache::getVertexChunkSize(
+    const EdgesCollectionContext& context) noexcept {
+  if (context.adj_list_type == AdjListType::ordered_by_source) {
+    return context.src_chunk_size;
+  } else if (context.adj_list_type == AdjListType::ordered_by_dest) {
+    return context.dst_chunk_size;
+  }
+  return Status::Invalid("The neighbors can only be got from ordered adj "
+                         "list.");
+}
+
+Result<NeighborRange> NeighborCache::Neighbors(
+    const EdgesCollectionContext& context, IdType vid,
+    bool with_properties) noexcept {
+  GAR_ASSIGN_OR_RAISE(IdType vertex_chunk_size, getVertexChunkSize(context));
+  IdType vertex_chunk_index = vid / vertex_chunk_size;
+  if (vid < 0 ||
+      vertex_chunk_index >= context.index_converter->GetVertexChunkNum()) {
+    return Status::KeyError("The id " + std::to_string(vid) + " not exist.");
+  }
+  GAR_ASSIGN_OR_RAISE(auto offsets, getOffsets(context, vertex_chunk_index));
+  IdType index = vid % vertex_chunk_size;
+  if (index + 1 >= offsets->length()) {
+    return Status::KeyError("The id " + std::to_string(vid) + " not exist.");
+  }
+  IdType begin = offsets->Value(index), end = offsets->Value(index + 1);
+  std::vector<NeighborRange::Segment> segments;
+  for (IdType edge_chunk_index = begin / context.chunk_size;
+       begin < end && edge_chunk_index * context.chunk_size < end;
+       ++edge_chunk_index) {
+    IdType chunk_offset = edge_chunk_index * context.chunk_size;
+    GAR_ASSIGN_OR_RAISE(auto chunk,
+                        getChunk(context, vertex_chunk_index,
+                                 edge_chunk_index, with_properties));
+    int64_t row_begin = std::max(begin, chunk_offset) - chunk_offset;
+    int64_t row_end =
+        std::min(end, chunk_offset + context.chunk_size) - chunk_offset;
+    if (row_end > chunk->neighbors->length()) {
+      return Status::Invalid("The adj list chunk does not match the offsets.");
+    }
+    segments.push_back({std::move(chunk), row_begin, row_end});
+  }
+  return NeighborRange(std::move(segments));
+}
+
+Result<NeighborBatch> NeighborCache::BatchNeighbors(
+    const EdgesCollectionContext& context, const std::vector<IdType>& vids,
+    int thread_num) noexcept {
+  GAR_ASSIGN_OR_RAISE(IdType vertex_chunk_size, getVertexChunkSize(context));
+  IdType vertex_chunk_num = context.index_converter->GetVertexChunkNum();
+  for (IdType vid : vids) {
+    if (vid < 0 || vid / vertex_chunk_size >= vertex_chunk_num) {
+      return Status::KeyError("The id " + std::to_string(vid) + " not exist.");
+    }
+  }
+
+  // load the offset chunks of the vertex chunks in need
+  std::vector<IdType> vertex_chunks;
+  for (IdType vid : vids) {
+    vertex_chunks.push_back(vid / vertex_chunk_size);
+  }
+  std::sort(vertex_chunks.begin(), vertex_chunks.end());
+  vertex_chunks.erase(std::unique(vertex_chunks.begin(), vertex_chunks.end()),
+                      vertex_chunks.end());
+  std::vector<std::shared_ptr<arrow::Int64Array>> offset_chunks(
+      vertex_chunks.size());
+  GAR_RETURN_NOT_OK(util::ParallelFor(
+      0, vertex_chunks.size(),
+      [&](IdType i) -> Status {
+        GAR_ASSIGN_OR_RAISE(offset_chunks[i],
+                            getOffsets(context, vertex_chunks[i]));
+        return Status::OK();
+      },
+      thread_num));
+
+  // the edge ranges of the vertices, and the adjList chunks they cover
+  NeighborBatch batch;
+  batch.offsets.resize(vids.size() + 1, 0);
+  std::vector<std::pair<IdType, IdType>> ranges(vids.size());
+  std::vector<IdType> global_chunks;
+  for (size_t i = 0; i < vids.size(); ++i) {
+    IdType vertex_chunk_index = vids[i] / vertex_chunk_size;
+    size_t slot = std::lower_bound(vertex_chunks.begin(), vertex_chunks.end(),
+                                   vertex_chunk_index) -
+                  vertex_chunks.begin();
+    const auto& offsets = offset_chunks[slot];
+    IdType index = vids[i] % vertex_chunk_size;
+    if (index + 1 >= offsets->length()) {
+      return Status::KeyError("The id " + std::to_string(vids[i]) +
+                              " not exist.");
+    }
+    ranges[i] =
+        std::make_pair(offsets->Value(index), offsets->Value(index + 1));
+    batch.offsets[i + 1] =
+        batch.offsets[i] + ranges[i].second - ranges[i].first;
+    for (IdType edge_chunk_index = ranges[i].first / context.chunk_size;
+         ranges[i].first < ranges[i].second &&
+         edge_chunk_index * context.chunk_size < ranges[i].second;
+         ++edge_chunk_index) {
+      global_chunks.push_back(
+          context.index_converter->IndexPairToGlobalChunkIndex(
+              vertex_chunk_index, edge_chunk_index));
+    }
+  }
+  std::sort(global_chunks.begin(), global_chunks.end());
+  global_chunks.erase(std::unique(global_chunks.begin(), global_chunks.end()),
+                      global_chunks.end());
+
+  // load each adjList chunk once
+  std::vector<std::shared_ptr<const NeighborChunk>> chunks(
+      global_chunks.size());
+  GAR_RETURN_NOT_OK(util::ParallelFor(
+      0, global_chunks.size(),
+      [&](IdType i) -> Status {
+        auto index_pair = context.index_converter->GlobalChunkIndexToIndexPair(
+            global_chunks[i]);
+        GAR_ASSIGN_OR_RAISE(chunks[i], getChunk(context, index_pair.first,
+                                                index_pair.second, false));
+        return Status::OK();
+      },
+      thread_num));
+
+  // copy the neighbors of each vertex to its place
+  batch.neighbors.resize(batch.offsets.back());
+  GAR_RETURN_NOT_OK(util::ParallelFor(
+      0, vids.size(),
+      [&](IdType i) -> Status {
+        IdType vertex_chunk_index = vids[i] / vertex_chunk_size;
+        IdType begin = ranges[i].first, end = ranges[i].second;
+        IdType* out = batch.neighbors.data() + batch.offsets[i];
+        while (begin < end) {
+          IdType edge_chunk_index = begin / context.chunk_size;
+          IdType chunk_offset = edge_chunk_index * context.chunk_size;
+          IdType global_chunk_index =
+              context.index_converter->IndexPairToGlobalChunkIndex(
+                  vertex_chunk_index, edge_chunk_index);
+          const auto& chunk = chunks[std::lower_bound(global_chunks.begin(),
+                                                      global_chunks.end(),
+                                                      global_chunk_index) -
+                                     global_chunks.begin()];
+          IdType chunk_end = std::min(end, chunk_offset + context.chunk_size);
+          if (chunk_end - chunk_offset > chunk->neighbors->length()) {
+            return Status::Invalid(
+                "The adj list chunk does not match the offsets.");
+          }
+          const int64_t* values = chunk->neighbors->raw_values();
+          out = std::copy(values + (begin - chunk_offset),
+                          values + (chunk_end - chunk_offset), out);
+          begin = chunk_end;
+        }
+        return Status::OK();
+      },
+      thread_num));
+  return batch;
+}
+
+Result<std::shared_ptr<arrow::Int64Array>> NeighborCache::getOffsets(
+    const EdgesCollectionContext& context,
+    IdType vertex_chunk_index) noexcept {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = offsets_.find(vertex_chunk_index);
+    if (it != offsets_.end()) {
+      return it->second;
+    }
+  }
+  GAR_ASSIGN_OR_RAISE(auto offset_file_path,
+                      context.edge_info.GetAdjListOffsetFilePath(
+                          vertex_chunk_index, context.adj_list_type));
+  GAR_ASSIGN_OR_RAISE(
+      auto offset_table,
+      context.fs->ReadFileToTable(context.prefix + offset_file_path,
+                                  context.adj_list_file_type));
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(offset_table,
+                                       offset_table->CombineChunks());
+  auto offsets = std::static_pointer_cast<arrow::Int64Array>(
+      offset_table->column(0)->chunk(0));
+  std::lock_guard<std::mutex> lock(mutex_);
+  return offsets_.emplace(vertex_chunk_index, std::move(offsets))
+      .first->second;
+}
+
+Result<std::shared_ptr<const NeighborChunk>> NeighborCache::getChunk(
+    const EdgesCollectionContext& context, IdType vertex_chunk_index,
+    IdType edge_chunk_index, bool with_properties) noexcept {
+  IdType global_chunk_index =
+      context.index_converter->IndexPairToGlobalChunkIndex(vertex_chunk_index,
+                                                           edge_chunk_index);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = chunks_.find(global_chunk_index);
+    if (it != chunks_.end() &&
+        (!with_properties || it->second.first->has_properties)) {
+      lru_.splice(lru_.begin(), lru_, it->second.second);
+      return it->second.first;
+    }
+  }
+
+  auto chunk = std::make_shared<NeighborChunk>();
+  GAR_ASSIGN_OR_RAISE(auto chunk_file_path,
+                      context.edge_info.GetAdjListFilePath(
+                          vertex_chunk_index, edge_chunk_index,
+                          context.adj_list_type));
+  GAR_ASSIGN_OR_RAISE(
+      auto chunk_table,
+      context.fs->ReadFileToTable(context.prefix + chunk_file_path,
+                                  context.adj_list_file_type));
+  std::string neighbor_column =
+      context.adj_list_type == AdjListType::ordered_by_source
+          ? GeneralParams::kDstIndexCol
+          : GeneralParams::kSrcIndexCol;
+  auto column = chunk_table->GetColumnByName(neighbor_column);
+  if (column == nullptr) {
+    return Status::KeyError("The column " + neighbor_column +
+                            " is not found in " + chunk_file_path + ".");
+  }
+  PropertyColumn<IdType> neighbors(neighbor_column);
+  GAR_RETURN_NOT_OK(neighbors.Bind(column, global_chunk_index));
+  chunk->neighbors = neighbors.array();
+  if (with_properties) {
+    for (const auto& pg : context.property_groups) {
+      GAR_ASSIGN_OR_RAISE(auto property_file_path,
+                          context.edge_info.GetPropertyFilePath(
+                              pg, context.adj_list_type, vertex_chunk_index,
+                              edge_chunk_index));
+      GAR_ASSIGN_OR_RAISE(
+          auto property_table,
+          context.fs->ReadFileToTable(context.prefix + property_file_path,
+                                      pg.GetFileType()));
+      GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(property_table,
+                                           property_table->CombineChunks());
+      chunk->property_tables.push_back(std::move(property_table));
+    }
+    chunk->has_properties = true;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = chunks_.find(global_chunk_index);
+  if (it != chunks_.end()) {
+    lru_.erase(it->second.second);
+    chunks_.erase(it);
+  }
+  lru_.push_front(global_chunk_index);
+  chunks_.emplace(global_chunk_index, std::make_pair(chunk, lru_.begin()));
+  while (chunks_.size() > capacity_) {
+    chunks_.erase(lru_.back());
+    lru_.pop_back();
+  }
+  return std::shared_ptr<const NeighborChunk>(std::move(chunk));
+}
+
 }  // namespace GAR_NAMESPACE_INTERNAL
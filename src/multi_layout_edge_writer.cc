@@ -0,0 +1,149 @@
+/** Copyright 2022 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/api.h"
+
+#include "gar/writer/multi_layout_edge_writer.h"
+#include "gar/utils/general_params.h"
+
+namespace GAR_NAMESPACE_INTERNAL {
+
+Status MultiLayoutEdgeWriter::WriteTable(
+    const std::shared_ptr<arrow::Table>& input_table, IdType src_num,
+    IdType dst_num, int thread_num) const noexcept {
+  GAR_RETURN_NOT_OK(writeDirection(input_table, true, src_num, thread_num));
+  return writeDirection(input_table, false, dst_num, thread_num);
+}
+
+Status MultiLayoutEdgeWriter::writeDirection(
+    const std::shared_ptr<arrow::Table>& input_table, bool by_source,
+    IdType vertex_num, int thread_num) const noexcept {
+  AdjListType ordered_type = by_source ? AdjListType::ordered_by_source
+                                       : AdjListType::ordered_by_dest;
+  AdjListType unordered_type = by_source ? AdjListType::unordered_by_source
+                                         : AdjListType::unordered_by_dest;
+  std::vector<AdjListType> adj_list_types;
+  for (auto adj_list_type : {ordered_type, unordered_type}) {
+    if (edge_info_.ContainAdjList(adj_list_type)) {
+      adj_list_types.push_back(adj_list_type);
+    }
+  }
+  if (adj_list_types.empty()) {
+    return Status::OK();
+  }
+
+  // the sources or destinations, as one contiguous array
+  std::string column_name =
+      by_source ? GeneralParams::kSrcIndexCol : GeneralParams::kDstIndexCol;
+  auto column = input_table->GetColumnByName(column_name);
+  if (column == nullptr) {
+    return Status::Invalid("The table must contain the column " +
+                           column_name + ".");
+  }
+  if (!column->type()->Equals(arrow::int64()) || column->null_count() > 0) {
+    return Status::Invalid("The column " + column_name +
+                           " must be non-null int64.");
+  }
+  std::shared_ptr<arrow::Array> keys_array;
+  const int64_t* keys = nullptr;
+  int64_t length = input_table->num_rows();
+  if (length > 0) {
+    if (column->num_chunks() == 1) {
+      keys_array = column->chunk(0);
+    } else {
+      GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+          keys_array, arrow::Concatenate(column->chunks()));
+    }
+    keys =
+        std::static_pointer_cast<arrow::Int64Array>(keys_array)->raw_values();
+  }
+  IdType vertex_chunk_size = by_source ? edge_info_.GetSrcChunkSize()
+                                       : edge_info_.GetDstChunkSize();
+  IdType num_vertex_chunks = 0;
+  if (vertex_num != -1) {
+    num_vertex_chunks =
+        (vertex_num + vertex_chunk_size - 1) / vertex_chunk_size;
+  }
+  for (int64_t i = 0; i < length; ++i) {
+    if (keys[i] < 0) {
+      return Status::Invalid("The vertex id " + std::to_string(keys[i]) +
+                             " is negative.");
+    }
+    num_vertex_chunks =
+        std::max(num_vertex_chunks, keys[i] / vertex_chunk_size + 1);
+  }
+
+  // sort the edges once for both adj list types, the offsets of all vertex
+  // chunks are counted from the unsorted keys; without edges, only the
+  // empty offset chunks of the given vertices are written
+  std::vector<int64_t> offsets(num_vertex_chunks * vertex_chunk_size + 1);
+  util::ComputeOffsets(keys, length, 0, num_vertex_chunks * vertex_chunk_size,
+                       offsets.data());
+  std::shared_ptr<arrow::Table> sorted_table = input_table;
+  if (length > 0) {
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        std::shared_ptr<arrow::Buffer> buffer,
+        arrow::AllocateBuffer(length * sizeof(int64_t)));
+    GAR_RETURN_NOT_OK(util::SortIndices(
+        keys, length, reinterpret_cast<int64_t*>(buffer->mutable_data()),
+        thread_num));
+    keys_array.reset();
+    column.reset();
+    auto indices = std::make_shared<arrow::Int64Array>(length, buffer);
+    GAR_ASSIGN_OR_RAISE(sorted_table,
+                        util::TakeTable(input_table, indices, thread_num));
+  }
+
+  // write each adj list type and vertex chunk concurrently
+  std::vector<EdgeChunkWriter> writers;
+  for (auto adj_list_type : adj_list_types) {
+    writers.emplace_back(edge_info_, prefix_, adj_list_type, validate_level_);
+  }
+  auto offset_schema = arrow::schema({arrow::field(
+      GeneralParams::kOffsetCol,
+      DataType::DataTypeToArrowDataType(DataType(Type::INT64)))});
+  return util::ParallelFor(
+      0, static_cast<IdType>(writers.size()) * num_vertex_chunks,
+      [&](IdType task) -> Status {
+        const auto& writer = writers[task / num_vertex_chunks];
+        IdType i = task % num_vertex_chunks;
+        const int64_t* chunk_offsets = offsets.data() + i * vertex_chunk_size;
+        int64_t begin = chunk_offsets[0],
+                num = chunk_offsets[vertex_chunk_size] - begin;
+        if (adj_list_types[task / num_vertex_chunks] == ordered_type) {
+          arrow::Int64Builder builder;
+          RETURN_NOT_ARROW_OK(builder.Reserve(vertex_chunk_size + 1));
+          for (IdType v = 0; v <= vertex_chunk_size; ++v) {
+            builder.UnsafeAppend(chunk_offsets[v] - begin);
+          }
+          GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto array, builder.Finish());
+          GAR_RETURN_NOT_OK(writer.WriteOffsetChunk(
+              arrow::Table::Make(offset_schema, {array}), i));
+        }
+        if (num > 0) {
+          GAR_RETURN_NOT_OK(
+              writer.WriteTable(sorted_table->Slice(begin, num), i, 0));
+        }
+        return Status::OK();
+      },
+      thread_num);
+}
+
+}  // namespace GAR_NAMESPACE_INTERNAL
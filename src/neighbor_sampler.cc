@@ -0,0 +1,465 @@
+/** Copyright 2022 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "arrow/api.h"
+#include "arrow/compute/api.h"
+
+#include "gar/algorithm/neighbor_sampler.h"
+#include "gar/utils/filesystem.h"
+#include "gar/utils/reader_utils.h"
+
+namespace GAR_NAMESPACE_INTERNAL {
+
+namespace {
+
+// the number of centers sampled by a thread at a time
+constexpr IdType kBlockSize = 256;
+
+/// The edges sampled for a block of centers.
+struct BlockEdges {
+  std::vector<IdType> centers;
+  std::vector<IdType> edges;
+};
+
+/// Allocate an uninitialized array with specific length.
+template <typename ArrayType>
+Result<std::shared_ptr<ArrayType>> AllocateArray(IdType length) {
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      std::shared_ptr<arrow::Buffer> buffer,
+      arrow::AllocateBuffer(length * sizeof(typename ArrayType::value_type)));
+  return std::make_shared<ArrayType>(length, std::move(buffer));
+}
+
+/// Get the mutable values of an array allocated by AllocateArray.
+template <typename ArrayType>
+typename ArrayType::value_type* MutableValues(
+    const std::shared_ptr<ArrayType>& array) {
+  return reinterpret_cast<typename ArrayType::value_type*>(
+      array->values()->mutable_data());
+}
+
+/**
+ * Sample the neighbors of a vertex, and append the positions of the sampled
+ * edges to edges.
+ */
+Status SampleEdges(const int64_t* offsets, const double* weights, IdType vid,
+                   int fanout, bool replace, std::mt19937_64* engine,
+                   std::vector<std::pair<double, IdType>>* scratch,
+                   std::vector<IdType>* edges) {
+  IdType begin = offsets[vid], degree = offsets[vid + 1] - begin;
+  if (degree == 0 || fanout == 0) {
+    return Status::OK();
+  }
+  if (weights == nullptr) {
+    if (fanout < 0 || (!replace && degree <= fanout)) {
+      for (IdType i = 0; i < degree; ++i) {
+        edges->push_back(begin + i);
+      }
+    } else if (replace) {
+      std::uniform_int_distribution<IdType> distribution(0, degree - 1);
+      for (int i = 0; i < fanout; ++i) {
+        edges->push_back(begin + distribution(*engine));
+      }
+    } else {
+      // Floyd's algorithm, which draws fanout distinct neighbors with fanout
+      // random numbers
+      size_t start = edges->size();
+      for (IdType j = degree - fanout; j < degree; ++j) {
+        IdType edge =
+            begin + std::uniform_int_distribution<IdType>(0, j)(*engine);
+        if (std::find(edges->begin() + start, edges->end(), edge) !=
+            edges->end()) {
+          edge = begin + j;
+        }
+        edges->push_back(edge);
+      }
+    }
+    return Status::OK();
+  }
+
+  scratch->clear();
+  double total = 0;
+  for (IdType i = begin; i < begin + degree; ++i) {
+    if (!(weights[i] >= 0)) {
+      return Status::Invalid("The weight of the edge " + std::to_string(i) +
+                             " is not a non-negative number.");
+    }
+    if (weights[i] == 0) {
+      continue;
+    }
+    if (replace && fanout >= 0) {
+      // the cumulative weights
+      total += weights[i];
+      scratch->emplace_back(total, i);
+    } else {
+      // the keys of Efraimidis-Spirakis, the largest keys are sampled
+      double u = 1 - std::generate_canonical<double, 64>(*engine);
+      scratch->emplace_back(std::log(u) / weights[i], i);
+    }
+  }
+  if (scratch->empty()) {
+    return Status::OK();
+  }
+  if (replace && fanout >= 0) {
+    std::uniform_real_distribution<double> distribution(0, total);
+    for (int i = 0; i < fanout; ++i) {
+      double value = distribution(*engine);
+      auto it = std::upper_bound(
+          scratch->begin(), scratch->end(), value,
+          [](double v, const std::pair<double, IdType>& p) {
+            return v < p.first;
+          });
+      if (it == scratch->end()) {
+        --it;
+      }
+      edges->push_back(it->second);
+    }
+    return Status::OK();
+  }
+  if (fanout >= 0 && scratch->size() > static_cast<size_t>(fanout)) {
+    std::nth_element(scratch->begin(), scratch->begin() + fanout,
+                     scratch->end(),
+                     [](const std::pair<double, IdType>& a,
+                        const std::pair<double, IdType>& b) {
+                       return a.first > b.first;
+                     });
+    scratch->resize(fanout);
+  }
+  for (const auto& p : *scratch) {
+    edges->push_back(p.second);
+  }
+  return Status::OK();
+}
+
+/// Take the rows of a table.
+Result<std::shared_ptr<arrow::Table>> TakeRows(
+    const std::shared_ptr<arrow::Table>& table,
+    const std::vector<int64_t>& rows) {
+  arrow::Int64Builder builder;
+  RETURN_NOT_ARROW_OK(builder.AppendValues(rows));
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto indices, builder.Finish());
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto datum,
+                                       arrow::compute::Take(table, indices));
+  return datum.table();
+}
+
+}  // namespace
+
+Result<SampledSubgraph> SampleNeighbors(
+    const CSR& csr, const std::vector<IdType>& seeds,
+    const std::vector<int>& fanouts,
+    const std::shared_ptr<arrow::DoubleArray>& weights, bool replace,
+    uint64_t random_seed, int thread_num) noexcept {
+  IdType vertex_num = csr.GetVertexNum();
+  const double* weight_data = nullptr;
+  if (weights != nullptr) {
+    if (weights->length() != csr.GetEdgeNum()) {
+      return Status::Invalid("There are " + std::to_string(weights->length()) +
+                             " weights, but " +
+                             std::to_string(csr.GetEdgeNum()) + " edges.");
+    }
+    if (weights->null_count() > 0) {
+      return Status::Invalid("The weights must not be null.");
+    }
+    weight_data = weights->raw_values();
+  }
+
+  // the indices of the vertices in the subgraph
+  std::unordered_map<IdType, IdType> indices;
+  std::vector<IdType> vertices;
+  for (auto seed : seeds) {
+    if (seed < 0 || seed >= vertex_num) {
+      return Status::Invalid("The seed vertex " + std::to_string(seed) +
+                             " is out of range.");
+    }
+    if (indices.emplace(seed, vertices.size()).second) {
+      vertices.push_back(seed);
+    }
+  }
+
+  SampledSubgraph result;
+  const int64_t* offsets = csr.GetOffsets();
+  const int64_t* neighbors = csr.GetNeighbors();
+  IdType center_begin = 0;
+  for (size_t hop = 0; hop < fanouts.size(); ++hop) {
+    IdType center_end = vertices.size();
+    IdType block_num =
+        (center_end - center_begin + kBlockSize - 1) / kBlockSize;
+    std::vector<BlockEdges> block_edges(block_num);
+    GAR_RETURN_NOT_OK(util::ParallelFor(
+        0, block_num,
+        [&](IdType block) -> Status {
+          std::seed_seq seed_seq{static_cast<uint32_t>(random_seed),
+                                 static_cast<uint32_t>(random_seed >> 32),
+                                 static_cast<uint32_t>(hop),
+                                 static_cast<uint32_t>(block)};
+          std::mt19937_64 engine(seed_seq);
+          std::vector<std::pair<double, IdType>> scratch;
+          auto& edges = block_edges[block];
+          IdType begin = center_begin + block * kBlockSize;
+          IdType end = std::min(begin + kBlockSize, center_end);
+          for (IdType center = begin; center < end; ++center) {
+            GAR_RETURN_NOT_OK(SampleEdges(offsets, weight_data,
+                                          vertices[center], fanouts[hop],
+                                          replace, &engine, &scratch,
+                                          &edges.edges));
+            edges.centers.resize(edges.edges.size(), center);
+          }
+          return Status::OK();
+        },
+        thread_num));
+
+    // the new vertices are indexed in the order of the edges
+    IdType edge_num = 0;
+    for (const auto& edges : block_edges) {
+      edge_num += edges.edges.size();
+    }
+    SampledBlock sampled_block;
+    GAR_ASSIGN_OR_RAISE(sampled_block.centers,
+                        AllocateArray<arrow::Int64Array>(edge_num));
+    GAR_ASSIGN_OR_RAISE(sampled_block.neighbors,
+                        AllocateArray<arrow::Int64Array>(edge_num));
+    GAR_ASSIGN_OR_RAISE(sampled_block.edges,
+                        AllocateArray<arrow::Int64Array>(edge_num));
+    auto centers_data = MutableValues(sampled_block.centers);
+    auto neighbors_data = MutableValues(sampled_block.neighbors);
+    auto edges_data = MutableValues(sampled_block.edges);
+    IdType i = 0;
+    for (const auto& edges : block_edges) {
+      for (size_t k = 0; k < edges.edges.size(); ++k, ++i) {
+        IdType neighbor = neighbors[edges.edges[k]];
+        auto it = indices.emplace(neighbor, vertices.size());
+        if (it.second) {
+          vertices.push_back(neighbor);
+        }
+        centers_data[i] = edges.centers[k];
+        neighbors_data[i] = it.first->second;
+        edges_data[i] = edges.edges[k];
+      }
+    }
+    result.blocks.push_back(std::move(sampled_block));
+    center_begin = center_end;
+  }
+
+  GAR_ASSIGN_OR_RAISE(result.vertices,
+                      AllocateArray<arrow::Int64Array>(vertices.size()));
+  std::copy(vertices.begin(), vertices.end(), MutableValues(result.vertices));
+  return result;
+}
+
+Result<std::shared_ptr<arrow::DoubleArray>> LoadEdgeWeights(
+    const CSR& csr, const EdgeInfo& edge_info, const std::string& prefix,
+    const std::string& property, int thread_num) noexcept {
+  AdjListType adj_list_type = csr.GetAdjListType();
+  IdType vertex_chunk_size;
+  if (adj_list_type == AdjListType::ordered_by_source) {
+    vertex_chunk_size = edge_info.GetSrcChunkSize();
+  } else if (adj_list_type == AdjListType::ordered_by_dest) {
+    vertex_chunk_size = edge_info.GetDstChunkSize();
+  } else {
+    return Status::Invalid("The CSR can only be loaded from ordered adj list.");
+  }
+  GAR_ASSIGN_OR_RAISE(auto type, edge_info.GetPropertyType(property));
+  if (!(type == DataType(Type::INT32) || type == DataType(Type::INT64) ||
+        type == DataType(Type::FLOAT) || type == DataType(Type::DOUBLE))) {
+    return Status::TypeError("The property " + property + " of type " +
+                             type.ToTypeName() + " is not numeric.");
+  }
+  GAR_ASSIGN_OR_RAISE(const auto& property_group,
+                      edge_info.GetPropertyGroup(property, adj_list_type));
+  std::string out_prefix;
+  GAR_ASSIGN_OR_RAISE(auto fs, FileSystemFromUriOrPath(prefix, &out_prefix));
+
+  // list the property chunks as (vertex chunk index, edge chunk index), the
+  // edges of a vertex chunk start from the offset of its first vertex
+  IdType vertex_num = csr.GetVertexNum();
+  IdType edge_chunk_size = edge_info.GetChunkSize();
+  const int64_t* offsets = csr.GetOffsets();
+  std::vector<std::pair<IdType, IdType>> chunks;
+  for (IdType begin = 0; begin < vertex_num; begin += vertex_chunk_size) {
+    IdType end = std::min(begin + vertex_chunk_size, vertex_num);
+    IdType edge_num = offsets[end] - offsets[begin];
+    for (IdType j = 0; j * edge_chunk_size < edge_num; ++j) {
+      chunks.emplace_back(begin / vertex_chunk_size, j);
+    }
+  }
+
+  GAR_ASSIGN_OR_RAISE(auto weights,
+                      AllocateArray<arrow::DoubleArray>(csr.GetEdgeNum()));
+  auto weights_data = MutableValues(weights);
+  GAR_RETURN_NOT_OK(util::ParallelFor(
+      0, chunks.size(),
+      [&](IdType k) -> Status {
+        IdType vertex_chunk_index = chunks[k].first;
+        IdType chunk_index = chunks[k].second;
+        IdType begin = vertex_chunk_index * vertex_chunk_size;
+        IdType end = std::min(begin + vertex_chunk_size, vertex_num);
+        IdType position = offsets[begin] + chunk_index * edge_chunk_size;
+        IdType length = std::min(edge_chunk_size, offsets[end] - position);
+        GAR_ASSIGN_OR_RAISE(
+            auto chunk_path,
+            edge_info.GetPropertyFilePath(property_group, adj_list_type,
+                                          vertex_chunk_index, chunk_index));
+        GAR_ASSIGN_OR_RAISE(
+            auto table,
+            fs->ReadFileToTable(out_prefix + chunk_path,
+                                property_group.GetFileType(), {property}));
+        if (table->num_rows() != length) {
+          return Status::Invalid(
+              "The property chunk " + chunk_path + " has " +
+              std::to_string(table->num_rows()) + " rows, but " +
+              std::to_string(length) + " are expected.");
+        }
+        GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+            auto datum,
+            arrow::compute::Cast(table->column(0), arrow::float64()));
+        for (const auto& chunk : datum.chunked_array()->chunks()) {
+          auto array = std::static_pointer_cast<arrow::DoubleArray>(chunk);
+          for (int64_t i = 0; i < array->length(); ++i) {
+            weights_data[position++] = array->IsNull(i) ? 0 : array->Value(i);
+          }
+        }
+        return Status::OK();
+      },
+      thread_num));
+  return weights;
+}
+
+Result<std::shared_ptr<arrow::Table>> GatherVertexProperties(
+    const VertexInfo& vertex_info, const std::string& prefix,
+    const std::shared_ptr<arrow::Int64Array>& vertices,
+    const std::vector<std::string>& properties, int thread_num) noexcept {
+  if (vertices == nullptr) {
+    return Status::Invalid("The vertices must not be null.");
+  }
+  // the requested properties of each property group
+  std::vector<std::pair<PropertyGroup, std::vector<std::string>>> groups;
+  std::vector<std::shared_ptr<arrow::Field>> fields;
+  for (const auto& property : properties) {
+    GAR_ASSIGN_OR_RAISE(const auto& property_group,
+                        vertex_info.GetPropertyGroup(property));
+    GAR_ASSIGN_OR_RAISE(auto type, vertex_info.GetPropertyType(property));
+    fields.push_back(
+        arrow::field(property, DataType::DataTypeToArrowDataType(type)));
+    auto it = std::find_if(
+        groups.begin(), groups.end(),
+        [&](const std::pair<PropertyGroup, std::vector<std::string>>& g) {
+          return g.first == property_group;
+        });
+    if (it == groups.end()) {
+      groups.emplace_back(property_group, std::vector<std::string>{property});
+    } else if (std::find(it->second.begin(), it->second.end(), property) ==
+               it->second.end()) {
+      it->second.push_back(property);
+    }
+  }
+  if (vertices->length() == 0) {
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        auto table, arrow::Table::MakeEmpty(arrow::schema(fields)));
+    return table;
+  }
+
+  GAR_ASSIGN_OR_RAISE(IdType vertex_num,
+                      utils::GetVertexNum(prefix, vertex_info));
+  std::string out_prefix;
+  GAR_ASSIGN_OR_RAISE(auto fs, FileSystemFromUriOrPath(prefix, &out_prefix));
+  IdType chunk_size = vertex_info.GetChunkSize();
+
+  // sort the vertices by id, and split them by chunk
+  int64_t length = vertices->length();
+  const int64_t* ids = vertices->raw_values();
+  std::vector<int64_t> order(length);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+            [ids](int64_t a, int64_t b) { return ids[a] < ids[b]; });
+  if (vertices->null_count() > 0 || ids[order.front()] < 0 ||
+      ids[order.back()] >= vertex_num) {
+    return Status::Invalid("The vertices are out of range.");
+  }
+  std::vector<int64_t> splits;
+  for (int64_t i = 0; i < length; ++i) {
+    if (i == 0 ||
+        ids[order[i]] / chunk_size != ids[order[i - 1]] / chunk_size) {
+      splits.push_back(i);
+    }
+  }
+  splits.push_back(length);
+
+  std::vector<std::shared_ptr<arrow::Table>> tables(splits.size() - 1);
+  GAR_RETURN_NOT_OK(util::ParallelFor(
+      0, tables.size(),
+      [&](IdType k) -> Status {
+        IdType chunk_index = ids[order[splits[k]]] / chunk_size;
+        std::vector<int64_t> rows;
+        for (int64_t i = splits[k]; i < splits[k + 1]; ++i) {
+          rows.push_back(ids[order[i]] - chunk_index * chunk_size);
+        }
+        std::vector<std::shared_ptr<arrow::Field>> chunk_fields;
+        std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
+        for (const auto& group : groups) {
+          GAR_ASSIGN_OR_RAISE(
+              auto chunk_path,
+              vertex_info.GetFilePath(group.first, chunk_index));
+          GAR_ASSIGN_OR_RAISE(
+              auto table,
+              fs->ReadFileToTable(out_prefix + chunk_path,
+                                  group.first.GetFileType(), group.second));
+          if (table->num_rows() <= rows.back()) {
+            return Status::Invalid("The vertex chunk " + chunk_path +
+                                   " is incomplete.");
+          }
+          GAR_ASSIGN_OR_RAISE(auto rows_table, TakeRows(table, rows));
+          for (int i = 0; i < rows_table->num_columns(); ++i) {
+            chunk_fields.push_back(rows_table->schema()->field(i));
+            columns.push_back(rows_table->column(i));
+          }
+        }
+        tables[k] = arrow::Table::Make(arrow::schema(chunk_fields), columns,
+                                       rows.size());
+        return Status::OK();
+      },
+      thread_num));
+
+  // restore the order of the vertices and of the properties
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto sorted_table,
+                                       arrow::ConcatenateTables(tables));
+  std::vector<int64_t> positions(length);
+  for (int64_t i = 0; i < length; ++i) {
+    positions[order[i]] = i;
+  }
+  GAR_ASSIGN_OR_RAISE(auto table, TakeRows(sorted_table, positions));
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      table, table->CombineChunks(arrow::default_memory_pool()));
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
+  fields.clear();
+  for (const auto& property : properties) {
+    int index = table->schema()->GetFieldIndex(property);
+    fields.push_back(table->schema()->field(index));
+    columns.push_back(table->column(index));
+  }
+  return arrow::Table::Make(arrow::schema(fields), columns, length);
+}
+
+}  // namespace GAR_NAMESPACE_INTERNAL
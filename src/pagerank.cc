@@ -0,0 +1,260 @@
+/** Copyright 2022 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "arrow/api.h"
+
+#include "gar/algorithm/pagerank.h"
+#include "gar/writer/arrow_chunk_writer.h"
+
+namespace GAR_NAMESPACE_INTERNAL {
+
+namespace {
+
+// the number of vertices updated by a thread at a time
+constexpr IdType kBlockSize = 1024;
+
+Status OutOfRange(IdType vid) {
+  return Status::Invalid("The source vertex " + std::to_string(vid) +
+                         " is out of range.");
+}
+
+/// Check that the in-neighbors are in the range of the vertices.
+template <typename AdjList>
+Status CheckInNeighbors(const AdjList& in_edges, int thread_num) {
+  IdType vertex_num = in_edges.GetVertexNum();
+  IdType block_num = (vertex_num + kBlockSize - 1) / kBlockSize;
+  return util::ParallelFor(
+      0, block_num,
+      [&](IdType block) -> Status {
+        IdType end = std::min((block + 1) * kBlockSize, vertex_num);
+        for (IdType vid = block * kBlockSize; vid < end; ++vid) {
+          IdType invalid = in_edges.FindNeighbor(vid, [&](IdType neighbor) {
+            return neighbor < 0 || neighbor >= vertex_num;
+          });
+          if (invalid != -1) {
+            return OutOfRange(invalid);
+          }
+        }
+        return Status::OK();
+      },
+      thread_num);
+}
+
+/// Count the out-degrees as the occurrences of the vertices as in-neighbors.
+/// Each thread counts a range of the vertices into its own histogram, and the
+/// histograms are summed by block.
+template <typename AdjList>
+Result<std::vector<IdType>> CountOutDegrees(const AdjList& in_edges,
+                                            int thread_num) {
+  IdType vertex_num = in_edges.GetVertexNum();
+  IdType block_num = (vertex_num + kBlockSize - 1) / kBlockSize;
+  if (thread_num <= 0) {
+    thread_num = std::max(1u, std::thread::hardware_concurrency());
+  }
+  // no more histograms than the edges per vertex, which bounds the memory
+  // of the histograms by the one of the edges
+  IdType histogram_num = std::max<IdType>(
+      1, std::min<IdType>({thread_num, block_num,
+                           in_edges.GetEdgeNum() / vertex_num}));
+  std::vector<std::vector<IdType>> histograms(histogram_num);
+  GAR_RETURN_NOT_OK(util::ParallelFor(
+      0, histogram_num,
+      [&](IdType i) -> Status {
+        auto& histogram = histograms[i];
+        histogram.assign(vertex_num, 0);
+        IdType end = vertex_num * (i + 1) / histogram_num;
+        for (IdType vid = vertex_num * i / histogram_num; vid < end; ++vid) {
+          IdType invalid = in_edges.FindNeighbor(vid, [&](IdType neighbor) {
+            if (neighbor < 0 || neighbor >= vertex_num) {
+              return true;
+            }
+            ++histogram[neighbor];
+            return false;
+          });
+          if (invalid != -1) {
+            return OutOfRange(invalid);
+          }
+        }
+        return Status::OK();
+      },
+      thread_num));
+
+  auto& out_degree = histograms[0];
+  if (histogram_num > 1) {
+    GAR_RETURN_NOT_OK(util::ParallelFor(
+        0, block_num,
+        [&](IdType block) -> Status {
+          IdType end = std::min((block + 1) * kBlockSize, vertex_num);
+          for (IdType i = 1; i < histogram_num; ++i) {
+            const auto& histogram = histograms[i];
+            for (IdType vid = block * kBlockSize; vid < end; ++vid) {
+              out_degree[vid] += histogram[vid];
+            }
+          }
+          return Status::OK();
+        },
+        thread_num));
+  }
+  return std::move(out_degree);
+}
+
+/// Run PageRank on a CSR or a CompressedCSR, with the out-degrees of the
+/// vertices, or empty ones to count them from the in-edges.
+template <typename AdjList>
+Result<PageRankResult> RunPageRank(const AdjList& in_edges,
+                                   std::vector<IdType> out_degree,
+                                   double damping, int max_iterations,
+                                   double tolerance, int thread_num) {
+  if (in_edges.GetAdjListType() != AdjListType::ordered_by_dest) {
+    return Status::Invalid(
+        "PageRank pulls along the incoming edges, which must be loaded from "
+        "the ordered_by_dest adj list.");
+  }
+  IdType vertex_num = in_edges.GetVertexNum();
+  PageRankResult result;
+  if (vertex_num == 0) {
+    return result;
+  }
+
+  if (out_degree.empty()) {
+    GAR_ASSIGN_OR_RAISE(out_degree, CountOutDegrees(in_edges, thread_num));
+  } else if (static_cast<IdType>(out_degree.size()) != vertex_num) {
+    return Status::Invalid(
+        "The out-degrees do not match the vertices of the incoming edges.");
+  } else {
+    GAR_RETURN_NOT_OK(CheckInNeighbors(in_edges, thread_num));
+  }
+
+  IdType block_num = (vertex_num + kBlockSize - 1) / kBlockSize;
+  double base = (1 - damping) / vertex_num;
+  std::vector<double> rank(vertex_num, 1 / static_cast<double>(vertex_num));
+  std::vector<double> next_rank(vertex_num), contribution(vertex_num);
+  std::vector<double> block_delta(block_num);
+  result.delta = tolerance;
+  while (result.iterations < max_iterations && result.delta >= tolerance) {
+    GAR_RETURN_NOT_OK(util::ParallelFor(
+        0, block_num,
+        [&](IdType block) -> Status {
+          IdType end = std::min((block + 1) * kBlockSize, vertex_num);
+          for (IdType vid = block * kBlockSize; vid < end; ++vid) {
+            contribution[vid] =
+                out_degree[vid] == 0 ? 0 : rank[vid] / out_degree[vid];
+          }
+          return Status::OK();
+        },
+        thread_num));
+    GAR_RETURN_NOT_OK(util::ParallelFor(
+        0, block_num,
+        [&](IdType block) -> Status {
+          IdType end = std::min((block + 1) * kBlockSize, vertex_num);
+          double delta = 0;
+          for (IdType vid = block * kBlockSize; vid < end; ++vid) {
+            double sum = 0;
+            in_edges.ForEachNeighbor(
+                vid, [&](IdType neighbor) { sum += contribution[neighbor]; });
+            double value = base + damping * sum;
+            if (out_degree[vid] == 0) {
+              value += damping * rank[vid];
+            }
+            next_rank[vid] = value;
+            delta += std::fabs(value - rank[vid]);
+          }
+          block_delta[block] = delta;
+          return Status::OK();
+        },
+        thread_num));
+    rank.swap(next_rank);
+    result.delta = 0;
+    for (auto delta : block_delta) {
+      result.delta += delta;
+    }
+    ++result.iterations;
+  }
+  result.rank = std::move(rank);
+  return result;
+}
+
+}  // namespace
+
+Result<PageRankResult> PageRank(const CSR& in_edges, double damping,
+                                int max_iterations, double tolerance,
+                                int thread_num) noexcept {
+  return RunPageRank(in_edges, {}, damping, max_iterations, tolerance,
+                     thread_num);
+}
+
+Result<PageRankResult> PageRank(const CompressedCSR& in_edges, double damping,
+                                int max_iterations, double tolerance,
+                                int thread_num) noexcept {
+  return RunPageRank(in_edges, {}, damping, max_iterations, tolerance,
+                     thread_num);
+}
+
+Result<PageRankResult> PageRank(const EdgeInfo& edge_info,
+                                const VertexInfo& vertex_info,
+                                const std::string& prefix, double damping,
+                                int max_iterations, double tolerance,
+                                int thread_num) noexcept {
+  if (edge_info.GetSrcLabel() != edge_info.GetDstLabel()) {
+    return Status::Invalid(
+        "The source and destination of the edges must be of the same "
+        "vertex type.");
+  }
+  GAR_ASSIGN_OR_RAISE(auto in_edges,
+                      LoadCSR(edge_info, vertex_info, prefix,
+                              AdjListType::ordered_by_dest, thread_num));
+  // the out-degrees are read from the offsets of the ordered_by_source adj
+  // list if there is one, or counted from the incoming edges
+  std::vector<IdType> out_degree;
+  if (edge_info.ContainAdjList(AdjListType::ordered_by_source)) {
+    GAR_ASSIGN_OR_RAISE(auto degrees,
+                        ComputeDegrees(edge_info, vertex_info, prefix,
+                                       AdjListType::ordered_by_source,
+                                       thread_num));
+    out_degree.assign(degrees->raw_values(),
+                      degrees->raw_values() + degrees->length());
+  }
+  return RunPageRank(in_edges, std::move(out_degree), damping,
+                     max_iterations, tolerance, thread_num);
+}
+
+Status WritePageRankResult(const PageRankResult& result,
+                           const VertexPropertyWriter& writer,
+                           const PropertyGroup& property_group) noexcept {
+  const auto& properties = property_group.GetProperties();
+  if (properties.size() != 1 ||
+      !(properties[0].type == DataType(Type::DOUBLE))) {
+    return Status::Invalid(
+        "The property group must contain a single double property for the "
+        "ranks.");
+  }
+  arrow::DoubleBuilder builder;
+  RETURN_NOT_ARROW_OK(builder.AppendValues(result.rank));
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto array, builder.Finish());
+  auto table = arrow::Table::Make(
+      arrow::schema({arrow::field(properties[0].name, arrow::float64())}),
+      {array});
+  return writer.WriteTable(table, property_group, 0);
+}
+
+}  // namespace GAR_NAMESPACE_INTERNAL
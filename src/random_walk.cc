@@ -0,0 +1,411 @@
+/** Copyright 2022 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "arrow/api.h"
+#include "arrow/io/api.h"
+#include "parquet/arrow/writer.h"
+
+#include "gar/algorithm/random_walk.h"
+#include "gar/utils/filesystem.h"
+#include "gar/utils/general_params.h"
+#include "gar/utils/property_column.h"
+#include "gar/utils/reader_utils.h"
+
+namespace GAR_NAMESPACE_INTERNAL {
+
+namespace {
+
+/// The out-going edges of the vertices of a vertex chunk.
+struct ChunkAdjList {
+  /// The offsets of the vertices in the chunk.
+  std::vector<IdType> offsets;
+  /// The neighbors of the vertices in the chunk.
+  std::vector<IdType> neighbors;
+};
+
+/// Read the ordered_by_source adjList of a vertex chunk, only the column of
+/// the destinations is read from the adjList chunks.
+Result<ChunkAdjList> ReadChunkAdjList(const EdgeInfo& edge_info,
+                                      const FileSystem& fs,
+                                      const std::string& prefix,
+                                      IdType vertex_chunk_index) {
+  constexpr AdjListType adj_list_type = AdjListType::ordered_by_source;
+  GAR_ASSIGN_OR_RAISE(auto file_type,
+                      edge_info.GetAdjListFileType(adj_list_type));
+  GAR_ASSIGN_OR_RAISE(
+      auto offset_path,
+      edge_info.GetAdjListOffsetFilePath(vertex_chunk_index, adj_list_type));
+  GAR_ASSIGN_OR_RAISE(auto offset_table,
+                      fs.ReadFileToTable(prefix + offset_path, file_type));
+  PropertyColumn<IdType> offsets(GeneralParams::kOffsetCol);
+  GAR_RETURN_NOT_OK(offsets.Bind(offset_table->column(0), vertex_chunk_index));
+  ChunkAdjList adj_list;
+  adj_list.offsets.resize(offsets.length());
+  for (int64_t i = 0; i < offsets.length(); ++i) {
+    adj_list.offsets[i] = offsets[i];
+  }
+  IdType edge_num = adj_list.offsets.empty() ? 0 : adj_list.offsets.back();
+  adj_list.neighbors.resize(edge_num);
+  IdType edge_chunk_size = edge_info.GetChunkSize();
+  for (IdType j = 0; j * edge_chunk_size < edge_num; ++j) {
+    GAR_ASSIGN_OR_RAISE(
+        auto chunk_path,
+        edge_info.GetAdjListFilePath(vertex_chunk_index, j, adj_list_type));
+    GAR_ASSIGN_OR_RAISE(auto chunk_table,
+                        fs.ReadFileToTable(prefix + chunk_path, file_type,
+                                           {GeneralParams::kDstIndexCol}));
+    PropertyColumn<IdType> dst(GeneralParams::kDstIndexCol);
+    GAR_RETURN_NOT_OK(dst.Bind(chunk_table, j));
+    IdType length = std::min(edge_chunk_size, edge_num - j * edge_chunk_size);
+    if (dst.length() != length) {
+      return Status::Invalid("The adj list chunk " + chunk_path + " has " +
+                             std::to_string(dst.length()) + " edges, but " +
+                             std::to_string(length) + " are expected.");
+    }
+    for (int64_t i = 0; i < length; ++i) {
+      adj_list.neighbors[j * edge_chunk_size + i] = dst[i];
+    }
+  }
+  return adj_list;
+}
+
+/// The adjLists of the vertex chunks read by the walkers, kept in a
+/// least-recently-used list within a budget of bytes, so that the rounds and
+/// both phases of a step share the chunks they read. The cache is
+/// thread-safe, the chunks are read out of the lock.
+class AdjListCache {
+ public:
+  AdjListCache(const EdgeInfo& edge_info, const FileSystem& fs,
+               const std::string& prefix, int64_t capacity)
+      : edge_info_(edge_info), fs_(fs), prefix_(prefix), capacity_(capacity) {}
+
+  /// Get the adjList of a vertex chunk, which stays valid after it is
+  /// evicted.
+  Result<std::shared_ptr<const ChunkAdjList>> Get(IdType vertex_chunk_index) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = chunks_.find(vertex_chunk_index);
+      if (it != chunks_.end()) {
+        lru_.splice(lru_.begin(), lru_, it->second.second);
+        return it->second.first;
+      }
+    }
+
+    GAR_ASSIGN_OR_RAISE(
+        auto adj_list,
+        ReadChunkAdjList(edge_info_, fs_, prefix_, vertex_chunk_index));
+    auto chunk = std::make_shared<const ChunkAdjList>(std::move(adj_list));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = chunks_.find(vertex_chunk_index);
+    if (it != chunks_.end()) {
+      return it->second.first;
+    }
+    lru_.push_front(vertex_chunk_index);
+    chunks_.emplace(vertex_chunk_index, std::make_pair(chunk, lru_.begin()));
+    bytes_ += Bytes(*chunk);
+    while (bytes_ > capacity_ && !lru_.empty()) {
+      auto evicted = chunks_.find(lru_.back());
+      bytes_ -= Bytes(*evicted->second.first);
+      chunks_.erase(evicted);
+      lru_.pop_back();
+    }
+    return chunk;
+  }
+
+ private:
+  static int64_t Bytes(const ChunkAdjList& adj_list) {
+    return (adj_list.offsets.size() + adj_list.neighbors.size()) *
+           sizeof(IdType);
+  }
+
+  const EdgeInfo& edge_info_;
+  const FileSystem& fs_;
+  const std::string& prefix_;
+  int64_t capacity_;
+  int64_t bytes_ = 0;
+  std::mutex mutex_;
+  std::list<IdType> lru_;  // the vertex chunk indices, most recent first
+  std::unordered_map<IdType, std::pair<std::shared_ptr<const ChunkAdjList>,
+                                       std::list<IdType>::iterator>>
+      chunks_;
+};
+
+/// The walkers grouped by vertex chunk, the walkers of chunks[i] are
+/// walkers[begins[i], begins[i + 1]).
+struct ChunkGroups {
+  std::vector<IdType> chunks;
+  std::vector<IdType> begins;
+  std::vector<IdType> walkers;
+};
+
+/// Group the walkers by the vertex chunk of a vertex of each, keeping their
+/// order in each chunk.
+template <typename Func>
+ChunkGroups GroupByChunk(const std::vector<IdType>& walkers,
+                         IdType vertex_chunk_num, IdType vertex_chunk_size,
+                         Func&& vertex_of) {
+  std::vector<IdType> counts(vertex_chunk_num + 1, 0);
+  for (auto walker : walkers) {
+    ++counts[vertex_of(walker) / vertex_chunk_size + 1];
+  }
+  ChunkGroups groups;
+  for (IdType i = 0; i < vertex_chunk_num; ++i) {
+    if (counts[i + 1] > 0) {
+      groups.chunks.push_back(i);
+      groups.begins.push_back(counts[i]);
+    }
+    counts[i + 1] += counts[i];
+  }
+  groups.begins.push_back(walkers.size());
+  groups.walkers.resize(walkers.size());
+  for (auto walker : walkers) {
+    groups.walkers[counts[vertex_of(walker) / vertex_chunk_size]++] = walker;
+  }
+  return groups;
+}
+
+}  // namespace
+
+Result<IdType> RandomWalk(const EdgeInfo& edge_info,
+                          const VertexInfo& vertex_info,
+                          const std::string& prefix,
+                          const std::string& output_path,
+                          const RandomWalkOptions& options,
+                          int thread_num) noexcept {
+  if (edge_info.GetSrcLabel() != vertex_info.GetLabel() ||
+      edge_info.GetDstLabel() != vertex_info.GetLabel()) {
+    return Status::Invalid(
+        "The source and destination of the edges must be of the vertex "
+        "type.");
+  }
+  if (!edge_info.ContainAdjList(AdjListType::ordered_by_source)) {
+    return Status::KeyError(
+        "The random walks need the ordered_by_source adj list.");
+  }
+  int walk_length = options.walk_length;
+  if (walk_length <= 0 || options.walks_per_vertex < 0 ||
+      options.batch_size <= 0 || options.cache_bytes < 0 ||
+      !(options.p > 0) || !(options.q > 0)) {
+    return Status::Invalid("The options of random walks are invalid.");
+  }
+  if (options.batch_size * walk_length > std::numeric_limits<int32_t>::max()) {
+    return Status::Invalid(
+        "The vertices of the walks of a batch exceed the limit of a list "
+        "array.");
+  }
+  GAR_ASSIGN_OR_RAISE(IdType vertex_num,
+                      utils::GetVertexNum(prefix, vertex_info));
+  std::string out_prefix;
+  GAR_ASSIGN_OR_RAISE(auto fs, FileSystemFromUriOrPath(prefix, &out_prefix));
+  IdType vertex_chunk_size = edge_info.GetSrcChunkSize();
+  IdType vertex_chunk_num =
+      (vertex_num + vertex_chunk_size - 1) / vertex_chunk_size;
+  bool biased = options.p != 1 || options.q != 1;
+  double max_weight = std::max({1 / options.p, 1.0, 1 / options.q});
+
+  // the walks are streamed to the file, a row group per batch
+  std::string output_file;
+  GAR_ASSIGN_OR_RAISE(auto output_fs,
+                      FileSystemFromUriOrPath(output_path, &output_file));
+  GAR_ASSIGN_OR_RAISE(auto output_stream,
+                      output_fs->OpenOutputStream(output_file));
+  auto schema = arrow::schema(
+      {arrow::field("walk", arrow::list(arrow::int64()), false)});
+  parquet::WriterProperties::Builder builder;
+  builder.compression(arrow::Compression::type::ZSTD);
+  std::unique_ptr<parquet::arrow::FileWriter> writer;
+  RETURN_NOT_ARROW_OK(parquet::arrow::FileWriter::Open(
+      *schema, arrow::default_memory_pool(), output_stream, builder.build(),
+      &writer));
+
+  IdType total = vertex_num * options.walks_per_vertex;
+  std::vector<IdType> walks, candidates;
+  std::vector<int32_t> lengths;
+  std::vector<char> accepted;
+  AdjListCache cache(edge_info, *fs, out_prefix, options.cache_bytes);
+  for (IdType batch_begin = 0; batch_begin < total;
+       batch_begin += options.batch_size) {
+    IdType walk_num = std::min(options.batch_size, total - batch_begin);
+    IdType batch = batch_begin / options.batch_size;
+    walks.resize(walk_num * walk_length);
+    lengths.assign(walk_num, 1);
+    candidates.resize(walk_num);
+    accepted.resize(walk_num);
+    for (IdType w = 0; w < walk_num; ++w) {
+      walks[w * walk_length] = (batch_begin + w) % vertex_num;
+    }
+    auto current = [&](IdType w) {
+      return walks[w * walk_length + lengths[w] - 1];
+    };
+    auto previous = [&](IdType w) {
+      return walks[w * walk_length + lengths[w] - 2];
+    };
+    auto make_engine = [&](int step, int round, int phase, IdType chunk) {
+      std::seed_seq seed_seq{static_cast<uint32_t>(options.random_seed),
+                             static_cast<uint32_t>(options.random_seed >> 32),
+                             static_cast<uint32_t>(batch),
+                             static_cast<uint32_t>(step),
+                             static_cast<uint32_t>(round),
+                             static_cast<uint32_t>(phase),
+                             static_cast<uint32_t>(chunk)};
+      return std::mt19937_64(seed_seq);
+    };
+
+    std::vector<IdType> active(walk_num);
+    std::iota(active.begin(), active.end(), 0);
+    for (int step = 1; step < walk_length && !active.empty(); ++step) {
+      std::vector<IdType> pending = std::move(active), proposed;
+      active.clear();
+      for (int round = 0; !pending.empty(); ++round) {
+        // draw a neighbor of the current vertex for each pending walker
+        auto groups = GroupByChunk(pending, vertex_chunk_num,
+                                   vertex_chunk_size, current);
+        GAR_RETURN_NOT_OK(util::ParallelFor(
+            0, groups.chunks.size(),
+            [&](IdType k) -> Status {
+              IdType chunk = groups.chunks[k];
+              GAR_ASSIGN_OR_RAISE(auto adj_list, cache.Get(chunk));
+              auto engine = make_engine(step, round, 0, chunk);
+              IdType base = chunk * vertex_chunk_size;
+              for (IdType i = groups.begins[k]; i < groups.begins[k + 1];
+                   ++i) {
+                IdType w = groups.walkers[i];
+                IdType local = current(w) - base;
+                if (static_cast<size_t>(local + 1) >=
+                    adj_list->offsets.size()) {
+                  return Status::Invalid("The offsets of the vertex chunk " +
+                                         std::to_string(chunk) +
+                                         " are incomplete.");
+                }
+                IdType begin = adj_list->offsets[local];
+                IdType degree = adj_list->offsets[local + 1] - begin;
+                candidates[w] = -1;
+                if (degree > 0) {
+                  std::uniform_int_distribution<IdType> distribution(
+                      0, degree - 1);
+                  candidates[w] =
+                      adj_list->neighbors[begin + distribution(engine)];
+                  if (candidates[w] < 0 || candidates[w] >= vertex_num) {
+                    return Status::Invalid(
+                        "The vertex " + std::to_string(candidates[w]) +
+                        " is out of range.");
+                  }
+                }
+              }
+              return Status::OK();
+            },
+            thread_num));
+        proposed.clear();
+        for (auto w : pending) {
+          if (candidates[w] >= 0) {
+            proposed.push_back(w);
+            accepted[w] = 1;
+          }
+        }
+
+        // accept or reject the candidates by the adjList of the previous
+        // vertices
+        if (biased && step > 1) {
+          auto groups = GroupByChunk(proposed, vertex_chunk_num,
+                                     vertex_chunk_size, previous);
+          GAR_RETURN_NOT_OK(util::ParallelFor(
+              0, groups.chunks.size(),
+              [&](IdType k) -> Status {
+                IdType chunk = groups.chunks[k];
+                GAR_ASSIGN_OR_RAISE(auto adj_list, cache.Get(chunk));
+                auto engine = make_engine(step, round, 1, chunk);
+                std::uniform_real_distribution<double> distribution(
+                    0, max_weight);
+                IdType base = chunk * vertex_chunk_size;
+                for (IdType i = groups.begins[k]; i < groups.begins[k + 1];
+                     ++i) {
+                  IdType w = groups.walkers[i];
+                  IdType t = previous(w), x = candidates[w];
+                  double weight = 1 / options.q;
+                  if (x == t) {
+                    weight = 1 / options.p;
+                  } else {
+                    IdType local = t - base;
+                    if (static_cast<size_t>(local + 1) >=
+                        adj_list->offsets.size()) {
+                      return Status::Invalid(
+                          "The offsets of the vertex chunk " +
+                          std::to_string(chunk) + " are incomplete.");
+                    }
+                    auto begin = adj_list->neighbors.begin() +
+                                 adj_list->offsets[local];
+                    auto end = adj_list->neighbors.begin() +
+                               adj_list->offsets[local + 1];
+                    if (std::find(begin, end, x) != end) {
+                      weight = 1;
+                    }
+                  }
+                  accepted[w] = distribution(engine) < weight;
+                }
+                return Status::OK();
+              },
+              thread_num));
+        }
+
+        pending.clear();
+        for (auto w : proposed) {
+          if (accepted[w]) {
+            walks[w * walk_length + lengths[w]++] = candidates[w];
+            active.push_back(w);
+          } else {
+            pending.push_back(w);
+          }
+        }
+      }
+    }
+
+    // write the walks of the batch, without the unused tails
+    arrow::Int32Builder offset_builder;
+    arrow::Int64Builder value_builder;
+    RETURN_NOT_ARROW_OK(offset_builder.Append(0));
+    int32_t offset = 0;
+    for (IdType w = 0; w < walk_num; ++w) {
+      RETURN_NOT_ARROW_OK(value_builder.AppendValues(
+          walks.data() + w * walk_length, lengths[w]));
+      offset += lengths[w];
+      RETURN_NOT_ARROW_OK(offset_builder.Append(offset));
+    }
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto offsets,
+                                         offset_builder.Finish());
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto values, value_builder.Finish());
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        auto walk_array, arrow::ListArray::FromArrays(*offsets, *values));
+    auto table = arrow::Table::Make(schema, {walk_array});
+    RETURN_NOT_ARROW_OK(writer->WriteTable(*table, walk_num));
+  }
+  RETURN_NOT_ARROW_OK(writer->Close());
+  RETURN_NOT_ARROW_OK(output_stream->Close());
+  return total;
+}
+
+}  // namespace GAR_NAMESPACE_INTERNAL
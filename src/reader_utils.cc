@@ -13,6 +13,9 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 
+#include <algorithm>
+#include <vector>
+
 #include "arrow/adapters/orc/adapter.h"
 #include "arrow/api.h"
 #include "arrow/csv/api.h"
@@ -68,6 +71,48 @@ Result<std::pair<IdType, IdType>> GetAdjListOffsetOfVertex(
                         static_cast<IdType>(array->Value(1)));
 }
 
+/**
+ * @brief get the property groups which contain the given properties
+ *
+ * @param edge_info edge info
+ * @param adj_list_type adj list type of the property groups
+ * @param properties names of the properties
+ *
+ * @return the property groups, each group appears once and in the order of
+ * the first property it contains
+ */
+Result<std::vector<PropertyGroup>> GetPropertyGroupsOfProperties(
+    const EdgeInfo& edge_info, AdjListType adj_list_type,
+    const std::vector<std::string>& properties) noexcept {
+  std::vector<PropertyGroup> property_groups;
+  for (const auto& property : properties) {
+    GAR_ASSIGN_OR_RAISE(const auto& pg,
+                        edge_info.GetPropertyGroup(property, adj_list_type));
+    if (std::find(property_groups.begin(), property_groups.end(), pg) ==
+        property_groups.end()) {
+      property_groups.push_back(pg);
+    }
+  }
+  return property_groups;
+}
+
+/**
+ * @brief get the number of vertices of a vertex type
+ *
+ * @param prefix prefix of the payload files
+ * @param vertex_info vertex info
+ *
+ * @return the number of vertices
+ */
+Result<IdType> GetVertexNum(const std::string& prefix,
+                            const VertexInfo& vertex_info) noexcept {
+  std::string out_prefix;
+  GAR_ASSIGN_OR_RAISE(auto fs, FileSystemFromUriOrPath(prefix, &out_prefix));
+  GAR_ASSIGN_OR_RAISE(auto vertex_num_path,
+                      vertex_info.GetVerticesNumFilePath());
+  return fs->ReadFileToValue<IdType>(out_prefix + vertex_num_path);
+}
+
 }  // namespace utils
 
 }  // namespace GAR_NAMESPACE_INTERNAL
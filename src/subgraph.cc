@@ -0,0 +1,379 @@
+/** Copyright 2022 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "arrow/api.h"
+#include "arrow/compute/api.h"
+
+#include "gar/algorithm/subgraph.h"
+#include "gar/utils/general_params.h"
+#include "gar/writer/arrow_chunk_writer.h"
+
+namespace GAR_NAMESPACE_INTERNAL {
+
+namespace {
+
+/// The ranks of the set bits of a bitmap, which are the new ids of the
+/// selected vertices.
+class RankIndex {
+ public:
+  explicit RankIndex(const util::Bitmap& bitmap)
+      : bitmap_(bitmap), word_ranks_(bitmap.word_num() + 1, 0) {
+    for (IdType i = 0; i < bitmap.word_num(); ++i) {
+      word_ranks_[i + 1] =
+          word_ranks_[i] + __builtin_popcountll(bitmap.GetWord(i));
+    }
+  }
+
+  /// Get the number of set bits.
+  IdType Count() const noexcept { return word_ranks_.back(); }
+
+  /// Get the number of set bits before an index.
+  IdType Rank(IdType index) const noexcept {
+    uint64_t word = bitmap_.GetWord(index >> 6) &
+                    ((uint64_t(1) << (index & 63)) - 1);
+    return word_ranks_[index >> 6] + __builtin_popcountll(word);
+  }
+
+  /// Get the index of the k-th set bit, counting from 0.
+  IdType Select(IdType k) const noexcept {
+    IdType w = std::upper_bound(word_ranks_.begin(), word_ranks_.end(), k) -
+               word_ranks_.begin() - 1;
+    uint64_t word = bitmap_.GetWord(w);
+    for (IdType r = k - word_ranks_[w]; r > 0; --r) {
+      word &= word - 1;
+    }
+    return w * 64 + __builtin_ctzll(word);
+  }
+
+ private:
+  const util::Bitmap& bitmap_;
+  std::vector<IdType> word_ranks_;
+};
+
+/// Take the rows of a table.
+Result<std::shared_ptr<arrow::Table>> TakeRows(
+    const std::shared_ptr<arrow::Table>& table,
+    const std::vector<int64_t>& rows) {
+  arrow::Int64Builder builder;
+  RETURN_NOT_ARROW_OK(builder.AppendValues(rows));
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto indices, builder.Finish());
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto datum,
+                                       arrow::compute::Take(table, indices));
+  return datum.table();
+}
+
+/// Concatenate the tables with the same schema.
+Result<std::shared_ptr<arrow::Table>> Concatenate(
+    const std::vector<std::shared_ptr<arrow::Table>>& tables) {
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto table,
+                                       arrow::ConcatenateTables(tables));
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      table, table->CombineChunks(arrow::default_memory_pool()));
+  return table;
+}
+
+/// Write a chunk of the new vertices, which comes from the original vertex
+/// chunks covering the selected vertices of the chunk.
+Status WriteVertexChunk(const VertexInfo& vertex_info,
+                        const std::shared_ptr<FileSystem>& fs,
+                        const std::string& prefix, const util::Bitmap& selected,
+                        const RankIndex& index,
+                        const VertexPropertyWriter& writer,
+                        IdType chunk_index) {
+  IdType chunk_size = vertex_info.GetChunkSize();
+  IdType begin = chunk_index * chunk_size;
+  IdType end = std::min(begin + chunk_size, index.Count());
+  IdType first = index.Select(begin), last = index.Select(end - 1);
+  for (const auto& property_group : vertex_info.GetPropertyGroups()) {
+    std::vector<std::shared_ptr<arrow::Table>> tables;
+    for (IdType i = first / chunk_size; i <= last / chunk_size; ++i) {
+      GAR_ASSIGN_OR_RAISE(auto chunk_path,
+                          vertex_info.GetFilePath(property_group, i));
+      GAR_ASSIGN_OR_RAISE(auto table,
+                          fs->ReadFileToTable(prefix + chunk_path,
+                                              property_group.GetFileType()));
+      IdType base = i * chunk_size;
+      IdType vid_end = std::min(base + table->num_rows(), last + 1);
+      std::vector<int64_t> rows;
+      for (IdType vid = std::max(base, first); vid < vid_end; ++vid) {
+        if (selected.Get(vid)) {
+          rows.push_back(vid - base);
+        }
+      }
+      GAR_ASSIGN_OR_RAISE(auto rows_table, TakeRows(table, rows));
+      tables.push_back(std::move(rows_table));
+    }
+    GAR_ASSIGN_OR_RAISE(auto chunk_table, Concatenate(tables));
+    if (chunk_table->num_rows() != end - begin) {
+      return Status::Invalid("The vertex chunk " + std::to_string(chunk_index) +
+                             " of the property group " +
+                             property_group.GetPrefix() + " is incomplete.");
+    }
+    GAR_RETURN_NOT_OK(writer.WriteChunk(chunk_table, property_group,
+                                        chunk_index));
+  }
+  return Status::OK();
+}
+
+/// Write the edges of a chunk of the new vertices, which come from the
+/// original adjList chunks of the vertex chunks covering the selected
+/// vertices of the chunk.
+Status WriteEdgeChunk(const EdgeInfo& edge_info, AdjListType adj_list_type,
+                      const std::shared_ptr<FileSystem>& fs,
+                      const std::string& prefix, IdType vertex_chunk_num,
+                      const util::Bitmap& selected, const RankIndex& index,
+                      const EdgeChunkWriter& writer,
+                      IdType vertex_chunk_index) {
+  bool by_source = adj_list_type == AdjListType::ordered_by_source ||
+                   adj_list_type == AdjListType::unordered_by_source;
+  bool ordered = adj_list_type == AdjListType::ordered_by_source ||
+                 adj_list_type == AdjListType::ordered_by_dest;
+  IdType vertex_chunk_size =
+      by_source ? edge_info.GetSrcChunkSize() : edge_info.GetDstChunkSize();
+  IdType edge_chunk_size = edge_info.GetChunkSize();
+  IdType begin = vertex_chunk_index * vertex_chunk_size;
+  IdType end = std::min(begin + vertex_chunk_size, index.Count());
+  IdType first = index.Select(begin), last = index.Select(end - 1);
+  GAR_ASSIGN_OR_RAISE(auto file_type,
+                      edge_info.GetAdjListFileType(adj_list_type));
+  GAR_ASSIGN_OR_RAISE(const auto& property_groups,
+                      edge_info.GetPropertyGroups(adj_list_type));
+  GAR_ASSIGN_OR_RAISE(auto adj_list_dir,
+                      edge_info.GetAdjListDirPath(adj_list_type));
+
+  std::vector<int64_t> new_sources, new_destinations;
+  std::vector<std::vector<std::shared_ptr<arrow::Table>>> property_tables(
+      property_groups.size());
+  IdType last_chunk = std::min(last / vertex_chunk_size, vertex_chunk_num - 1);
+  for (IdType i = first / vertex_chunk_size; i <= last_chunk; ++i) {
+    IdType base = i * vertex_chunk_size;
+    // the rows of the edges of the covered vertices in the vertex chunk
+    IdType row_begin = 0, row_end = -1, chunk_num;
+    if (ordered) {
+      GAR_ASSIGN_OR_RAISE(
+          auto offset_path,
+          edge_info.GetAdjListOffsetFilePath(i, adj_list_type));
+      GAR_ASSIGN_OR_RAISE(auto offset_table,
+                          fs->ReadFileToTable(prefix + offset_path, file_type));
+      PropertyColumn<IdType> offsets(GeneralParams::kOffsetCol);
+      GAR_RETURN_NOT_OK(offsets.Bind(offset_table->column(0), i));
+      IdType length = offsets.length() - 1;
+      row_begin = offsets[std::min(std::max(first - base, IdType(0)), length)];
+      row_end = offsets[std::min(last + 1 - base, length)];
+      chunk_num = (offsets[length] + edge_chunk_size - 1) / edge_chunk_size;
+    } else {
+      std::string chunk_dir =
+          prefix + adj_list_dir + "/part" + std::to_string(i);
+      GAR_ASSIGN_OR_RAISE(chunk_num, fs->GetFileNumOfDir(chunk_dir));
+    }
+    IdType first_edge_chunk = ordered ? row_begin / edge_chunk_size : 0;
+    IdType last_edge_chunk =
+        ordered ? (row_end - 1) / edge_chunk_size : chunk_num - 1;
+    if (ordered && row_begin >= row_end) {
+      continue;
+    }
+    for (IdType j = first_edge_chunk; j <= last_edge_chunk; ++j) {
+      GAR_ASSIGN_OR_RAISE(auto chunk_path,
+                          edge_info.GetAdjListFilePath(i, j, adj_list_type));
+      GAR_ASSIGN_OR_RAISE(auto chunk_table,
+                          fs->ReadFileToTable(prefix + chunk_path, file_type));
+      PropertyColumn<IdType> src(GeneralParams::kSrcIndexCol);
+      PropertyColumn<IdType> dst(GeneralParams::kDstIndexCol);
+      GAR_RETURN_NOT_OK(src.Bind(chunk_table, j));
+      GAR_RETURN_NOT_OK(dst.Bind(chunk_table, j));
+      int64_t chunk_begin = 0, chunk_end = src.length();
+      if (ordered) {
+        chunk_begin = std::max(row_begin - j * edge_chunk_size, IdType(0));
+        chunk_end = std::min(row_end - j * edge_chunk_size, chunk_end);
+      }
+      std::vector<int64_t> rows;
+      for (int64_t row = chunk_begin; row < chunk_end; ++row) {
+        IdType u = src[row], v = dst[row];
+        if (u < 0 || u >= selected.size() || v < 0 || v >= selected.size()) {
+          return Status::Invalid("The edge (" + std::to_string(u) + ", " +
+                                 std::to_string(v) +
+                                 ") has a vertex out of range.");
+        }
+        IdType vid = by_source ? u : v;
+        if (vid >= first && vid <= last && selected.Get(u) &&
+            selected.Get(v)) {
+          rows.push_back(row);
+          new_sources.push_back(index.Rank(u));
+          new_destinations.push_back(index.Rank(v));
+        }
+      }
+      for (size_t k = 0; k < property_groups.size(); ++k) {
+        GAR_ASSIGN_OR_RAISE(auto property_path,
+                            edge_info.GetPropertyFilePath(
+                                property_groups[k], adj_list_type, i, j));
+        GAR_ASSIGN_OR_RAISE(
+            auto property_table,
+            fs->ReadFileToTable(prefix + property_path,
+                                property_groups[k].GetFileType()));
+        GAR_ASSIGN_OR_RAISE(auto rows_table, TakeRows(property_table, rows));
+        property_tables[k].push_back(std::move(rows_table));
+      }
+    }
+  }
+
+  // the edges are in the order of the original ones, so the edges of the
+  // ordered adjList are still sorted after the renumbering
+  if (ordered) {
+    const auto& vertices = by_source ? new_sources : new_destinations;
+    arrow::Int64Builder builder;
+    RETURN_NOT_ARROW_OK(builder.Append(0));
+    size_t edge_index = 0;
+    for (IdType vid = begin; vid < end; ++vid) {
+      while (edge_index < vertices.size() && vertices[edge_index] == vid) {
+        ++edge_index;
+      }
+      RETURN_NOT_ARROW_OK(builder.Append(edge_index));
+    }
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto offset_array, builder.Finish());
+    auto offset_table = arrow::Table::Make(
+        arrow::schema({arrow::field(GeneralParams::kOffsetCol,
+                                    arrow::int64())}),
+        {offset_array});
+    GAR_RETURN_NOT_OK(
+        writer.WriteOffsetChunk(offset_table, vertex_chunk_index));
+  }
+  if (new_sources.empty()) {
+    return Status::OK();
+  }
+
+  std::vector<std::shared_ptr<arrow::Field>> fields;
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
+  for (const auto* ids : {&new_sources, &new_destinations}) {
+    arrow::Int64Builder builder;
+    RETURN_NOT_ARROW_OK(builder.AppendValues(*ids));
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto array, builder.Finish());
+    columns.push_back(std::make_shared<arrow::ChunkedArray>(array));
+  }
+  fields.push_back(arrow::field(GeneralParams::kSrcIndexCol, arrow::int64()));
+  fields.push_back(arrow::field(GeneralParams::kDstIndexCol, arrow::int64()));
+  for (const auto& tables : property_tables) {
+    GAR_ASSIGN_OR_RAISE(auto table, Concatenate(tables));
+    for (int k = 0; k < table->num_columns(); ++k) {
+      fields.push_back(table->schema()->field(k));
+      columns.push_back(table->column(k));
+    }
+  }
+  auto table = arrow::Table::Make(arrow::schema(fields), columns,
+                                  new_sources.size());
+  return writer.WriteTable(table, vertex_chunk_index, 0);
+}
+
+}  // namespace
+
+Result<GraphInfo> ExtractInducedSubgraph(const GraphInfo& graph_info,
+                                         const std::string& label,
+                                         const util::Bitmap& selected,
+                                         const std::string& output_prefix,
+                                         int thread_num) noexcept {
+  GAR_ASSIGN_OR_RAISE(const auto& vertex_info,
+                      graph_info.GetVertexInfo(label));
+  GAR_ASSIGN_OR_RAISE(IdType vertex_num,
+                      utils::GetVertexNum(graph_info.GetPrefix(), vertex_info));
+  if (selected.size() != vertex_num) {
+    return Status::Invalid("The bitmap has " + std::to_string(selected.size()) +
+                           " bits, but there are " +
+                           std::to_string(vertex_num) + " vertices.");
+  }
+  std::string prefix;
+  GAR_ASSIGN_OR_RAISE(auto fs,
+                      FileSystemFromUriOrPath(graph_info.GetPrefix(), &prefix));
+  std::string new_prefix = output_prefix;
+  if (new_prefix.empty() || new_prefix.back() != '/') {
+    new_prefix += "/";
+  }
+  RankIndex index(selected);
+  IdType new_vertex_num = index.Count();
+
+  GraphInfo new_graph_info(graph_info.GetName(), graph_info.GetVersion(),
+                           new_prefix);
+  GAR_RETURN_NOT_OK(new_graph_info.AddVertex(vertex_info));
+  std::string vertex_info_path = label + ".vertex.yml";
+  GAR_RETURN_NOT_OK(vertex_info.Save(new_prefix + vertex_info_path));
+  new_graph_info.AddVertexInfoPath(vertex_info_path);
+
+  // write the vertices
+  VertexPropertyWriter vertex_writer(vertex_info, new_prefix);
+  GAR_RETURN_NOT_OK(vertex_writer.WriteVerticesNum(new_vertex_num));
+  IdType chunk_size = vertex_info.GetChunkSize();
+  GAR_RETURN_NOT_OK(util::ParallelFor(
+      0, (new_vertex_num + chunk_size - 1) / chunk_size,
+      [&](IdType i) -> Status {
+        return WriteVertexChunk(vertex_info, fs, prefix, selected, index,
+                                vertex_writer, i);
+      },
+      thread_num));
+
+  // write the edges between the vertices
+  for (const auto& item : graph_info.GetAllEdgeInfo()) {
+    const auto& edge_info = item.second;
+    if (edge_info.GetSrcLabel() != label || edge_info.GetDstLabel() != label) {
+      continue;
+    }
+    for (auto adj_list_type :
+         {AdjListType::ordered_by_source, AdjListType::ordered_by_dest,
+          AdjListType::unordered_by_source, AdjListType::unordered_by_dest}) {
+      if (!edge_info.ContainAdjList(adj_list_type)) {
+        continue;
+      }
+      bool by_source = adj_list_type == AdjListType::ordered_by_source ||
+                       adj_list_type == AdjListType::unordered_by_source;
+      IdType vertex_chunk_size = by_source ? edge_info.GetSrcChunkSize()
+                                           : edge_info.GetDstChunkSize();
+      GAR_ASSIGN_OR_RAISE(auto adj_list_dir,
+                          edge_info.GetAdjListDirPath(adj_list_type));
+      GAR_ASSIGN_OR_RAISE(IdType vertex_chunk_num,
+                          fs->GetFileNumOfDir(prefix + adj_list_dir));
+      if (adj_list_type == AdjListType::ordered_by_source ||
+          adj_list_type == AdjListType::ordered_by_dest) {
+        GAR_ASSIGN_OR_RAISE(auto offset_dir,
+                            edge_info.GetAdjListOffsetDirPath(adj_list_type));
+        GAR_ASSIGN_OR_RAISE(vertex_chunk_num,
+                            fs->GetFileNumOfDir(prefix + offset_dir));
+      }
+      EdgeChunkWriter edge_writer(edge_info, new_prefix, adj_list_type);
+      GAR_RETURN_NOT_OK(util::ParallelFor(
+          0, (new_vertex_num + vertex_chunk_size - 1) / vertex_chunk_size,
+          [&](IdType i) -> Status {
+            return WriteEdgeChunk(edge_info, adj_list_type, fs, prefix,
+                                  vertex_chunk_num, selected, index,
+                                  edge_writer, i);
+          },
+          thread_num));
+    }
+    GAR_RETURN_NOT_OK(new_graph_info.AddEdge(edge_info));
+    std::string edge_info_path = edge_info.GetSrcLabel() + "_" +
+                                 edge_info.GetEdgeLabel() + "_" +
+                                 edge_info.GetDstLabel() + ".edge.yml";
+    GAR_RETURN_NOT_OK(edge_info.Save(new_prefix + edge_info_path));
+    new_graph_info.AddEdgeInfoPath(edge_info_path);
+  }
+
+  GAR_RETURN_NOT_OK(new_graph_info.Save(new_prefix + graph_info.GetName() +
+                                        ".graph.yml"));
+  return new_graph_info;
+}
+
+}  // namespace GAR_NAMESPACE_INTERNAL
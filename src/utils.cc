@@ -13,10 +13,19 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <numeric>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "arrow/api.h"
+#include "arrow/compute/api.h"
 
 #include "gar/utils/utils.h"
 
@@ -24,6 +33,281 @@ namespace GAR_NAMESPACE_INTERNAL {
 
 namespace util {
 
+Status ParallelFor(IdType begin, IdType end,
+                   const std::function<Status(IdType)>& task,
+                   int thread_num) {
+  if (begin >= end) {
+    return Status::OK();
+  }
+  if (thread_num <= 0) {
+    thread_num = std::max(1u, std::thread::hardware_concurrency());
+  }
+  thread_num = static_cast<int>(
+      std::min(static_cast<IdType>(thread_num), end - begin));
+  std::atomic<IdType> next(begin);
+  std::atomic<bool> failed(false);
+  std::mutex mutex;
+  Status status = Status::OK();
+  auto worker = [&]() {
+    while (!failed.load(std::memory_order_relaxed)) {
+      IdType index = next.fetch_add(1, std::memory_order_relaxed);
+      if (index >= end) {
+        break;
+      }
+      Status s = task(index);
+      if (!s.ok()) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!failed.exchange(true)) {
+          status = std::move(s);
+        }
+      }
+    }
+  };
+  if (thread_num == 1) {
+    worker();
+    return status;
+  }
+  std::vector<std::thread> threads;
+  threads.reserve(thread_num - 1);
+  for (int i = 1; i < thread_num; ++i) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return status;
+}
+
+Status SortIndices(const int64_t* keys, int64_t length, int64_t* indices,
+                   int thread_num) {
+  if (length <= 0) {
+    return Status::OK();
+  }
+  if (thread_num <= 0) {
+    thread_num = std::max(1u, std::thread::hardware_concurrency());
+  }
+  // a block of keys per thread, of at least 64K keys
+  constexpr int64_t kMinBlockSize = 1 << 16;
+  int64_t block_num = std::max<int64_t>(
+      1, std::min<int64_t>(thread_num, length / kMinBlockSize));
+  int64_t block_size = (length + block_num - 1) / block_num;
+  block_num = (length + block_size - 1) / block_size;
+
+  // the keys are biased to unsigned, and sorted by their distances to the
+  // smallest key, so that only the varying bytes are sorted
+  auto biased = [](int64_t key) {
+    return static_cast<uint64_t>(key) ^ (static_cast<uint64_t>(1) << 63);
+  };
+  std::vector<uint64_t> block_min(block_num), block_max(block_num);
+  GAR_RETURN_NOT_OK(ParallelFor(
+      0, block_num,
+      [&](IdType b) -> Status {
+        int64_t begin = b * block_size,
+                end = std::min(begin + block_size, length);
+        uint64_t min = biased(keys[begin]), max = min;
+        for (int64_t i = begin + 1; i < end; ++i) {
+          min = std::min(min, biased(keys[i]));
+          max = std::max(max, biased(keys[i]));
+        }
+        block_min[b] = min;
+        block_max[b] = max;
+        return Status::OK();
+      },
+      thread_num));
+  uint64_t min = *std::min_element(block_min.begin(), block_min.end());
+  uint64_t range =
+      *std::max_element(block_max.begin(), block_max.end()) - min;
+  int pass_num = 0;
+  while (pass_num < 8 && (range >> (8 * pass_num)) != 0) {
+    ++pass_num;
+  }
+  if (pass_num == 0) {
+    std::iota(indices, indices + length, 0);
+    return Status::OK();
+  }
+
+  // the passes ping-pong between two buffers of the keys and of the indices,
+  // and the last pass writes to the output
+  std::vector<uint64_t> key_buffers[2];
+  key_buffers[0].resize(pass_num > 1 ? length : 0);
+  key_buffers[1].resize(pass_num > 2 ? length : 0);
+  std::vector<int64_t> index_buffer(pass_num > 1 ? length : 0);
+  std::vector<std::array<int64_t, 256>> offsets(block_num);
+  const uint64_t* src_keys = nullptr;
+  const int64_t* src_indices = nullptr;
+  for (int pass = 0; pass < pass_num; ++pass) {
+    int shift = 8 * pass;
+    bool last = pass + 1 == pass_num;
+    uint64_t* dst_keys = last ? nullptr : key_buffers[pass % 2].data();
+    int64_t* dst_indices =
+        (pass_num - 1 - pass) % 2 == 0 ? indices : index_buffer.data();
+    auto key_at = [&](int64_t i) {
+      return src_keys == nullptr ? biased(keys[i]) - min : src_keys[i];
+    };
+    // count the digits of each block
+    GAR_RETURN_NOT_OK(ParallelFor(
+        0, block_num,
+        [&](IdType b) -> Status {
+          auto& counts = offsets[b];
+          counts.fill(0);
+          int64_t begin = b * block_size,
+                  end = std::min(begin + block_size, length);
+          for (int64_t i = begin; i < end; ++i) {
+            ++counts[(key_at(i) >> shift) & 255];
+          }
+          return Status::OK();
+        },
+        thread_num));
+    // the blocks of a digit are placed in order, to keep the sort stable
+    int64_t offset = 0;
+    for (int digit = 0; digit < 256; ++digit) {
+      for (int64_t b = 0; b < block_num; ++b) {
+        int64_t count = offsets[b][digit];
+        offsets[b][digit] = offset;
+        offset += count;
+      }
+    }
+    GAR_RETURN_NOT_OK(ParallelFor(
+        0, block_num,
+        [&](IdType b) -> Status {
+          auto& positions = offsets[b];
+          int64_t begin = b * block_size,
+                  end = std::min(begin + block_size, length);
+          for (int64_t i = begin; i < end; ++i) {
+            uint64_t key = key_at(i);
+            int64_t position = positions[(key >> shift) & 255]++;
+            dst_indices[position] = src_indices == nullptr ? i : src_indices[i];
+            if (dst_keys != nullptr) {
+              dst_keys[position] = key;
+            }
+          }
+          return Status::OK();
+        },
+        thread_num));
+    src_keys = dst_keys;
+    src_indices = dst_indices;
+  }
+  return Status::OK();
+}
+
+Result<std::shared_ptr<arrow::Table>> TakeTable(
+    const std::shared_ptr<arrow::Table>& table,
+    const std::shared_ptr<arrow::Int64Array>& indices, int thread_num) {
+  if (thread_num <= 0) {
+    thread_num = std::max(1u, std::thread::hardware_concurrency());
+  }
+  int num_columns = table->num_columns();
+  int64_t length = indices->length();
+  if (length == 0) {
+    std::vector<std::shared_ptr<arrow::Array>> empty_columns;
+    for (int c = 0; c < num_columns; ++c) {
+      GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+          auto empty, arrow::MakeArrayOfNull(table->field(c)->type(), 0));
+      empty_columns.push_back(std::move(empty));
+    }
+    return arrow::Table::Make(table->schema(), empty_columns, 0);
+  }
+  // the columns are combined once, rather than by the take of every slice
+  std::vector<std::shared_ptr<arrow::Array>> columns(num_columns);
+  GAR_RETURN_NOT_OK(ParallelFor(
+      0, num_columns,
+      [&](IdType c) -> Status {
+        const auto& column = table->column(c);
+        if (column->num_chunks() == 0) {
+          // a column without chunks is empty, and any index is out of bounds
+          GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+              columns[c], arrow::MakeArrayOfNull(column->type(), 0));
+        } else if (column->num_chunks() == 1) {
+          columns[c] = column->chunk(0);
+        } else {
+          GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+              columns[c], arrow::Concatenate(column->chunks()));
+        }
+        return Status::OK();
+      },
+      thread_num));
+  // a few slices per thread, of at least 64K rows
+  constexpr int64_t kMinSliceSize = 1 << 16;
+  int64_t slice_num = std::max<int64_t>(
+      1, std::min<int64_t>(4 * thread_num, length / kMinSliceSize));
+  int64_t slice_size = (length + slice_num - 1) / slice_num;
+  slice_num = std::max<int64_t>(1, (length + slice_size - 1) / slice_size);
+  std::vector<arrow::ArrayVector> chunks(num_columns,
+                                         arrow::ArrayVector(slice_num));
+  GAR_RETURN_NOT_OK(ParallelFor(
+      0, num_columns * slice_num,
+      [&](IdType task) -> Status {
+        int64_t c = task / slice_num, s = task % slice_num;
+        auto slice = indices->Slice(s * slice_size, slice_size);
+        GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+            auto datum, arrow::compute::Take(columns[c], slice));
+        chunks[c][s] = datum.make_array();
+        return Status::OK();
+      },
+      thread_num));
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> chunked_arrays;
+  for (int c = 0; c < num_columns; ++c) {
+    chunked_arrays.push_back(std::make_shared<arrow::ChunkedArray>(
+        std::move(chunks[c]), table->field(c)->type()));
+  }
+  return arrow::Table::Make(table->schema(), chunked_arrays, length);
+}
+
+namespace {
+
+/// Count the ids in [begin, begin + num) into counts[1..num], while the ids
+/// out of the range go to counts[num + 1], so the loop has no branch.
+template <bool kHasNulls>
+void CountIds(const int64_t* ids, const arrow::Array* array, int64_t length,
+              IdType begin, IdType num, int64_t* counts) {
+  uint64_t base = static_cast<uint64_t>(begin), range = num;
+  for (int64_t i = 0; i < length; ++i) {
+    uint64_t local = static_cast<uint64_t>(ids[i]) - base;
+    bool counted = local < range;
+    if constexpr (kHasNulls) {
+      counted = counted && array->IsValid(i);
+    }
+    ++counts[counted ? local + 1 : range + 1];
+  }
+}
+
+}  // namespace
+
+void ComputeOffsets(const int64_t* ids, int64_t length, IdType begin,
+                    IdType num, int64_t* offsets) {
+  std::vector<int64_t> counts(num + 2, 0);
+  CountIds<false>(ids, nullptr, length, begin, num, counts.data());
+  std::partial_sum(counts.begin(), counts.begin() + num + 1, offsets);
+}
+
+Result<std::shared_ptr<arrow::Int64Array>> ComputeOffsets(
+    const std::shared_ptr<arrow::ChunkedArray>& ids, IdType begin,
+    IdType num) {
+  if (!ids->type()->Equals(arrow::int64())) {
+    return Status::TypeError("The vertex ids must be of type int64, not " +
+                             ids->type()->ToString() + ".");
+  }
+  std::vector<int64_t> counts(num + 2, 0);
+  for (const auto& chunk : ids->chunks()) {
+    const int64_t* values =
+        std::static_pointer_cast<arrow::Int64Array>(chunk)->raw_values();
+    if (chunk->null_count() == 0) {
+      CountIds<false>(values, chunk.get(), chunk->length(), begin, num,
+                      counts.data());
+    } else {
+      CountIds<true>(values, chunk.get(), chunk->length(), begin, num,
+                     counts.data());
+    }
+  }
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      std::shared_ptr<arrow::Buffer> buffer,
+      arrow::AllocateBuffer((num + 1) * sizeof(int64_t)));
+  std::partial_sum(counts.begin(), counts.begin() + num + 1,
+                   reinterpret_cast<int64_t*>(buffer->mutable_data()));
+  return std::make_shared<arrow::Int64Array>(num + 1, buffer);
+}
+
 Result<const void*> GetArrowArrayData(
     std::shared_ptr<arrow::Array> const& array) {
   if (array->type()->Equals(arrow::int8())) {
@@ -13,74 +13,278 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "arrow/compute/api.h"
+
 #include "gar/writer/vertices_builder.h"
 #include "gar/utils/convert_to_arrow_type.h"
 
 namespace GAR_NAMESPACE_INTERNAL {
 namespace builder {
 
-Status VerticesBuilder::appendToArray(
-    const DataType& type, const std::string& property_name,
-    std::shared_ptr<arrow::Array>& array) {  // NOLINT
-  switch (type.id()) {
-  case Type::BOOL:
-    return tryToAppend<Type::BOOL>(property_name, array);
-  case Type::INT32:
-    return tryToAppend<Type::INT32>(property_name, array);
-  case Type::INT64:
-    return tryToAppend<Type::INT64>(property_name, array);
-  case Type::FLOAT:
-    return tryToAppend<Type::FLOAT>(property_name, array);
-  case Type::DOUBLE:
-    return tryToAppend<Type::DOUBLE>(property_name, array);
-  case Type::STRING:
-    return tryToAppend<Type::STRING>(property_name, array);
-  default:
-    return Status::TypeError();
-  }
-  return Status::TypeError();
+void VerticesBuilder::initColumns() {
+  std::vector<std::shared_ptr<arrow::Field>> fields;
+  for (const auto& property_group : vertex_info_.GetPropertyGroups()) {
+    for (const auto& property : property_group.GetProperties()) {
+      fields.push_back(arrow::field(
+          property.name, DataType::DataTypeToArrowDataType(property.type)));
+      types_.push_back(property.type);
+    }
+  }
+  schema_ = arrow::schema(fields);
+  for (size_t i = 0; i < types_.size(); ++i) {
+    column_indices_[fields[i]->name()] = i;
+    // the builder of an unsupported type stays null, which fails the adding
+    std::unique_ptr<arrow::ArrayBuilder> builder;
+    Status status = VisitType(types_[i], [&](auto t) -> Status {
+      builder = std::make_unique<typename decltype(t)::BuilderType>();
+      return Status::OK();
+    });
+    builders_.push_back(status.ok() ? std::move(builder) : nullptr);
+  }
+  columns_.resize(types_.size());
 }
 
-template <Type type>
-Status VerticesBuilder::tryToAppend(
-    const std::string& property_name,
-    std::shared_ptr<arrow::Array>& array) {  // NOLINT
-  using CType = typename ConvertToArrowType<type>::CType;
-  arrow::MemoryPool* pool = arrow::default_memory_pool();
-  typename ConvertToArrowType<type>::BuilderType builder(pool);
-  for (auto& v : vertices_) {
-    if (v.Empty() || !v.ContainProperty(property_name)) {
-      auto status = builder.AppendNull();
-      if (!status.ok())
-        return Status::ArrowError(status.ToString());
-    } else {
-      auto status =
-          builder.Append(std::any_cast<CType>(v.GetProperty(property_name)));
-      if (!status.ok())
-        return Status::ArrowError(status.ToString());
+Status VerticesBuilder::finishBuilders() {
+  for (size_t i = 0; i < builders_.size(); ++i) {
+    if (builders_[i] == nullptr) {
+      return Status::TypeError("Unsupported data type " +
+                               types_[i].ToTypeName() + " of " +
+                               schema_->field(i)->name() + ".");
+    }
+    if (builders_[i]->length() > 0) {
+      std::shared_ptr<arrow::Array> array;
+      RETURN_NOT_ARROW_OK(builders_[i]->Finish(&array));
+      columns_[i].push_back(std::move(array));
     }
   }
-  array = builder.Finish().ValueOrDie();
   return Status::OK();
 }
 
-Result<std::shared_ptr<arrow::Table>> VerticesBuilder::convertToTable() {
-  auto property_groups = vertex_info_.GetPropertyGroups();
-  std::vector<std::shared_ptr<arrow::Array>> arrays;
-  std::vector<std::shared_ptr<arrow::Field>> schema_vector;
-  for (auto& property_group : property_groups) {
-    for (auto& property : property_group.GetProperties()) {
-      // add a column to schema
-      schema_vector.push_back(arrow::field(
-          property.name, DataType::DataTypeToArrowDataType(property.type)));
-      // add a column to data
-      std::shared_ptr<arrow::Array> array;
-      appendToArray(property.type, property.name, array);
-      arrays.push_back(array);
+void VerticesBuilder::recordPositions(IdType position, IdType num) {
+  IdType next_position = num_flushed_ + num_buffered_;
+  if (positions_.empty() && position != next_position) {
+    positions_.resize(num_buffered_);
+    for (IdType i = 0; i < num_buffered_; ++i) {
+      positions_[i] = num_flushed_ + i;
+    }
+  }
+  if (!positions_.empty() || position != next_position) {
+    for (IdType i = 0; i < num; ++i) {
+      positions_.push_back(position + i);
+    }
+  }
+  num_buffered_ += num;
+  num_rows_ = std::max(num_rows_, position + num);
+}
+
+Status VerticesBuilder::waitChunks(size_t max_in_flight_chunks) {
+  Status status = Status::OK();
+  while (in_flight_chunks_.size() > max_in_flight_chunks) {
+    Status chunk_status = in_flight_chunks_.front().get();
+    in_flight_chunks_.pop_front();
+    if (status.ok() && !chunk_status.ok()) {
+      status = chunk_status;
+    }
+  }
+  return status;
+}
+
+Status VerticesBuilder::flushChunks() {
+  IdType chunk_size = vertex_info_.GetChunkSize();
+  if (max_in_flight_chunks_ == 0 || !positions_.empty() ||
+      num_buffered_ < chunk_size) {
+    return Status::OK();
+  }
+  GAR_RETURN_NOT_OK(finishBuilders());
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> chunked_arrays;
+  for (size_t i = 0; i < columns_.size(); ++i) {
+    chunked_arrays.push_back(std::make_shared<arrow::ChunkedArray>(
+        std::move(columns_[i]), schema_->field(i)->type()));
+    columns_[i].clear();
+  }
+  auto table = arrow::Table::Make(schema_, chunked_arrays, num_buffered_);
+  chunked_arrays.clear();
+  // write the full chunks
+  auto writer = std::make_shared<VertexPropertyWriter>(vertex_info_, prefix_);
+  IdType start_chunk_index = start_vertex_index_ / chunk_size;
+  IdType offset = 0;
+  for (; offset + chunk_size <= num_buffered_; offset += chunk_size) {
+    GAR_RETURN_NOT_OK(waitChunks(max_in_flight_chunks_ - 1));
+    auto chunk = table->Slice(offset, chunk_size);
+    IdType chunk_index = start_chunk_index + num_flushed_ / chunk_size;
+    in_flight_chunks_.push_back(
+        std::async(std::launch::async, [writer, chunk, chunk_index]() {
+          return writer->WriteTable(chunk, chunk_index);
+        }));
+    num_flushed_ += chunk_size;
+  }
+  // keep the rest
+  auto rest = table->Slice(offset);
+  for (size_t i = 0; i < columns_.size(); ++i) {
+    columns_[i] = rest->column(i)->chunks();
+  }
+  num_buffered_ -= offset;
+  return Status::OK();
+}
+
+Status VerticesBuilder::AddVertex(Vertex& v, IdType index) {  // NOLINT
+  // validate
+  GAR_RETURN_NOT_OK(Validate(v, index));
+  // check the types first, so that a failed vertex is not partially appended
+  for (size_t i = 0; i < builders_.size(); ++i) {
+    if (builders_[i] == nullptr) {
+      return Status::TypeError("Unsupported data type " +
+                               types_[i].ToTypeName() + " of " +
+                               schema_->field(i)->name() + ".");
+    }
+  }
+  for (const auto& property : v.GetProperties()) {
+    const auto& type = types_[column_indices_.at(property.first)];
+    GAR_RETURN_NOT_OK(VisitType(type, [&](auto t) -> Status {
+      if (property.second.type() != typeid(typename decltype(t)::CType)) {
+        return Status::TypeError("The value of " + property.first +
+                                 " is not of type " + type.ToTypeName() + ".");
+      }
+      return Status::OK();
+    }));
+  }
+  // add a vertex
+  IdType position = index == -1 ? num_rows_ : index - start_vertex_index_;
+  v.SetId(start_vertex_index_ + position);
+  for (size_t i = 0; i < builders_.size(); ++i) {
+    const auto& name = schema_->field(i)->name();
+    if (v.Empty() || !v.ContainProperty(name)) {
+      RETURN_NOT_ARROW_OK(builders_[i]->AppendNull());
+      continue;
+    }
+    GAR_RETURN_NOT_OK(VisitType(types_[i], [&](auto t) -> Status {
+      using T = decltype(t);
+      RETURN_NOT_ARROW_OK(
+          static_cast<typename T::BuilderType*>(builders_[i].get())
+              ->Append(std::any_cast<const typename T::CType&>(
+                  v.GetProperty(name))));
+      return Status::OK();
+    }));
+  }
+  recordPositions(position, 1);
+  num_vertices_++;
+  return flushChunks();
+}
+
+Status VerticesBuilder::AddVertices(const std::shared_ptr<arrow::Table>& table,
+                                    IdType index) {
+  // can not add new vertices
+  if (is_saved_) {
+    return Status::InvalidOperation("can not add new vertices after dumping");
+  }
+  // start vertex index must be aligned with the chunk size
+  if (start_vertex_index_ % vertex_info_.GetChunkSize() != 0) {
+    return Status::InvalidOperation("invalid start vertex index");
+  }
+  // vertex index must larger than start index
+  if (index != -1 && index < start_vertex_index_) {
+    return Status::InvalidOperation(
+        "vertex index must larger than start index");
+  }
+  // the chunk of the vertex index is flushed
+  if (index != -1 && index < start_vertex_index_ + num_flushed_) {
+    return Status::InvalidOperation("vertex index is already flushed");
+  }
+  // match the columns of the table
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> columns(types_.size());
+  for (int i = 0; i < table->num_columns(); ++i) {
+    const auto& name = table->field(i)->name();
+    auto it = column_indices_.find(name);
+    if (it == column_indices_.end()) {
+      return Status::InvalidOperation("invalid property " + name);
     }
+    const auto& type = schema_->field(it->second)->type();
+    if (!table->column(i)->type()->Equals(type)) {
+      return Status::TypeError("The column " + name + " of type " +
+                               table->column(i)->type()->ToString() +
+                               " does not match " + type->ToString() + ".");
+    }
+    columns[it->second] = table->column(i);
+  }
+  // keep the order of the vertices added one by one before
+  GAR_RETURN_NOT_OK(finishBuilders());
+  IdType num = table->num_rows();
+  if (num == 0) {
+    return Status::OK();
   }
-  auto schema = std::make_shared<arrow::Schema>(schema_vector);
-  return arrow::Table::Make(schema, arrays);
+  for (size_t i = 0; i < columns.size(); ++i) {
+    if (columns[i] != nullptr) {
+      for (const auto& chunk : columns[i]->chunks()) {
+        columns_[i].push_back(chunk);
+      }
+    } else {
+      GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+          auto nulls, arrow::MakeArrayOfNull(schema_->field(i)->type(), num));
+      columns_[i].push_back(std::move(nulls));
+    }
+  }
+  recordPositions(index == -1 ? num_rows_ : index - start_vertex_index_, num);
+  num_vertices_ += num;
+  return flushChunks();
+}
+
+Status VerticesBuilder::AddVertices(
+    const std::shared_ptr<arrow::RecordBatch>& batch, IdType index) {
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      auto table, arrow::Table::FromRecordBatches({batch}));
+  return AddVertices(table, index);
+}
+
+Status VerticesBuilder::Dump() {
+  GAR_RETURN_NOT_OK(finishBuilders());
+  // construct the writer
+  VertexPropertyWriter writer(vertex_info_, prefix_);
+  IdType start_chunk_index =
+      (start_vertex_index_ + num_flushed_) / vertex_info_.GetChunkSize();
+  // convert to table
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> chunked_arrays;
+  for (size_t i = 0; i < columns_.size(); ++i) {
+    chunked_arrays.push_back(std::make_shared<arrow::ChunkedArray>(
+        std::move(columns_[i]), schema_->field(i)->type()));
+    columns_[i].clear();
+  }
+  auto input_table =
+      arrow::Table::Make(schema_, chunked_arrays, num_buffered_);
+  chunked_arrays.clear();
+  // scatter the vertices to their positions, the last added one wins and
+  // the positions never added are null
+  if (!positions_.empty()) {
+    IdType num_rows = num_rows_ - num_flushed_;
+    std::vector<int64_t> indices(num_rows, 0);
+    std::vector<bool> is_valid(num_rows, false);
+    for (size_t i = 0; i < positions_.size(); ++i) {
+      indices[positions_[i] - num_flushed_] = i;
+      is_valid[positions_[i] - num_flushed_] = true;
+    }
+    std::vector<IdType>().swap(positions_);
+    arrow::Int64Builder indices_builder;
+    RETURN_NOT_ARROW_OK(indices_builder.AppendValues(indices, is_valid));
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto indices_array,
+                                         indices_builder.Finish());
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        auto datum, arrow::compute::Take(input_table, indices_array));
+    input_table = datum.table();
+  }
+  // write table, after the flushed chunks are written
+  Status status = writer.WriteTable(input_table, start_chunk_index);
+  Status flush_status = waitChunks(0);
+  GAR_RETURN_NOT_OK(flush_status);
+  GAR_RETURN_NOT_OK(status);
+  GAR_RETURN_NOT_OK(writer.WriteVerticesNum(num_rows_ + start_vertex_index_));
+  is_saved_ = true;
+  return Status::OK();
 }
 
 }  // namespace builder
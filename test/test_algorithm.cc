@@ -0,0 +1,548 @@
+/** Copyright 2022 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <queue>
+#include <vector>
+
+#include "arrow/api.h"
+
+#include "./config.h"
+#include "gar/algorithm/bfs.h"
+#include "gar/algorithm/cc.h"
+#include "gar/algorithm/neighbor_sampler.h"
+#include "gar/algorithm/pagerank.h"
+#include "gar/algorithm/random_walk.h"
+#include "gar/algorithm/subgraph.h"
+#include "gar/graph.h"
+#include "gar/reader/arrow_chunk_reader.h"
+#include "gar/reader/csr_reader.h"
+#include "gar/utils/filesystem.h"
+#include "gar/writer/arrow_chunk_writer.h"
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+TEST_CASE("test_bfs") {
+  std::string path =
+      TEST_DATA_DIR + "/ldbc_sample/parquet/ldbc_sample.graph.yml";
+  std::string label = "person", edge_label = "knows";
+  auto graph_info = GAR_NAMESPACE::GraphInfo::Load(path).value();
+  auto maybe_csr =
+      GAR_NAMESPACE::LoadCSR(graph_info, label, edge_label, label);
+  REQUIRE(!maybe_csr.has_error());
+  auto& csr = maybe_csr.value();
+  GAR_NAMESPACE::IdType vertex_num = csr.GetVertexNum();
+
+  // the distances are the same as the ones of a sequential BFS
+  GAR_NAMESPACE::IdType root = 0;
+  std::vector<int32_t> expected(vertex_num, -1);
+  std::queue<GAR_NAMESPACE::IdType> queue;
+  expected[root] = 0;
+  queue.push(root);
+  while (!queue.empty()) {
+    auto vid = queue.front();
+    queue.pop();
+    csr.ForEachNeighbor(vid, [&](GAR_NAMESPACE::IdType neighbor) {
+      if (expected[neighbor] == -1) {
+        expected[neighbor] = expected[vid] + 1;
+        queue.push(neighbor);
+      }
+    });
+  }
+  for (int thread_num : {1, 4}) {
+    auto maybe_result =
+        GAR_NAMESPACE::BFS(graph_info, label, edge_label, root, thread_num);
+    REQUIRE(!maybe_result.has_error());
+    auto& result = maybe_result.value();
+    REQUIRE(result.distance == expected);
+    // the parent of each reached vertex is an in-neighbor one step closer
+    for (GAR_NAMESPACE::IdType vid = 0; vid < vertex_num; ++vid) {
+      auto parent = result.parent[vid];
+      if (expected[vid] == -1) {
+        REQUIRE(parent == -1);
+      } else if (vid == root) {
+        REQUIRE(parent == root);
+      } else {
+        REQUIRE(expected[parent] == expected[vid] - 1);
+        auto range = csr.GetNeighbors(parent);
+        REQUIRE(std::find(range.first, range.second, vid) != range.second);
+      }
+    }
+  }
+  REQUIRE(GAR_NAMESPACE::BFS(graph_info, label, edge_label, vertex_num)
+              .status()
+              .IsOutOfRange());
+
+  // the compressed adjacency gives the same distances
+  auto out_compressed = GAR_NAMESPACE::LoadCompressedCSR(
+                            graph_info, label, edge_label, label,
+                            GAR_NAMESPACE::AdjListType::ordered_by_source)
+                            .value();
+  auto in_compressed = GAR_NAMESPACE::LoadCompressedCSR(
+                           graph_info, label, edge_label, label,
+                           GAR_NAMESPACE::AdjListType::ordered_by_dest)
+                           .value();
+  auto maybe_compressed_result =
+      GAR_NAMESPACE::BFS(out_compressed, in_compressed, root, 4);
+  REQUIRE(!maybe_compressed_result.has_error());
+  REQUIRE(maybe_compressed_result.value().distance == expected);
+
+  // write the result as a new property group of the vertices
+  auto maybe_result = GAR_NAMESPACE::BFS(graph_info, label, edge_label, root);
+  REQUIRE(!maybe_result.has_error());
+  GAR_NAMESPACE::Property distance = {
+      "bfs-distance", GAR_NAMESPACE::DataType(GAR_NAMESPACE::Type::INT32),
+      false};
+  GAR_NAMESPACE::Property parent = {
+      "bfs-parent", GAR_NAMESPACE::DataType(GAR_NAMESPACE::Type::INT64),
+      false};
+  GAR_NAMESPACE::PropertyGroup group({distance, parent},
+                                     GAR_NAMESPACE::FileType::PARQUET);
+  auto vertex_info = graph_info.GetVertexInfo(label).value();
+  auto maybe_extend_info = vertex_info.Extend(group);
+  REQUIRE(maybe_extend_info.status().ok());
+  GAR_NAMESPACE::VertexPropertyWriter writer(maybe_extend_info.value(),
+                                             "/tmp/");
+  REQUIRE(
+      GAR_NAMESPACE::WriteBFSResult(maybe_result.value(), writer, group).ok());
+
+  // the written chunks hold a row for each vertex, without padded rows
+  GAR_NAMESPACE::VertexPropertyArrowChunkReader reader(
+      maybe_extend_info.value(), group, "/tmp/");
+  GAR_NAMESPACE::IdType num_rows = 0;
+  do {
+    num_rows += reader.GetChunk().value()->num_rows();
+  } while (reader.next_chunk().ok());
+  REQUIRE(num_rows == vertex_num);
+}
+
+TEST_CASE("test_pagerank") {
+  std::string path =
+      TEST_DATA_DIR + "/ldbc_sample/parquet/ldbc_sample.graph.yml";
+  std::string label = "person", edge_label = "knows";
+  auto graph_info = GAR_NAMESPACE::GraphInfo::Load(path).value();
+  auto maybe_csr =
+      GAR_NAMESPACE::LoadCSR(graph_info, label, edge_label, label);
+  REQUIRE(!maybe_csr.has_error());
+  auto& csr = maybe_csr.value();
+  // the number of vertices is the one of the vertices collection, as the
+  // PageRank example
+  auto maybe_vertices =
+      GAR_NAMESPACE::ConstructVerticesCollection(graph_info, label);
+  REQUIRE(!maybe_vertices.has_error());
+  GAR_NAMESPACE::IdType vertex_num = maybe_vertices.value().size();
+  REQUIRE(csr.GetVertexNum() == vertex_num);
+
+  // the ranks are the same as the ones of the scattering PageRank example
+  const double damping = 0.85;
+  const int max_iterations = 10;
+  std::vector<double> expected(vertex_num, 1 / static_cast<double>(vertex_num));
+  std::vector<double> next(vertex_num, 0);
+  for (int iter = 0; iter < max_iterations; ++iter) {
+    for (GAR_NAMESPACE::IdType vid = 0; vid < vertex_num; ++vid) {
+      csr.ForEachNeighbor(vid, [&](GAR_NAMESPACE::IdType neighbor) {
+        next[neighbor] += expected[vid] / csr.GetDegree(vid);
+      });
+    }
+    for (GAR_NAMESPACE::IdType vid = 0; vid < vertex_num; ++vid) {
+      next[vid] = damping * next[vid] + (1 - damping) / vertex_num;
+      if (csr.GetDegree(vid) == 0) {
+        next[vid] += damping * expected[vid];
+      }
+      expected[vid] = next[vid];
+      next[vid] = 0;
+    }
+  }
+  for (int thread_num : {1, 4}) {
+    auto maybe_result = GAR_NAMESPACE::PageRank(
+        graph_info, label, edge_label, damping, max_iterations, 0, thread_num);
+    REQUIRE(!maybe_result.has_error());
+    auto& result = maybe_result.value();
+    REQUIRE(result.iterations == max_iterations);
+    REQUIRE(result.rank.size() == static_cast<size_t>(vertex_num));
+    for (GAR_NAMESPACE::IdType vid = 0; vid < vertex_num; ++vid) {
+      REQUIRE(std::fabs(result.rank[vid] - expected[vid]) < 1e-12);
+    }
+  }
+
+  // the compressed adjacency gives the same ranks
+  auto compressed = GAR_NAMESPACE::LoadCompressedCSR(
+                        graph_info, label, edge_label, label,
+                        GAR_NAMESPACE::AdjListType::ordered_by_dest)
+                        .value();
+  auto maybe_compressed_result = GAR_NAMESPACE::PageRank(
+      compressed, damping, max_iterations, 0, 4);
+  REQUIRE(!maybe_compressed_result.has_error());
+  for (GAR_NAMESPACE::IdType vid = 0; vid < vertex_num; ++vid) {
+    REQUIRE(std::fabs(maybe_compressed_result.value().rank[vid] -
+                      expected[vid]) < 1e-12);
+  }
+
+  // so do the out-degrees counted from the incoming edges by each thread
+  auto in_edges = GAR_NAMESPACE::LoadCSR(
+                      graph_info, label, edge_label, label,
+                      GAR_NAMESPACE::AdjListType::ordered_by_dest)
+                      .value();
+  for (int thread_num : {1, 4}) {
+    auto maybe_counted_result = GAR_NAMESPACE::PageRank(
+        in_edges, damping, max_iterations, 0, thread_num);
+    REQUIRE(!maybe_counted_result.has_error());
+    for (GAR_NAMESPACE::IdType vid = 0; vid < vertex_num; ++vid) {
+      REQUIRE(std::fabs(maybe_counted_result.value().rank[vid] -
+                        expected[vid]) < 1e-12);
+    }
+  }
+
+  // the iterations stop once the ranks converge
+  auto maybe_result =
+      GAR_NAMESPACE::PageRank(graph_info, label, edge_label, damping, 1000);
+  REQUIRE(!maybe_result.has_error());
+  auto& result = maybe_result.value();
+  REQUIRE(result.iterations < 1000);
+  REQUIRE(result.delta < 1e-6);
+
+  // the ranks can only be pulled along the incoming edges
+  REQUIRE(GAR_NAMESPACE::PageRank(csr).status().IsInvalid());
+
+  // write the result as a new property group of the vertices
+  GAR_NAMESPACE::Property rank = {
+      "pagerank", GAR_NAMESPACE::DataType(GAR_NAMESPACE::Type::DOUBLE), false};
+  GAR_NAMESPACE::PropertyGroup group({rank}, GAR_NAMESPACE::FileType::PARQUET);
+  auto vertex_info = graph_info.GetVertexInfo(label).value();
+  auto maybe_extend_info = vertex_info.Extend(group);
+  REQUIRE(maybe_extend_info.status().ok());
+  GAR_NAMESPACE::VertexPropertyWriter writer(maybe_extend_info.value(),
+                                             "/tmp/");
+  REQUIRE(GAR_NAMESPACE::WritePageRankResult(result, writer, group).ok());
+
+  // the written chunks hold a row for each vertex, without padded rows
+  GAR_NAMESPACE::VertexPropertyArrowChunkReader reader(
+      maybe_extend_info.value(), group, "/tmp/");
+  GAR_NAMESPACE::IdType num_rows = 0;
+  do {
+    num_rows += reader.GetChunk().value()->num_rows();
+  } while (reader.next_chunk().ok());
+  REQUIRE(num_rows == vertex_num);
+}
+
+TEST_CASE("test_connected_components") {
+  std::string path =
+      TEST_DATA_DIR + "/ldbc_sample/parquet/ldbc_sample.graph.yml";
+  std::string label = "person", edge_label = "knows";
+  auto graph_info = GAR_NAMESPACE::GraphInfo::Load(path).value();
+  auto maybe_csr =
+      GAR_NAMESPACE::LoadCSR(graph_info, label, edge_label, label);
+  REQUIRE(!maybe_csr.has_error());
+  auto& csr = maybe_csr.value();
+  GAR_NAMESPACE::IdType vertex_num = csr.GetVertexNum();
+
+  // the components are the same as the ones of label propagation
+  std::vector<GAR_NAMESPACE::IdType> expected(vertex_num);
+  std::iota(expected.begin(), expected.end(), 0);
+  for (bool changed = true; changed;) {
+    changed = false;
+    for (GAR_NAMESPACE::IdType vid = 0; vid < vertex_num; ++vid) {
+      csr.ForEachNeighbor(vid, [&](GAR_NAMESPACE::IdType neighbor) {
+        auto component = std::min(expected[vid], expected[neighbor]);
+        if (expected[vid] != component || expected[neighbor] != component) {
+          expected[vid] = expected[neighbor] = component;
+          changed = true;
+        }
+      });
+    }
+  }
+  GAR_NAMESPACE::IdType expected_num = 0;
+  for (GAR_NAMESPACE::IdType vid = 0; vid < vertex_num; ++vid) {
+    expected_num += expected[vid] == vid;
+  }
+  for (auto adj_list_type : {GAR_NAMESPACE::AdjListType::ordered_by_source,
+                             GAR_NAMESPACE::AdjListType::ordered_by_dest,
+                             GAR_NAMESPACE::AdjListType::unordered_by_source}) {
+    auto maybe_result = GAR_NAMESPACE::ConnectedComponents(
+        graph_info, label, edge_label, adj_list_type, 4);
+    REQUIRE(!maybe_result.has_error());
+    REQUIRE(maybe_result.value().component == expected);
+    REQUIRE(maybe_result.value().component_num == expected_num);
+  }
+
+  // write the result as a new property group of the vertices
+  auto maybe_result =
+      GAR_NAMESPACE::ConnectedComponents(graph_info, label, edge_label);
+  REQUIRE(!maybe_result.has_error());
+  GAR_NAMESPACE::Property cc = {
+      "cc", GAR_NAMESPACE::DataType(GAR_NAMESPACE::Type::INT64), false};
+  GAR_NAMESPACE::PropertyGroup group({cc}, GAR_NAMESPACE::FileType::PARQUET);
+  auto vertex_info = graph_info.GetVertexInfo(label).value();
+  auto maybe_extend_info = vertex_info.Extend(group);
+  REQUIRE(maybe_extend_info.status().ok());
+  GAR_NAMESPACE::VertexPropertyWriter writer(maybe_extend_info.value(),
+                                             "/tmp/");
+  REQUIRE(
+      GAR_NAMESPACE::WriteCCResult(maybe_result.value(), writer, group).ok());
+}
+
+TEST_CASE("test_induced_subgraph") {
+  std::string path =
+      TEST_DATA_DIR + "/ldbc_sample/parquet/ldbc_sample.graph.yml";
+  std::string label = "person", edge_label = "knows";
+  auto graph_info = GAR_NAMESPACE::GraphInfo::Load(path).value();
+  auto vertex_info = graph_info.GetVertexInfo(label).value();
+  auto maybe_selected = GAR_NAMESPACE::SelectVertices<int64_t>(
+      vertex_info, graph_info.GetPrefix(), "id",
+      [](const int64_t& id) { return id % 3 != 0; }, 4);
+  REQUIRE(!maybe_selected.has_error());
+  auto& selected = maybe_selected.value();
+  REQUIRE(selected.Count() > 0);
+  REQUIRE(selected.Count() < selected.size());
+
+  auto maybe_subgraph = GAR_NAMESPACE::ExtractInducedSubgraph(
+      graph_info, label, selected, "/tmp/induced_subgraph/", 4);
+  REQUIRE(!maybe_subgraph.has_error());
+  auto maybe_new_graph_info = GAR_NAMESPACE::GraphInfo::Load(
+      "/tmp/induced_subgraph/" + graph_info.GetName() + ".graph.yml");
+  REQUIRE(!maybe_new_graph_info.has_error());
+  auto& new_graph_info = maybe_new_graph_info.value();
+
+  // the edges of the new graph are the renumbered edges between the selected
+  // vertices, in every adjList type
+  auto csr =
+      GAR_NAMESPACE::LoadCSR(graph_info, label, edge_label, label).value();
+  std::vector<GAR_NAMESPACE::IdType> new_ids(csr.GetVertexNum(), -1);
+  GAR_NAMESPACE::IdType new_vertex_num = 0;
+  for (GAR_NAMESPACE::IdType vid = 0; vid < csr.GetVertexNum(); ++vid) {
+    if (selected.Get(vid)) {
+      new_ids[vid] = new_vertex_num++;
+    }
+  }
+  REQUIRE(new_vertex_num == selected.Count());
+  std::vector<std::pair<GAR_NAMESPACE::IdType, GAR_NAMESPACE::IdType>>
+      expected;
+  for (GAR_NAMESPACE::IdType vid = 0; vid < csr.GetVertexNum(); ++vid) {
+    csr.ForEachNeighbor(vid, [&](GAR_NAMESPACE::IdType neighbor) {
+      if (new_ids[vid] != -1 && new_ids[neighbor] != -1) {
+        expected.emplace_back(new_ids[vid], new_ids[neighbor]);
+      }
+    });
+  }
+  std::sort(expected.begin(), expected.end());
+  for (auto adj_list_type : {GAR_NAMESPACE::AdjListType::ordered_by_source,
+                             GAR_NAMESPACE::AdjListType::ordered_by_dest}) {
+    auto maybe_new_csr = GAR_NAMESPACE::LoadCSR(
+        new_graph_info, label, edge_label, label, adj_list_type);
+    REQUIRE(!maybe_new_csr.has_error());
+    auto& new_csr = maybe_new_csr.value();
+    std::vector<std::pair<GAR_NAMESPACE::IdType, GAR_NAMESPACE::IdType>>
+        edges;
+    for (GAR_NAMESPACE::IdType vid = 0; vid < new_csr.GetVertexNum(); ++vid) {
+      new_csr.ForEachNeighbor(vid, [&](GAR_NAMESPACE::IdType neighbor) {
+        if (adj_list_type == GAR_NAMESPACE::AdjListType::ordered_by_source) {
+          edges.emplace_back(vid, neighbor);
+        } else {
+          edges.emplace_back(neighbor, vid);
+        }
+      });
+    }
+    std::sort(edges.begin(), edges.end());
+    REQUIRE(edges == expected);
+  }
+
+  // the size of the bitmap must match the number of vertices
+  GAR_NAMESPACE::util::Bitmap wrong_size(selected.size() + 1);
+  REQUIRE(GAR_NAMESPACE::ExtractInducedSubgraph(graph_info, label, wrong_size,
+                                                "/tmp/induced_subgraph/")
+              .status()
+              .IsInvalid());
+}
+
+TEST_CASE("test_neighbor_sampler") {
+  std::string path =
+      TEST_DATA_DIR + "/ldbc_sample/parquet/ldbc_sample.graph.yml";
+  std::string label = "person", edge_label = "knows";
+  auto graph_info = GAR_NAMESPACE::GraphInfo::Load(path).value();
+  auto csr =
+      GAR_NAMESPACE::LoadCSR(graph_info, label, edge_label, label).value();
+  std::vector<GAR_NAMESPACE::IdType> seeds = {0, 1, 2, 100, 500, 1};
+  std::vector<int> fanouts = {5, 3};
+
+  auto check = [&](const GAR_NAMESPACE::SampledSubgraph& subgraph,
+                   bool replace) {
+    REQUIRE(subgraph.blocks.size() == fanouts.size());
+    const int64_t* vertices = subgraph.vertices->raw_values();
+    // the seeds come first without duplicates
+    for (int i = 0; i < 5; ++i) {
+      REQUIRE(vertices[i] == seeds[i]);
+    }
+    GAR_NAMESPACE::IdType center_begin = 0, center_end = 5;
+    for (size_t hop = 0; hop < fanouts.size(); ++hop) {
+      const auto& block = subgraph.blocks[hop];
+      std::vector<GAR_NAMESPACE::IdType> counts(subgraph.vertices->length());
+      GAR_NAMESPACE::IdType next_end = center_end;
+      for (int64_t i = 0; i < block.edges->length(); ++i) {
+        auto center = block.centers->Value(i);
+        auto edge = block.edges->Value(i);
+        REQUIRE(center >= center_begin);
+        REQUIRE(center < center_end);
+        auto range = csr.GetNeighbors(vertices[center]);
+        REQUIRE(csr.GetNeighbors() + edge >= range.first);
+        REQUIRE(csr.GetNeighbors() + edge < range.second);
+        REQUIRE(vertices[block.neighbors->Value(i)] ==
+                csr.GetNeighbors()[edge]);
+        next_end = std::max(next_end, block.neighbors->Value(i) + 1);
+        ++counts[center];
+      }
+      for (auto center = center_begin; center < center_end; ++center) {
+        auto degree = csr.GetDegree(vertices[center]);
+        if (replace) {
+          REQUIRE(counts[center] == (degree > 0 ? fanouts[hop] : 0));
+        } else {
+          REQUIRE(counts[center] == std::min<GAR_NAMESPACE::IdType>(
+                                        degree, fanouts[hop]));
+        }
+      }
+      center_begin = center_end;
+      center_end = next_end;
+    }
+  };
+
+  // uniform sampling depends on the random seed only
+  auto maybe_subgraph = GAR_NAMESPACE::SampleNeighbors(csr, seeds, fanouts,
+                                                       nullptr, false, 42, 4);
+  REQUIRE(!maybe_subgraph.has_error());
+  auto& subgraph = maybe_subgraph.value();
+  auto same_subgraph =
+      GAR_NAMESPACE::SampleNeighbors(csr, seeds, fanouts, nullptr, false, 42, 1)
+          .value();
+  REQUIRE(subgraph.vertices->Equals(same_subgraph.vertices));
+  REQUIRE(subgraph.blocks[1].edges->Equals(same_subgraph.blocks[1].edges));
+  check(subgraph, false);
+  check(GAR_NAMESPACE::SampleNeighbors(csr, seeds, fanouts, nullptr, true)
+            .value(),
+        true);
+
+  // the edges of zero weight are never sampled
+  arrow::DoubleBuilder builder;
+  for (GAR_NAMESPACE::IdType i = 0; i < csr.GetEdgeNum(); ++i) {
+    REQUIRE(builder.Append(csr.GetNeighbors()[i] % 2 == 0 ? 0.0 : 1.0).ok());
+  }
+  auto weights = std::static_pointer_cast<arrow::DoubleArray>(
+      builder.Finish().ValueOrDie());
+  for (bool replace : {false, true}) {
+    auto weighted = GAR_NAMESPACE::SampleNeighbors(csr, seeds, {-1}, weights,
+                                                   replace, 7, 4)
+                        .value();
+    for (int64_t i = 0; i < weighted.blocks[0].edges->length(); ++i) {
+      REQUIRE(weights->Value(weighted.blocks[0].edges->Value(i)) > 0);
+    }
+  }
+  REQUIRE(GAR_NAMESPACE::SampleNeighbors(csr, {csr.GetVertexNum()}, fanouts)
+              .status()
+              .IsInvalid());
+  auto edge_info = graph_info.GetEdgeInfo(label, edge_label, label).value();
+  REQUIRE(GAR_NAMESPACE::LoadEdgeWeights(csr, edge_info,
+                                         graph_info.GetPrefix(), "creationDate")
+              .status()
+              .IsTypeError());
+
+  // gather the features of the sampled vertices
+  auto vertex_info = graph_info.GetVertexInfo(label).value();
+  auto maybe_features = GAR_NAMESPACE::GatherVertexProperties(
+      vertex_info, graph_info.GetPrefix(), subgraph.vertices,
+      {"firstName", "id"}, 4);
+  REQUIRE(!maybe_features.has_error());
+  auto features = maybe_features.value();
+  REQUIRE(features->num_rows() == subgraph.vertices->length());
+  REQUIRE(features->schema()->field(0)->name() == "firstName");
+  auto id_group = vertex_info.GetPropertyGroup("id").value();
+  GAR_NAMESPACE::VertexPropertyArrowChunkReader reader(
+      vertex_info, id_group, graph_info.GetPrefix());
+  for (int64_t i = 0; i < subgraph.vertices->length(); ++i) {
+    REQUIRE(reader.seek(subgraph.vertices->Value(i)).ok());
+    auto expected = reader.GetChunk().value()->GetColumnByName("id");
+    REQUIRE(std::static_pointer_cast<arrow::Int64Array>(
+                features->column(1)->chunk(0))
+                ->Value(i) ==
+            std::static_pointer_cast<arrow::Int64Array>(expected->chunk(0))
+                ->Value(0));
+  }
+}
+
+TEST_CASE("test_random_walk") {
+  std::string path =
+      TEST_DATA_DIR + "/ldbc_sample/parquet/ldbc_sample.graph.yml";
+  std::string label = "person", edge_label = "knows";
+  auto graph_info = GAR_NAMESPACE::GraphInfo::Load(path).value();
+  auto csr =
+      GAR_NAMESPACE::LoadCSR(graph_info, label, edge_label, label).value();
+  GAR_NAMESPACE::IdType vertex_num = csr.GetVertexNum();
+  auto fs = GAR_NAMESPACE::FileSystemFromUriOrPath("/tmp/").value();
+
+  GAR_NAMESPACE::RandomWalkOptions options;
+  options.walk_length = 10;
+  options.walks_per_vertex = 2;
+  options.batch_size = 500;
+  options.random_seed = 42;
+  for (double q : {1.0, 2.0, 0.5}) {
+    options.p = 1 / q;
+    options.q = q;
+    std::string output_path = "/tmp/random_walk/walks.parquet";
+    auto maybe_num = GAR_NAMESPACE::RandomWalk(graph_info, label, edge_label,
+                                               output_path, options, 4);
+    REQUIRE(!maybe_num.has_error());
+    REQUIRE(maybe_num.value() == vertex_num * options.walks_per_vertex);
+
+    // every walk starts from its vertex and follows the edges, and it stops
+    // early only at a vertex without out-going edges
+    auto table =
+        fs->ReadFileToTable(output_path, GAR_NAMESPACE::FileType::PARQUET)
+            .value();
+    REQUIRE(table->num_rows() == maybe_num.value());
+    int64_t row = 0;
+    for (const auto& chunk : table->column(0)->chunks()) {
+      auto walks = std::static_pointer_cast<arrow::ListArray>(chunk);
+      auto values =
+          std::static_pointer_cast<arrow::Int64Array>(walks->values());
+      for (int64_t i = 0; i < walks->length(); ++i, ++row) {
+        int64_t begin = walks->value_offset(i);
+        int64_t length = walks->value_length(i);
+        REQUIRE(length >= 1);
+        REQUIRE(length <= options.walk_length);
+        REQUIRE(values->Value(begin) == row % vertex_num);
+        for (int64_t k = begin + 1; k < begin + length; ++k) {
+          auto range = csr.GetNeighbors(values->Value(k - 1));
+          REQUIRE(std::find(range.first, range.second, values->Value(k)) !=
+                  range.second);
+        }
+        if (length < options.walk_length) {
+          REQUIRE(csr.GetDegree(values->Value(begin + length - 1)) == 0);
+        }
+      }
+    }
+
+    // the walks do not depend on the adjLists kept in the cache
+    auto uncached_options = options;
+    uncached_options.cache_bytes = 0;
+    std::string uncached_path = "/tmp/random_walk/uncached_walks.parquet";
+    REQUIRE(GAR_NAMESPACE::RandomWalk(graph_info, label, edge_label,
+                                      uncached_path, uncached_options, 4)
+                .value() == maybe_num.value());
+    auto uncached =
+        fs->ReadFileToTable(uncached_path, GAR_NAMESPACE::FileType::PARQUET)
+            .value();
+    REQUIRE(uncached->Equals(*table));
+  }
+}
@@ -12,10 +12,14 @@ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 See the License for the specific language governing permissions and
 limitations under the License.
 */
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <numeric>
+#include <random>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "arrow/adapters/orc/adapter.h"
 #include "arrow/api.h"
@@ -29,7 +33,10 @@ limitations under the License.
 
 #include "./config.h"
 #include "gar/graph_info.h"
+#include "gar/reader/arrow_chunk_reader.h"
+#include "gar/reader/csr_reader.h"
 #include "gar/writer/arrow_chunk_writer.h"
+#include "gar/writer/multi_layout_edge_writer.h"
 
 #define CATCH_CONFIG_MAIN
 #include <catch2/catch.hpp>
@@ -147,3 +154,179 @@ TEST_CASE("test_edge_chunk_writer") {
       edge_info, "/tmp/", GAR_NAMESPACE::AdjListType::ordered_by_source);
   REQUIRE(writer.SortAndWriteAdjListTable(table, 0, 0).ok());
 }
+
+TEST_CASE("test_sort_indices_and_take_table") {
+  // keys of a small range, so that the sort must be stable, and of the whole
+  // int64 range
+  std::mt19937_64 engine(0);
+  int64_t length = 300000;
+  for (int64_t range : {int64_t(1000), int64_t(0)}) {
+    std::vector<int64_t> keys(length);
+    for (auto& key : keys) {
+      key = range == 0 ? static_cast<int64_t>(engine())
+                       : static_cast<int64_t>(engine() % range) - range / 2;
+    }
+    std::vector<int64_t> expected(length), indices(length);
+    std::iota(expected.begin(), expected.end(), 0);
+    std::stable_sort(
+        expected.begin(), expected.end(),
+        [&keys](int64_t a, int64_t b) { return keys[a] < keys[b]; });
+    REQUIRE(GAR_NAMESPACE::util::SortIndices(keys.data(), length,
+                                             indices.data(), 4)
+                .ok());
+    REQUIRE(indices == expected);
+  }
+
+  // take the rows of every column by the indices
+  arrow::Int64Builder key_builder, index_builder;
+  arrow::StringBuilder value_builder;
+  for (int64_t i = 0; i < length; ++i) {
+    REQUIRE(key_builder.Append(i).ok());
+    REQUIRE(value_builder.Append(std::to_string(i)).ok());
+    REQUIRE(index_builder.Append(length - 1 - i).ok());
+  }
+  auto schema = arrow::schema({arrow::field("key", arrow::int64()),
+                               arrow::field("value", arrow::utf8())});
+  auto table =
+      arrow::Table::Make(schema, {key_builder.Finish().ValueOrDie(),
+                                  value_builder.Finish().ValueOrDie()});
+  auto indices = std::static_pointer_cast<arrow::Int64Array>(
+      index_builder.Finish().ValueOrDie());
+  auto taken = GAR_NAMESPACE::util::TakeTable(table, indices, 4).value();
+  REQUIRE(taken->num_rows() == length);
+  auto combined = taken->CombineChunksToBatch().ValueOrDie();
+  auto taken_keys =
+      std::static_pointer_cast<arrow::Int64Array>(combined->column(0));
+  auto taken_values =
+      std::static_pointer_cast<arrow::StringArray>(combined->column(1));
+  for (int64_t i = 0; i < length; ++i) {
+    REQUIRE(taken_keys->Value(i) == length - 1 - i);
+    REQUIRE(taken_values->GetString(i) == std::to_string(length - 1 - i));
+  }
+
+  // take nothing, from a table of a chunk and from one without chunks
+  auto no_indices = std::static_pointer_cast<arrow::Int64Array>(
+      arrow::MakeArrayOfNull(arrow::int64(), 0).ValueOrDie());
+  auto empty_table = arrow::Table::Make(
+      schema, {std::make_shared<arrow::ChunkedArray>(arrow::ArrayVector{},
+                                                     arrow::int64()),
+               std::make_shared<arrow::ChunkedArray>(arrow::ArrayVector{},
+                                                     arrow::utf8())},
+      0);
+  for (const auto& from : {table, empty_table}) {
+    auto empty = GAR_NAMESPACE::util::TakeTable(from, no_indices, 4).value();
+    REQUIRE(empty->num_rows() == 0);
+    REQUIRE(empty->schema()->Equals(*schema));
+  }
+}
+
+TEST_CASE("test_compute_offsets") {
+  // unsorted ids with nulls and ids out of the range [10, 15)
+  arrow::Int64Builder builder;
+  REQUIRE(builder.AppendValues({12, 10, 3, 14, 12, 20}).ok());
+  REQUIRE(builder.AppendNull().ok());
+  REQUIRE(builder.AppendValues({11, 12}).ok());
+  auto ids = std::make_shared<arrow::ChunkedArray>(
+      arrow::ArrayVector{builder.Finish().ValueOrDie()});
+  auto offsets = GAR_NAMESPACE::util::ComputeOffsets(ids, 10, 5).value();
+  std::vector<int64_t> expected = {0, 1, 2, 5, 5, 6};
+  REQUIRE(offsets->length() == 6);
+  for (int64_t i = 0; i < 6; ++i) {
+    REQUIRE(offsets->Value(i) == expected[i]);
+  }
+
+  // the offsets of two vertex chunks at once, from raw ids
+  std::vector<int64_t> raw_ids = {3, 0, 1, 3, 2, 0};
+  std::vector<int64_t> raw_offsets(5);
+  GAR_NAMESPACE::util::ComputeOffsets(raw_ids.data(), raw_ids.size(), 0, 4,
+                                      raw_offsets.data());
+  REQUIRE(raw_offsets == std::vector<int64_t>({0, 2, 3, 4, 6}));
+}
+
+TEST_CASE("test_multi_layout_edge_writer") {
+  std::string edge_meta_file =
+      TEST_DATA_DIR + "/ldbc_sample/parquet/" + "person_knows_person.edge.yml";
+  auto edge_meta = GAR_NAMESPACE::Yaml::LoadFile(edge_meta_file).value();
+  auto edge_info = GAR_NAMESPACE::EdgeInfo::Load(edge_meta).value();
+  std::string vertex_meta_file =
+      TEST_DATA_DIR + "/ldbc_sample/parquet/" + "person.vertex.yml";
+  auto vertex_meta = GAR_NAMESPACE::Yaml::LoadFile(vertex_meta_file).value();
+  auto vertex_info = GAR_NAMESPACE::VertexInfo::Load(vertex_meta).value();
+  std::string prefix = "/tmp/multi_layout_edge_writer/";
+  int64_t num_vertices = 903, num_edges = 3000;
+  auto src_of = [&](int64_t i) { return i * 7 % num_vertices; };
+  auto dst_of = [&](int64_t i) { return (i * 13 + 5) % num_vertices; };
+  arrow::Int64Builder src_builder, dst_builder;
+  arrow::StringBuilder date_builder;
+  for (int64_t i = 0; i < num_edges; ++i) {
+    REQUIRE(src_builder.Append(src_of(i)).ok());
+    REQUIRE(dst_builder.Append(dst_of(i)).ok());
+    REQUIRE(date_builder.Append(std::to_string(i)).ok());
+  }
+  auto schema = arrow::schema(
+      {arrow::field(GAR_NAMESPACE::GeneralParams::kSrcIndexCol,
+                    arrow::int64()),
+       arrow::field(GAR_NAMESPACE::GeneralParams::kDstIndexCol,
+                    arrow::int64()),
+       arrow::field("creationDate", arrow::utf8())});
+  auto table = arrow::Table::Make(schema, {src_builder.Finish().ValueOrDie(),
+                                           dst_builder.Finish().ValueOrDie(),
+                                           date_builder.Finish().ValueOrDie()});
+  GAR_NAMESPACE::MultiLayoutEdgeWriter writer(edge_info, prefix);
+  REQUIRE(writer.WriteTable(table, num_vertices, num_vertices, 4).ok());
+  GAR_NAMESPACE::VertexPropertyWriter vertex_writer(vertex_info, prefix);
+  REQUIRE(vertex_writer.WriteVerticesNum(num_vertices).ok());
+
+  // the ordered adj lists keep the order of the edges of each vertex
+  std::vector<std::vector<int64_t>> out_neighbors(num_vertices),
+      in_neighbors(num_vertices);
+  for (int64_t i = 0; i < num_edges; ++i) {
+    out_neighbors[src_of(i)].push_back(dst_of(i));
+    in_neighbors[dst_of(i)].push_back(src_of(i));
+  }
+  auto csr =
+      GAR_NAMESPACE::LoadCSR(edge_info, vertex_info, prefix,
+                             GAR_NAMESPACE::AdjListType::ordered_by_source)
+          .value();
+  auto csc =
+      GAR_NAMESPACE::LoadCSR(edge_info, vertex_info, prefix,
+                             GAR_NAMESPACE::AdjListType::ordered_by_dest)
+          .value();
+  REQUIRE(csr.GetVertexNum() == num_vertices);
+  REQUIRE(csc.GetVertexNum() == num_vertices);
+  for (int64_t vid = 0; vid < num_vertices; ++vid) {
+    auto out = csr.GetNeighbors(vid);
+    REQUIRE(std::vector<int64_t>(out.first, out.second) ==
+            out_neighbors[vid]);
+    auto in = csc.GetNeighbors(vid);
+    REQUIRE(std::vector<int64_t>(in.first, in.second) == in_neighbors[vid]);
+  }
+
+  // the unordered adj list has every edge
+  GAR_NAMESPACE::AdjListArrowChunkReader reader(
+      edge_info, GAR_NAMESPACE::AdjListType::unordered_by_source, prefix);
+  int64_t num_read = 0;
+  while (true) {
+    num_read += reader.GetRowNumOfChunk().value();
+    auto status = reader.next_chunk();
+    if (status.IsOutOfRange()) {
+      break;
+    }
+  }
+  REQUIRE(num_read == num_edges);
+
+  // without edges, only the empty offset chunks are written
+  std::string empty_prefix = "/tmp/multi_layout_edge_writer_empty/";
+  GAR_NAMESPACE::MultiLayoutEdgeWriter empty_writer(edge_info, empty_prefix);
+  REQUIRE(empty_writer.WriteTable(table->Slice(0, 0), num_vertices,
+                                  num_vertices, 4)
+              .ok());
+  GAR_NAMESPACE::VertexPropertyWriter empty_vertex_writer(vertex_info,
+                                                          empty_prefix);
+  REQUIRE(empty_vertex_writer.WriteVerticesNum(num_vertices).ok());
+  auto empty_csr =
+      GAR_NAMESPACE::LoadCSR(edge_info, vertex_info, empty_prefix,
+                             GAR_NAMESPACE::AdjListType::ordered_by_source)
+          .value();
+  REQUIRE(empty_csr.GetEdgeNum() == 0);
+}
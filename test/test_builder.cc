@@ -13,6 +13,7 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 #include <time.h>
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <map>
@@ -30,6 +31,8 @@ limitations under the License.
 
 #include "./config.h"
 #include "gar/graph_info.h"
+#include "gar/reader/arrow_chunk_reader.h"
+#include "gar/reader/csr_reader.h"
 #include "gar/writer/arrow_chunk_writer.h"
 #include "gar/writer/edges_builder.h"
 #include "gar/writer/vertices_builder.h"
@@ -86,6 +89,124 @@ TEST_CASE("test_vertices_builder") {
   REQUIRE((*ptr) == start_index + builder.GetNum());
 }
 
+TEST_CASE("test_vertices_builder_add_vertices") {
+  std::string vertex_meta_file =
+      TEST_DATA_DIR + "/ldbc_sample/parquet/" + "person.vertex.yml";
+  auto vertex_meta = GAR_NAMESPACE::Yaml::LoadFile(vertex_meta_file).value();
+  auto vertex_info = GAR_NAMESPACE::VertexInfo::Load(vertex_meta).value();
+  std::string prefix = "/tmp/vertices_builder_add_vertices/";
+  GAR_NAMESPACE::builder::VerticesBuilder builder(vertex_info, prefix);
+
+  // the vertices come as a table, a record batch at an index, and one by one
+  auto make_table = [](int64_t begin, int64_t end) {
+    arrow::Int64Builder id_builder;
+    arrow::StringBuilder name_builder;
+    for (int64_t i = begin; i < end; ++i) {
+      REQUIRE(id_builder.Append(i).ok());
+      REQUIRE(name_builder.Append("name" + std::to_string(i)).ok());
+    }
+    auto schema = arrow::schema({arrow::field("id", arrow::int64()),
+                                 arrow::field("firstName", arrow::utf8())});
+    return arrow::Table::Make(schema, {id_builder.Finish().ValueOrDie(),
+                                       name_builder.Finish().ValueOrDie()});
+  };
+  REQUIRE(builder.AddVertices(make_table(0, 250)).ok());
+  auto batch = make_table(400, 450)->CombineChunksToBatch().ValueOrDie();
+  REQUIRE(builder.AddVertices(batch, 400).ok());
+  GAR_NAMESPACE::builder::Vertex v;
+  v.AddProperty("id", int64_t(300));
+  REQUIRE(builder.AddVertex(v, 300).ok());
+  GAR_NAMESPACE::builder::Vertex next;
+  next.AddProperty("id", int64_t(450));
+  REQUIRE(builder.AddVertex(next).ok());
+  REQUIRE(next.GetId() == 450);
+  REQUIRE(builder.GetNum() == 302);
+
+  // the types of the columns and values must match the properties
+  auto wrong_table =
+      make_table(0, 10)
+          ->SetColumn(0, arrow::field("id", arrow::utf8()),
+                      make_table(0, 10)->column(1))
+          .ValueOrDie();
+  REQUIRE(builder.AddVertices(wrong_table).IsTypeError());
+  auto unknown_table =
+      make_table(0, 10)
+          ->SetColumn(1, arrow::field("unknown", arrow::utf8()),
+                      make_table(0, 10)->column(1))
+          .ValueOrDie();
+  REQUIRE(builder.AddVertices(unknown_table).IsInvalidOperation());
+  GAR_NAMESPACE::builder::Vertex wrong_vertex;
+  wrong_vertex.AddProperty("id", std::string("0"));
+  REQUIRE(builder.AddVertex(wrong_vertex).IsTypeError());
+  REQUIRE(builder.Dump().ok());
+
+  // the vertices never added are null
+  auto group = vertex_info.GetPropertyGroup("id").value();
+  GAR_NAMESPACE::VertexPropertyArrowChunkReader reader(vertex_info, group,
+                                                       prefix, 3);
+  auto table = reader.GetChunk().value();
+  REQUIRE(table->num_rows() == 100);
+  auto ids = std::static_pointer_cast<arrow::Int64Array>(
+      table->GetColumnByName("id")->chunk(0));
+  REQUIRE(ids->IsValid(0));
+  REQUIRE(ids->Value(0) == 300);
+  REQUIRE(ids->null_count() == 99);
+  REQUIRE(reader.next_chunk().ok());
+  table = reader.GetChunk().value();
+  REQUIRE(table->num_rows() == 51);
+  ids = std::static_pointer_cast<arrow::Int64Array>(
+      table->GetColumnByName("id")->chunk(0));
+  REQUIRE(ids->null_count() == 0);
+  REQUIRE(ids->Value(0) == 400);
+  REQUIRE(ids->Value(50) == 450);
+}
+
+TEST_CASE("test_vertices_builder_streaming") {
+  std::string vertex_meta_file =
+      TEST_DATA_DIR + "/ldbc_sample/parquet/" + "person.vertex.yml";
+  auto vertex_meta = GAR_NAMESPACE::Yaml::LoadFile(vertex_meta_file).value();
+  auto vertex_info = GAR_NAMESPACE::VertexInfo::Load(vertex_meta).value();
+  std::string prefix = "/tmp/vertices_builder_streaming/";
+  GAR_NAMESPACE::IdType start_index = 200;
+  GAR_NAMESPACE::builder::VerticesBuilder builder(vertex_info, prefix,
+                                                  start_index);
+  builder.EnableStreaming(2);
+
+  // a table of several chunks, then the vertices one by one
+  arrow::Int64Builder id_builder;
+  for (int64_t i = 200; i < 555; ++i) {
+    REQUIRE(id_builder.Append(i).ok());
+  }
+  auto schema = arrow::schema({arrow::field("id", arrow::int64())});
+  auto table = arrow::Table::Make(schema, {id_builder.Finish().ValueOrDie()});
+  REQUIRE(builder.AddVertices(table).ok());
+  for (int64_t i = 555; i < 1000; ++i) {
+    GAR_NAMESPACE::builder::Vertex v;
+    v.AddProperty("id", i);
+    REQUIRE(builder.AddVertex(v).ok());
+  }
+  // the flushed vertices can not be added again
+  GAR_NAMESPACE::builder::Vertex v;
+  v.AddProperty("id", int64_t(250));
+  REQUIRE(builder.AddVertex(v, 250).IsInvalidOperation());
+  REQUIRE(builder.GetNum() == 800);
+  REQUIRE(builder.Dump().ok());
+
+  auto group = vertex_info.GetPropertyGroup("id").value();
+  for (GAR_NAMESPACE::IdType chunk_index = 2; chunk_index < 10;
+       ++chunk_index) {
+    GAR_NAMESPACE::VertexPropertyArrowChunkReader reader(vertex_info, group,
+                                                         prefix, chunk_index);
+    auto chunk = reader.GetChunk().value();
+    REQUIRE(chunk->num_rows() == 100);
+    auto ids = std::static_pointer_cast<arrow::Int64Array>(
+        chunk->GetColumnByName("id")->chunk(0));
+    for (int64_t i = 0; i < 100; ++i) {
+      REQUIRE(ids->Value(i) == chunk_index * 100 + i);
+    }
+  }
+}
+
 TEST_CASE("test_edges_builder") {
   std::string edge_meta_file =
       TEST_DATA_DIR + "/ldbc_sample/parquet/" + "person_knows_person.edge.yml";
@@ -125,3 +246,218 @@ TEST_CASE("test_edges_builder") {
   std::cout << "Test edge builder" << std::endl;
   REQUIRE(builder.Dump().ok());
 }
+
+TEST_CASE("test_edges_builder_add_edges") {
+  std::string edge_meta_file =
+      TEST_DATA_DIR + "/ldbc_sample/parquet/" + "person_knows_person.edge.yml";
+  auto edge_meta = GAR_NAMESPACE::Yaml::LoadFile(edge_meta_file).value();
+  auto edge_info = GAR_NAMESPACE::EdgeInfo::Load(edge_meta).value();
+  std::string vertex_meta_file =
+      TEST_DATA_DIR + "/ldbc_sample/parquet/" + "person.vertex.yml";
+  auto vertex_meta = GAR_NAMESPACE::Yaml::LoadFile(vertex_meta_file).value();
+  auto vertex_info = GAR_NAMESPACE::VertexInfo::Load(vertex_meta).value();
+  std::string prefix = "/tmp/edges_builder_add_edges/";
+  GAR_NAMESPACE::IdType num_vertices = 903;
+  GAR_NAMESPACE::builder::EdgesBuilder builder(
+      edge_info, prefix, GAR_NAMESPACE::AdjListType::ordered_by_source,
+      num_vertices);
+
+  // the edges come as a table, a record batch, and one by one
+  int64_t num_edges = 3000;
+  auto make_table = [&](int64_t begin, int64_t end) {
+    arrow::Int64Builder src_builder, dst_builder;
+    arrow::StringBuilder date_builder;
+    for (int64_t i = begin; i < end; ++i) {
+      REQUIRE(src_builder.Append(i * 7 % num_vertices).ok());
+      REQUIRE(dst_builder.Append((i * 13 + 5) % num_vertices).ok());
+      REQUIRE(date_builder.Append(std::to_string(i)).ok());
+    }
+    auto schema = arrow::schema(
+        {arrow::field(GAR_NAMESPACE::GeneralParams::kSrcIndexCol,
+                      arrow::int64()),
+         arrow::field(GAR_NAMESPACE::GeneralParams::kDstIndexCol,
+                      arrow::int64()),
+         arrow::field("creationDate", arrow::utf8())});
+    return arrow::Table::Make(schema, {src_builder.Finish().ValueOrDie(),
+                                       dst_builder.Finish().ValueOrDie(),
+                                       date_builder.Finish().ValueOrDie()});
+  };
+  REQUIRE(builder.AddEdges(make_table(0, 1000)).ok());
+  auto batch = make_table(1000, 2000)->CombineChunksToBatch().ValueOrDie();
+  REQUIRE(builder.AddEdges(batch).ok());
+  for (int64_t i = 2000; i < num_edges; ++i) {
+    GAR_NAMESPACE::builder::Edge e(i * 7 % num_vertices,
+                                   (i * 13 + 5) % num_vertices);
+    e.AddProperty("creationDate", std::to_string(i));
+    REQUIRE(builder.AddEdge(e).ok());
+  }
+  REQUIRE(builder.GetNum() == num_edges);
+
+  // the types of the columns and values must match the properties
+  auto wrong_table = make_table(0, 10)
+                         ->SetColumn(2, arrow::field("creationDate",
+                                                     arrow::int64()),
+                                     make_table(0, 10)->column(0))
+                         .ValueOrDie();
+  REQUIRE(builder.AddEdges(wrong_table).IsTypeError());
+  GAR_NAMESPACE::builder::Edge wrong_edge(0, 1);
+  wrong_edge.AddProperty("creationDate", int64_t(0));
+  REQUIRE(builder.AddEdge(wrong_edge).IsTypeError());
+  REQUIRE(builder.GetNum() == num_edges);
+  REQUIRE(builder.Dump().ok());
+  GAR_NAMESPACE::VertexPropertyWriter vertex_writer(vertex_info, prefix);
+  REQUIRE(vertex_writer.WriteVerticesNum(num_vertices).ok());
+
+  // the dumped adj list has every edge under its source
+  auto csr =
+      GAR_NAMESPACE::LoadCSR(edge_info, vertex_info, prefix,
+                             GAR_NAMESPACE::AdjListType::ordered_by_source)
+          .value();
+  REQUIRE(csr.GetEdgeNum() == num_edges);
+  std::vector<std::vector<GAR_NAMESPACE::IdType>> expected(num_vertices);
+  for (int64_t i = 0; i < num_edges; ++i) {
+    expected[i * 7 % num_vertices].push_back((i * 13 + 5) % num_vertices);
+  }
+  for (GAR_NAMESPACE::IdType vid = 0; vid < num_vertices; ++vid) {
+    auto range = csr.GetNeighbors(vid);
+    std::vector<GAR_NAMESPACE::IdType> neighbors(range.first, range.second);
+    REQUIRE(neighbors == expected[vid]);
+  }
+}
+
+TEST_CASE("test_edges_builder_spill") {
+  std::string edge_meta_file =
+      TEST_DATA_DIR + "/ldbc_sample/parquet/" + "person_knows_person.edge.yml";
+  auto edge_meta = GAR_NAMESPACE::Yaml::LoadFile(edge_meta_file).value();
+  auto edge_info = GAR_NAMESPACE::EdgeInfo::Load(edge_meta).value();
+  std::string vertex_meta_file =
+      TEST_DATA_DIR + "/ldbc_sample/parquet/" + "person.vertex.yml";
+  auto vertex_meta = GAR_NAMESPACE::Yaml::LoadFile(vertex_meta_file).value();
+  auto vertex_info = GAR_NAMESPACE::VertexInfo::Load(vertex_meta).value();
+  std::string prefix = "/tmp/edges_builder_spill/";
+  GAR_NAMESPACE::IdType num_vertices = 903;
+  GAR_NAMESPACE::builder::EdgesBuilder builder(
+      edge_info, prefix, GAR_NAMESPACE::AdjListType::ordered_by_dest,
+      num_vertices);
+  // a budget of a few hundred edges, so that many runs are spilled
+  builder.SetMemoryBudget(8 * 1024, "/tmp/");
+
+  int64_t num_edges = 5000;
+  auto src_of = [&](int64_t i) { return i * 7 % num_vertices; };
+  auto dst_of = [&](int64_t i) { return (i * 13 + 5) % num_vertices; };
+  for (int64_t begin = 0; begin < num_edges; begin += 1000) {
+    // half of the edges come as a table, and half one by one
+    int64_t mid = begin + 500, end = begin + 1000;
+    arrow::Int64Builder src_builder, dst_builder;
+    arrow::StringBuilder date_builder;
+    for (int64_t i = begin; i < mid; ++i) {
+      REQUIRE(src_builder.Append(src_of(i)).ok());
+      REQUIRE(dst_builder.Append(dst_of(i)).ok());
+      REQUIRE(date_builder.Append(std::to_string(i)).ok());
+    }
+    auto schema = arrow::schema(
+        {arrow::field(GAR_NAMESPACE::GeneralParams::kSrcIndexCol,
+                      arrow::int64()),
+         arrow::field(GAR_NAMESPACE::GeneralParams::kDstIndexCol,
+                      arrow::int64()),
+         arrow::field("creationDate", arrow::utf8())});
+    auto table =
+        arrow::Table::Make(schema, {src_builder.Finish().ValueOrDie(),
+                                    dst_builder.Finish().ValueOrDie(),
+                                    date_builder.Finish().ValueOrDie()});
+    REQUIRE(builder.AddEdges(table).ok());
+    for (int64_t i = mid; i < end; ++i) {
+      GAR_NAMESPACE::builder::Edge e(src_of(i), dst_of(i));
+      e.AddProperty("creationDate", std::to_string(i));
+      REQUIRE(builder.AddEdge(e).ok());
+    }
+  }
+  REQUIRE(builder.GetNum() == num_edges);
+  // the vertex chunks are merged by multiple threads
+  REQUIRE(builder.Dump(4).ok());
+  GAR_NAMESPACE::VertexPropertyWriter vertex_writer(vertex_info, prefix);
+  REQUIRE(vertex_writer.WriteVerticesNum(num_vertices).ok());
+
+  // the merged adj list keeps the edges of a vertex in the order they are
+  // added
+  auto csc = GAR_NAMESPACE::LoadCSR(edge_info, vertex_info, prefix,
+                                    GAR_NAMESPACE::AdjListType::ordered_by_dest)
+                 .value();
+  REQUIRE(csc.GetEdgeNum() == num_edges);
+  std::vector<std::vector<GAR_NAMESPACE::IdType>> expected(num_vertices);
+  for (int64_t i = 0; i < num_edges; ++i) {
+    expected[dst_of(i)].push_back(src_of(i));
+  }
+  for (GAR_NAMESPACE::IdType vid = 0; vid < num_vertices; ++vid) {
+    auto range = csc.GetNeighbors(vid);
+    std::vector<GAR_NAMESPACE::IdType> neighbors(range.first, range.second);
+    REQUIRE(neighbors == expected[vid]);
+  }
+}
+
+TEST_CASE("test_edges_builder_spill_all") {
+  std::string edge_meta_file =
+      TEST_DATA_DIR + "/ldbc_sample/parquet/" + "person_knows_person.edge.yml";
+  auto edge_meta = GAR_NAMESPACE::Yaml::LoadFile(edge_meta_file).value();
+  auto edge_info = GAR_NAMESPACE::EdgeInfo::Load(edge_meta).value();
+  std::string vertex_meta_file =
+      TEST_DATA_DIR + "/ldbc_sample/parquet/" + "person.vertex.yml";
+  auto vertex_meta = GAR_NAMESPACE::Yaml::LoadFile(vertex_meta_file).value();
+  auto vertex_info = GAR_NAMESPACE::VertexInfo::Load(vertex_meta).value();
+  GAR_NAMESPACE::IdType num_vertices = 903;
+
+  // every adding spills, so nothing is buffered in memory when dumping
+  std::string prefix = "/tmp/edges_builder_spill_all/";
+  GAR_NAMESPACE::builder::EdgesBuilder builder(
+      edge_info, prefix, GAR_NAMESPACE::AdjListType::ordered_by_source,
+      num_vertices);
+  builder.SetMemoryBudget(1, "/tmp/");
+  int64_t num_edges = 1000;
+  std::vector<std::vector<GAR_NAMESPACE::IdType>> expected(num_vertices);
+  for (int64_t begin = 0; begin < num_edges; begin += 100) {
+    arrow::Int64Builder src_builder, dst_builder;
+    for (int64_t i = begin; i < begin + 100; ++i) {
+      REQUIRE(src_builder.Append(i * 7 % num_vertices).ok());
+      REQUIRE(dst_builder.Append((i * 13 + 5) % num_vertices).ok());
+      expected[i * 7 % num_vertices].push_back((i * 13 + 5) % num_vertices);
+    }
+    auto schema = arrow::schema(
+        {arrow::field(GAR_NAMESPACE::GeneralParams::kSrcIndexCol,
+                      arrow::int64()),
+         arrow::field(GAR_NAMESPACE::GeneralParams::kDstIndexCol,
+                      arrow::int64())});
+    auto table =
+        arrow::Table::Make(schema, {src_builder.Finish().ValueOrDie(),
+                                    dst_builder.Finish().ValueOrDie()});
+    REQUIRE(builder.AddEdges(table).ok());
+  }
+  REQUIRE(builder.Dump(4).ok());
+  GAR_NAMESPACE::VertexPropertyWriter vertex_writer(vertex_info, prefix);
+  REQUIRE(vertex_writer.WriteVerticesNum(num_vertices).ok());
+  auto csr = GAR_NAMESPACE::LoadCSR(
+                 edge_info, vertex_info, prefix,
+                 GAR_NAMESPACE::AdjListType::ordered_by_source)
+                 .value();
+  REQUIRE(csr.GetEdgeNum() == num_edges);
+  for (GAR_NAMESPACE::IdType vid = 0; vid < num_vertices; ++vid) {
+    auto range = csr.GetNeighbors(vid);
+    REQUIRE(std::vector<GAR_NAMESPACE::IdType>(range.first, range.second) ==
+            expected[vid]);
+  }
+
+  // without edges, only the empty offset chunks are written
+  std::string empty_prefix = "/tmp/edges_builder_no_edges/";
+  GAR_NAMESPACE::builder::EdgesBuilder empty_builder(
+      edge_info, empty_prefix, GAR_NAMESPACE::AdjListType::ordered_by_source,
+      num_vertices);
+  REQUIRE(empty_builder.GetNum() == 0);
+  REQUIRE(empty_builder.Dump().ok());
+  GAR_NAMESPACE::VertexPropertyWriter empty_vertex_writer(vertex_info,
+                                                          empty_prefix);
+  REQUIRE(empty_vertex_writer.WriteVerticesNum(num_vertices).ok());
+  auto empty_csr = GAR_NAMESPACE::LoadCSR(
+                       edge_info, vertex_info, empty_prefix,
+                       GAR_NAMESPACE::AdjListType::ordered_by_source)
+                       .value();
+  REQUIRE(empty_csr.GetEdgeNum() == 0);
+}
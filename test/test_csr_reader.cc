@@ -0,0 +1,160 @@
+/** Copyright 2022 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <vector>
+
+#include "./config.h"
+#include "gar/graph.h"
+#include "gar/reader/csr_reader.h"
+#include "gar/utils/reader_utils.h"
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+TEST_CASE("test_load_csr") {
+  std::string path =
+      TEST_DATA_DIR + "/ldbc_sample/parquet/ldbc_sample.graph.yml";
+  std::string src_label = "person", edge_label = "knows", dst_label = "person";
+  auto graph_info = GAR_NAMESPACE::GraphInfo::Load(path).value();
+
+  // the CSR holds the same edges as the collection, in the same order
+  auto maybe_csr = GAR_NAMESPACE::LoadCSR(graph_info, src_label, edge_label,
+                                          dst_label);
+  REQUIRE(!maybe_csr.has_error());
+  auto& csr = maybe_csr.value();
+  auto expect = GAR_NAMESPACE::ConstructEdgesCollection(
+      graph_info, src_label, edge_label, dst_label,
+      GAR_NAMESPACE::AdjListType::ordered_by_source);
+  REQUIRE(!expect.has_error());
+  auto& edges = std::get<GAR_NAMESPACE::EdgesCollection<
+      GAR_NAMESPACE::AdjListType::ordered_by_source>>(expect.value());
+  GAR_NAMESPACE::IdType edge_index = 0;
+  for (auto it = edges.begin(); it != edges.end(); ++it, ++edge_index) {
+    REQUIRE(edge_index < csr.GetEdgeNum());
+    auto range = csr.GetNeighbors(it.source());
+    REQUIRE(csr.GetNeighbors() + edge_index >= range.first);
+    REQUIRE(csr.GetNeighbors() + edge_index < range.second);
+    REQUIRE(csr.GetNeighbors()[edge_index] == it.destination());
+  }
+  REQUIRE(edge_index == csr.GetEdgeNum());
+  // the number of vertices is the vertex count, not the padded length of the
+  // offset chunks
+  auto vertex_info = graph_info.GetVertexInfo(src_label).value();
+  REQUIRE(csr.GetVertexNum() ==
+          GAR_NAMESPACE::utils::GetVertexNum(graph_info.GetPrefix(),
+                                             vertex_info)
+              .value());
+  REQUIRE(csr.GetOffsets()[0] == 0);
+  REQUIRE(csr.GetOffsets()[csr.GetVertexNum()] == csr.GetEdgeNum());
+
+  // the CSC has the same number of edges, and is independent of the number
+  // of threads
+  auto maybe_csc = GAR_NAMESPACE::LoadCSR(
+      graph_info, src_label, edge_label, dst_label,
+      GAR_NAMESPACE::AdjListType::ordered_by_dest, 1);
+  REQUIRE(!maybe_csc.has_error());
+  auto& csc = maybe_csc.value();
+  REQUIRE(csc.GetVertexNum() == csr.GetVertexNum());
+  REQUIRE(csc.GetEdgeNum() == csr.GetEdgeNum());
+  auto maybe_csc2 = GAR_NAMESPACE::LoadCSR(
+      graph_info, src_label, edge_label, dst_label,
+      GAR_NAMESPACE::AdjListType::ordered_by_dest, 4);
+  REQUIRE(!maybe_csc2.has_error());
+  auto& csc2 = maybe_csc2.value();
+  REQUIRE(csc2.GetVertexNum() == csc.GetVertexNum());
+  REQUIRE(csc2.GetNeighborsArray()->Equals(*csc.GetNeighborsArray()));
+  REQUIRE(csc2.GetOffsetsArray()->Equals(*csc.GetOffsetsArray()));
+
+  // the unordered adj list can not be loaded as CSR
+  auto maybe_unordered = GAR_NAMESPACE::LoadCSR(
+      graph_info, src_label, edge_label, dst_label,
+      GAR_NAMESPACE::AdjListType::unordered_by_source);
+  REQUIRE(maybe_unordered.status().IsInvalid());
+}
+
+TEST_CASE("test_load_compressed_csr") {
+  std::string path =
+      TEST_DATA_DIR + "/ldbc_sample/parquet/ldbc_sample.graph.yml";
+  std::string src_label = "person", edge_label = "knows", dst_label = "person";
+  auto graph_info = GAR_NAMESPACE::GraphInfo::Load(path).value();
+
+  auto maybe_csr = GAR_NAMESPACE::LoadCSR(graph_info, src_label, edge_label,
+                                          dst_label);
+  REQUIRE(!maybe_csr.has_error());
+  auto& csr = maybe_csr.value();
+  auto maybe_compressed = GAR_NAMESPACE::LoadCompressedCSR(
+      graph_info, src_label, edge_label, dst_label);
+  REQUIRE(!maybe_compressed.has_error());
+  auto& compressed = maybe_compressed.value();
+  REQUIRE(compressed.GetVertexNum() == csr.GetVertexNum());
+  REQUIRE(compressed.GetEdgeNum() == csr.GetEdgeNum());
+
+  // the compressed neighbors are the sorted neighbors of the CSR
+  std::vector<GAR_NAMESPACE::IdType> expected, neighbors;
+  for (GAR_NAMESPACE::IdType v = 0; v < csr.GetVertexNum(); ++v) {
+    REQUIRE(compressed.GetDegree(v) == csr.GetDegree(v));
+    csr.GetNeighbors(v, &expected);
+    std::sort(expected.begin(), expected.end());
+    compressed.GetNeighbors(v, &neighbors);
+    REQUIRE(neighbors == expected);
+    for (auto neighbor : expected) {
+      REQUIRE(compressed.HasNeighbor(v, neighbor));
+    }
+    REQUIRE(!compressed.HasNeighbor(v, -1));
+    // both find the first neighbor in their order
+    auto is_odd = [](GAR_NAMESPACE::IdType neighbor) {
+      return neighbor % 2 == 1;
+    };
+    auto odd = std::find_if(expected.begin(), expected.end(), is_odd);
+    REQUIRE(compressed.FindNeighbor(v, is_odd) ==
+            (odd == expected.end() ? -1 : *odd));
+    REQUIRE((csr.FindNeighbor(v, is_odd) == -1) == (odd == expected.end()));
+  }
+}
+
+TEST_CASE("test_compute_degrees") {
+  std::string path =
+      TEST_DATA_DIR + "/ldbc_sample/parquet/ldbc_sample.graph.yml";
+  std::string src_label = "person", edge_label = "knows", dst_label = "person";
+  auto graph_info = GAR_NAMESPACE::GraphInfo::Load(path).value();
+
+  for (auto adj_list_type : {GAR_NAMESPACE::AdjListType::ordered_by_source,
+                             GAR_NAMESPACE::AdjListType::ordered_by_dest}) {
+    auto maybe_csr = GAR_NAMESPACE::LoadCSR(graph_info, src_label, edge_label,
+                                            dst_label, adj_list_type);
+    REQUIRE(!maybe_csr.has_error());
+    auto& csr = maybe_csr.value();
+    auto maybe_degrees = GAR_NAMESPACE::ComputeDegrees(
+        graph_info, src_label, edge_label, dst_label, adj_list_type);
+    REQUIRE(!maybe_degrees.has_error());
+    auto degrees = maybe_degrees.value();
+    REQUIRE(degrees->length() == csr.GetVertexNum());
+    for (GAR_NAMESPACE::IdType vid = 0; vid < csr.GetVertexNum(); ++vid) {
+      REQUIRE(degrees->Value(vid) == csr.GetDegree(vid));
+    }
+
+    // the unordered adj list gives the same degrees by counting the edges
+    if (adj_list_type == GAR_NAMESPACE::AdjListType::ordered_by_source) {
+      auto maybe_counted = GAR_NAMESPACE::ComputeDegrees(
+          graph_info, src_label, edge_label, dst_label,
+          GAR_NAMESPACE::AdjListType::unordered_by_source, 2);
+      REQUIRE(!maybe_counted.has_error());
+      auto counted = maybe_counted.value();
+      REQUIRE(counted->length() == csr.GetVertexNum());
+      REQUIRE(counted->Equals(*degrees));
+    }
+  }
+}
@@ -0,0 +1,108 @@
+/** Copyright 2022 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "./config.h"
+#include "gar/reader/csr_reader.h"
+#include "gar/reader/frontier_reader.h"
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+TEST_CASE("test_for_each_active_edge") {
+  std::string path =
+      TEST_DATA_DIR + "/ldbc_sample/parquet/ldbc_sample.graph.yml";
+  std::string src_label = "person", edge_label = "knows", dst_label = "person";
+  auto graph_info = GAR_NAMESPACE::GraphInfo::Load(path).value();
+  auto maybe_csr = GAR_NAMESPACE::LoadCSR(graph_info, src_label, edge_label,
+                                          dst_label);
+  REQUIRE(!maybe_csr.has_error());
+  auto& csr = maybe_csr.value();
+  GAR_NAMESPACE::IdType vertex_num = csr.GetVertexNum();
+
+  std::mutex mutex;
+  std::vector<std::pair<GAR_NAMESPACE::IdType, GAR_NAMESPACE::IdType>> edges;
+  auto collect = [&](GAR_NAMESPACE::IdType v, GAR_NAMESPACE::IdType u) {
+    std::lock_guard<std::mutex> lock(mutex);
+    edges.emplace_back(v, u);
+  };
+
+  // the edges of a single active vertex are its neighbors
+  GAR_NAMESPACE::util::Bitmap active(vertex_num);
+  GAR_NAMESPACE::IdType vid = 0;
+  while (vid < vertex_num && csr.GetDegree(vid) == 0) {
+    ++vid;
+  }
+  REQUIRE(vid < vertex_num);
+  active.Set(vid);
+  auto maybe_chunk_num = GAR_NAMESPACE::ForEachActiveEdge(
+      graph_info, src_label, edge_label, dst_label,
+      GAR_NAMESPACE::AdjListType::ordered_by_source, active, collect);
+  REQUIRE(!maybe_chunk_num.has_error());
+  REQUIRE(maybe_chunk_num.value() >= 1);
+  auto range = csr.GetNeighbors(vid);
+  std::vector<GAR_NAMESPACE::IdType> expected(range.first, range.second),
+      neighbors;
+  for (const auto& edge : edges) {
+    REQUIRE(edge.first == vid);
+    neighbors.push_back(edge.second);
+  }
+  std::sort(expected.begin(), expected.end());
+  std::sort(neighbors.begin(), neighbors.end());
+  REQUIRE(neighbors == expected);
+
+  // the unordered adj list gives the same edges, but reads all the chunks of
+  // the vertex chunk
+  edges.clear();
+  auto maybe_unordered_chunk_num = GAR_NAMESPACE::ForEachActiveEdge(
+      graph_info, src_label, edge_label, dst_label,
+      GAR_NAMESPACE::AdjListType::unordered_by_source, active, collect, 2);
+  REQUIRE(!maybe_unordered_chunk_num.has_error());
+  REQUIRE(maybe_unordered_chunk_num.value() >= maybe_chunk_num.value());
+  neighbors.clear();
+  for (const auto& edge : edges) {
+    REQUIRE(edge.first == vid);
+    neighbors.push_back(edge.second);
+  }
+  std::sort(neighbors.begin(), neighbors.end());
+  REQUIRE(neighbors == expected);
+
+  // all the edges are visited if all the vertices are active
+  for (GAR_NAMESPACE::IdType v = 0; v < vertex_num; ++v) {
+    active.Set(v);
+  }
+  REQUIRE(active.Count() == vertex_num);
+  edges.clear();
+  REQUIRE(!GAR_NAMESPACE::ForEachActiveEdge(
+               graph_info, src_label, edge_label, dst_label,
+               GAR_NAMESPACE::AdjListType::ordered_by_source, active, collect)
+               .has_error());
+  REQUIRE(static_cast<GAR_NAMESPACE::IdType>(edges.size()) ==
+          csr.GetEdgeNum());
+
+  // nothing is read if no vertex is active
+  active.Clear();
+  edges.clear();
+  auto maybe_empty = GAR_NAMESPACE::ForEachActiveEdge(
+      graph_info, src_label, edge_label, dst_label,
+      GAR_NAMESPACE::AdjListType::ordered_by_dest, active, collect);
+  REQUIRE(!maybe_empty.has_error());
+  REQUIRE(maybe_empty.value() == 0);
+  REQUIRE(edges.empty());
+}
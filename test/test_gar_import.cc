@@ -0,0 +1,114 @@
+/** Copyright 2022 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "./config.h"
+#include "gar/graph_info.h"
+#include "gar/reader/csr_reader.h"
+#include "gar/utils/reader_utils.h"
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+// run gar-import, and return its exit code
+int RunImport(const std::string& arguments) {
+  std::string command = std::string(GAR_IMPORT_PATH) + " " + arguments;
+  return std::system(command.c_str());
+}
+
+TEST_CASE("test_gar_import") {
+  std::string graph_path =
+      TEST_DATA_DIR + "/ldbc_sample/parquet/ldbc_sample.graph.yml";
+  std::string source_dir = "/tmp/gar_import_sources/";
+  REQUIRE(std::system(("mkdir -p " + source_dir).c_str()) == 0);
+
+  // the vertices, with ids other than their indices
+  int64_t num_vertices = 250, num_edges = 2000;
+  auto id_of = [](int64_t index) { return 1000 + index * 3; };
+  {
+    std::ofstream person(source_dir + "person.csv");
+    person << "id,firstName,lastName,gender\n";
+    for (int64_t i = 0; i < num_vertices; ++i) {
+      person << id_of(i) << ",first" << i << ",last" << i << ",female\n";
+    }
+  }
+  // the edges, and the edges of unknown vertices which are dropped
+  std::vector<std::vector<GAR_NAMESPACE::IdType>> expected(num_vertices);
+  {
+    std::ofstream knows(source_dir + "knows.csv");
+    knows << "src,dst,creationDate\n";
+    for (int64_t i = 0; i < num_edges; ++i) {
+      int64_t src = i * 7 % num_vertices, dst = (i * 13 + 5) % num_vertices;
+      knows << id_of(src) << "," << id_of(dst) << ",date" << i << "\n";
+      expected[src].push_back(dst);
+    }
+    std::ofstream unknown(source_dir + "unknown.csv");
+    unknown << "src,dst,creationDate\n";
+    for (int64_t i = 0; i < 10; ++i) {
+      unknown << id_of(i) << ",1," << "date\n";
+    }
+    std::ofstream empty(source_dir + "empty.csv");
+    empty << "src,dst,creationDate\n";
+  }
+  std::string vertex_args = " --graph " + graph_path +
+                            " --vertex person=" + source_dir + "person.csv" +
+                            " --vertex-key person=id";
+
+  // in memory, and with a budget that spills every adding
+  for (std::string budget : {"", " --memory-budget 1K"}) {
+    std::string prefix = "/tmp/gar_import" +
+                         std::string(budget.empty() ? "" : "_budget") + "/";
+    REQUIRE(RunImport(vertex_args + budget + " --output " + prefix +
+                      " --threads 4 --edge person:knows:person=" +
+                      source_dir + "knows.csv," + source_dir +
+                      "unknown.csv," + source_dir + "empty.csv") == 0);
+
+    auto graph_info = GAR_NAMESPACE::GraphInfo::Load(
+                          prefix + "ldbc_sample.graph.yml")
+                          .value();
+    auto vertex_info = graph_info.GetVertexInfo("person").value();
+    REQUIRE(GAR_NAMESPACE::utils::GetVertexNum(prefix, vertex_info).value() ==
+            num_vertices);
+    auto edge_info =
+        graph_info.GetEdgeInfo("person", "knows", "person").value();
+    auto csr =
+        GAR_NAMESPACE::LoadCSR(edge_info, vertex_info, prefix,
+                               GAR_NAMESPACE::AdjListType::ordered_by_source)
+            .value();
+    REQUIRE(csr.GetEdgeNum() == num_edges);
+    for (int64_t vid = 0; vid < num_vertices; ++vid) {
+      auto range = csr.GetNeighbors(vid);
+      REQUIRE(std::vector<GAR_NAMESPACE::IdType>(range.first, range.second) ==
+              expected[vid]);
+    }
+
+    // the edge files without edges after dropping, or without rows
+    REQUIRE(RunImport(vertex_args + budget + " --output " + prefix +
+                      "no_edges/ --edge person:knows:person=" + source_dir +
+                      "unknown.csv") == 0);
+    REQUIRE(RunImport(vertex_args + budget + " --output " + prefix +
+                      "empty/ --edge person:knows:person=" + source_dir +
+                      "empty.csv") == 0);
+  }
+
+  // the errors are reported by the exit code
+  REQUIRE(RunImport("--graph " + graph_path + " --vertex person=" +
+                    source_dir + "missing.csv") != 0);
+  REQUIRE(RunImport("--unknown-option x") != 0);
+}
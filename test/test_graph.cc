@@ -13,7 +13,10 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 
+#include <algorithm>
 #include <iostream>
+#include <map>
+#include <vector>
 
 #include "./config.h"
 #include "gar/graph.h"
@@ -47,6 +50,40 @@ TEST_CASE("test_vertices_collection") {
               << ", firstName="
               << vertex.property<std::string>("firstName").value() << std::endl;
   }
+
+  // access data through typed property accessors
+  GAR_NAMESPACE::PropertyColumn<int64_t> id_column("id");
+  GAR_NAMESPACE::PropertyColumn<std::string> name_column("firstName");
+  for (auto it = vertices.begin(); it != vertices.end(); ++it) {
+    REQUIRE(it.property(id_column).value() ==
+            it.property<int64_t>("id").value());
+    REQUIRE(it.property(name_column).value() ==
+            it.property<std::string>("firstName").value());
+  }
+  // type mismatch is reported on binding
+  GAR_NAMESPACE::PropertyColumn<int32_t> wrong_column("id");
+  REQUIRE(vertices.begin().property(wrong_column).status().IsTypeError());
+  REQUIRE(vertices.begin().property<int32_t>("id").status().IsTypeError());
+
+  // load whole property columns
+  auto maybe_ids = vertices.LoadColumn<int64_t>("id");
+  REQUIRE(!maybe_ids.has_error());
+  auto ids = maybe_ids.value();
+  REQUIRE(ids->length() == static_cast<int64_t>(vertices.size()));
+  auto maybe_names = vertices.LoadColumns({"firstName", "lastName"}, 2);
+  REQUIRE(!maybe_names.has_error());
+  auto names = maybe_names.value();
+  REQUIRE(names->num_columns() == 2);
+  REQUIRE(names->num_rows() == static_cast<int64_t>(vertices.size()));
+  auto first_names = names->GetColumnByName("firstName");
+  int64_t index = 0;
+  for (auto it = vertices.begin(); it != vertices.end(); ++it, ++index) {
+    REQUIRE(ids->Value(index) == it.property<int64_t>("id").value());
+    auto name = first_names->GetScalar(index).ValueOrDie()->ToString();
+    REQUIRE(name == it.property<std::string>("firstName").value());
+  }
+  REQUIRE(vertices.LoadColumn<int32_t>("id").status().IsTypeError());
+  REQUIRE(vertices.LoadColumns({"not_exist"}).status().IsKeyError());
 }
 
 TEST_CASE("test_edges_collection", "[Slow]") {
@@ -71,6 +108,42 @@ TEST_CASE("test_edges_collection", "[Slow]") {
     std::cout << "src=" << edge.source() << ", dst=" << edge.destination()
               << std::endl;
   }
+  // iterate edges of vertex chunk 0 with projected properties
+  std::vector<std::string> date_property = {"creationDate"};
+  auto expect_topology = GAR_NAMESPACE::ConstructEdgesCollectionWithProperties(
+      graph_info, src_label, edge_label, dst_label,
+      GAR_NAMESPACE::AdjListType::ordered_by_source, 0, {});
+  REQUIRE(!expect_topology.has_error());
+  auto& topology = std::get<GAR_NAMESPACE::EdgesCollection<
+      GAR_NAMESPACE::AdjListType::ordered_by_source>>(expect_topology.value());
+  auto expect_projected = GAR_NAMESPACE::ConstructEdgesCollectionWithProperties(
+      graph_info, src_label, edge_label, dst_label,
+      GAR_NAMESPACE::AdjListType::ordered_by_source, 0, date_property);
+  REQUIRE(!expect_projected.has_error());
+  auto& projected = std::get<GAR_NAMESPACE::EdgesCollection<
+      GAR_NAMESPACE::AdjListType::ordered_by_source>>(expect_projected.value());
+  auto it = edges.begin();
+  auto topology_it = topology.begin();
+  auto projected_it = projected.begin();
+  for (; it != end; ++it, ++topology_it, ++projected_it) {
+    REQUIRE(topology_it.source() == it.source());
+    REQUIRE(topology_it.destination() == it.destination());
+    REQUIRE(projected_it.source() == it.source());
+    REQUIRE(projected_it.property<std::string>("creationDate").value() ==
+            it.property<std::string>("creationDate").value());
+    REQUIRE(topology_it.property<std::string>("creationDate")
+                .status()
+                .IsKeyError());
+  }
+  REQUIRE(topology_it == topology.end());
+  REQUIRE(projected_it == projected.end());
+  // an unknown property is rejected
+  std::vector<std::string> unknown_property = {"not_exist"};
+  REQUIRE(GAR_NAMESPACE::ConstructEdgesCollectionWithProperties(
+              graph_info, src_label, edge_label, dst_label,
+              GAR_NAMESPACE::AdjListType::ordered_by_source, unknown_property)
+              .has_error());
+
   // iterate all edges
   auto expect2 = GAR_NAMESPACE::ConstructEdgesCollection(
       graph_info, src_label, edge_label, dst_label,
@@ -84,4 +157,62 @@ TEST_CASE("test_edges_collection", "[Slow]") {
     std::cout << "src=" << edge.source() << ", dst=" << edge.destination()
               << std::endl;
   }
+
+  // copies of an iterator are independent cursors
+  auto first = edges2.begin();
+  auto second = first;
+  ++second;
+  REQUIRE(first == edges2.begin());
+  REQUIRE(first != second);
+  auto copy = second;
+  REQUIRE(copy == second);
+  REQUIRE(copy.source() == second.source());
+  REQUIRE(copy.destination() == second.destination());
+  // find the out-going edges of a vertex
+  auto found = edges2.find_src(second.source(), edges2.begin());
+  REQUIRE(found != end2);
+  REQUIRE(found.source() == second.source());
+
+  // query the neighbors of vertices directly
+  std::map<GAR_NAMESPACE::IdType, std::vector<GAR_NAMESPACE::IdType>> expected;
+  for (auto it = edges2.begin(); it != end2; ++it) {
+    expected[it.source()].push_back(it.destination());
+  }
+  for (const auto& pair : expected) {
+    auto maybe_neighbors = edges2.Neighbors(pair.first);
+    REQUIRE(!maybe_neighbors.has_error());
+    auto& neighbors = maybe_neighbors.value();
+    REQUIRE(neighbors.size() ==
+            static_cast<GAR_NAMESPACE::IdType>(pair.second.size()));
+    std::vector<GAR_NAMESPACE::IdType> ids(neighbors.begin(), neighbors.end());
+    REQUIRE(ids == pair.second);
+    REQUIRE(neighbors[0] == pair.second[0]);
+  }
+  auto without_properties = edges2.Neighbors(first.source()).value();
+  REQUIRE(without_properties.property<std::string>("creationDate", 0)
+              .status()
+              .IsInvalid());
+  auto with_properties = edges2.Neighbors(first.source(), true).value();
+  REQUIRE(with_properties.property<std::string>("creationDate", 0).value() ==
+          first.property<std::string>("creationDate").value());
+  REQUIRE(edges2.Neighbors(-1).status().IsKeyError());
+
+  // query the neighbors of a batch of vertices, in any order
+  std::vector<GAR_NAMESPACE::IdType> vids;
+  for (const auto& pair : expected) {
+    vids.push_back(pair.first);
+  }
+  vids.push_back(vids.front());
+  std::reverse(vids.begin(), vids.end());
+  auto maybe_batch = edges2.BatchNeighbors(vids);
+  REQUIRE(!maybe_batch.has_error());
+  auto& batch = maybe_batch.value();
+  REQUIRE(batch.offsets.size() == vids.size() + 1);
+  for (size_t i = 0; i < vids.size(); ++i) {
+    std::vector<GAR_NAMESPACE::IdType> ids(
+        batch.neighbors.begin() + batch.offsets[i],
+        batch.neighbors.begin() + batch.offsets[i + 1]);
+    REQUIRE(ids == expected[vids[i]]);
+  }
+  REQUIRE(edges2.BatchNeighbors({0, -1}).status().IsKeyError());
 }
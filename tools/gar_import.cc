@@ -0,0 +1,867 @@
+/** Copyright 2022 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// gar-import: load a graph from CSV or Parquet files into GraphAr files.
+//
+// The vertices of each type are read file by file in the given order, and
+// indexed consecutively from 0 in that order. With a key column, the
+// original ids of the vertices are kept in a hash map, to map the sources
+// and destinations of the edges to the indices; edges with an unknown
+// endpoint are dropped. Without a key column, the endpoints of the edges
+// must be the indices already. The vertex chunks are written in the
+// background as soon as they are full (VerticesBuilder streaming).
+//
+// The edge files of a type are read in parallel. Without a memory budget,
+// all edges of a type are held in memory and written to all of its adj
+// list types by MultiLayoutEdgeWriter, sorting once per direction. With a
+// memory budget, each adj list type has an EdgesBuilder that spills sorted
+// runs once its share of the budget is exceeded, and merges them by vertex
+// chunk when dumping.
+//
+// The progress and the throughput are reported to stderr.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "arrow/api.h"
+#include "arrow/compute/api.h"
+#include "arrow/csv/api.h"
+#include "arrow/filesystem/api.h"
+#include "parquet/arrow/reader.h"
+
+#include "gar/graph_info.h"
+#include "gar/utils/general_params.h"
+#include "gar/utils/result.h"
+#include "gar/utils/status.h"
+#include "gar/utils/utils.h"
+#include "gar/writer/edges_builder.h"
+#include "gar/writer/multi_layout_edge_writer.h"
+#include "gar/writer/vertices_builder.h"
+
+namespace GAR_NAMESPACE_INTERNAL {
+namespace {
+
+const char kUsage[] =
+    "Usage: gar-import --graph <graph.yml> [options]\n"
+    "\n"
+    "Sources, .csv or .parquet files, a list is separated by ',':\n"
+    "  --vertex <label>=<files>        the vertices of a type, indexed in\n"
+    "                                  the order of the files and rows\n"
+    "  --vertex-key <label>=<column>   the column of the original vertex ids,\n"
+    "                                  the edges refer to the vertices by\n"
+    "                                  them; without it, the edges refer to\n"
+    "                                  the vertices by index\n"
+    "  --edge <src>:<edge>:<dst>=<files>\n"
+    "                                  the edges of a type\n"
+    "  --edge-columns <src>:<edge>:<dst>=<src_column>,<dst_column>\n"
+    "                                  the columns of the sources and the\n"
+    "                                  destinations, src,dst by default\n"
+    "\n"
+    "Options:\n"
+    "  --output <prefix>        the prefix to write to, with the yaml files,\n"
+    "                           the prefix of the graph info by default\n"
+    "  --delimiter <char>       the delimiter of the CSV files, ',' by "
+    "default\n"
+    "  --threads <num>          the number of threads, the number of\n"
+    "                           hardware threads by default\n"
+    "  --memory-budget <bytes>  the budget of the buffered edges of a type,\n"
+    "                           with a K, M or G suffix, unlimited by "
+    "default\n"
+    "  --spill-dir <dir>        the directory of the spilled runs, /tmp/ by\n"
+    "                           default\n";
+
+/// The source files of an edge type.
+struct EdgeSource {
+  std::string src_label;
+  std::string edge_label;
+  std::string dst_label;
+  std::vector<std::string> files;
+  std::string src_column = "src";
+  std::string dst_column = "dst";
+};
+
+/// The options of gar-import.
+struct ImportOptions {
+  std::string graph_path;
+  std::string output_prefix;
+  std::map<std::string, std::vector<std::string>> vertex_files;
+  std::map<std::string, std::string> vertex_keys;
+  std::map<std::string, EdgeSource> edge_sources;
+  char delimiter = ',';
+  int thread_num = 0;
+  int64_t memory_budget = -1;
+  std::string spill_dir = "/tmp/";
+};
+
+std::vector<std::string> Split(const std::string& str, char separator) {
+  std::vector<std::string> parts;
+  size_t begin = 0;
+  while (true) {
+    size_t end = str.find(separator, begin);
+    parts.push_back(str.substr(begin, end - begin));
+    if (end == std::string::npos) {
+      return parts;
+    }
+    begin = end + 1;
+  }
+}
+
+/// Split an argument of <key>=<value>.
+Result<std::pair<std::string, std::string>> SplitKeyValue(
+    const std::string& option, const std::string& arg) {
+  size_t pos = arg.find('=');
+  if (pos == std::string::npos || pos == 0 || pos + 1 == arg.size()) {
+    return Status::Invalid("The argument of " + option + " must be " +
+                           "<key>=<value>, but got " + arg + ".");
+  }
+  return std::make_pair(arg.substr(0, pos), arg.substr(pos + 1));
+}
+
+/// Get the edge source of a key <src>:<edge>:<dst>.
+Result<EdgeSource*> GetEdgeSource(ImportOptions* options,
+                                  const std::string& key) {
+  auto labels = Split(key, ':');
+  if (labels.size() != 3) {
+    return Status::Invalid("The edge type must be <src>:<edge>:<dst>, but " +
+                           std::string("got ") + key + ".");
+  }
+  auto& source = options->edge_sources[key];
+  source.src_label = labels[0];
+  source.edge_label = labels[1];
+  source.dst_label = labels[2];
+  return &source;
+}
+
+Result<int64_t> ParseBytes(const std::string& arg) {
+  size_t pos = 0;
+  int64_t bytes = 0;
+  try {
+    bytes = std::stoll(arg, &pos);
+  } catch (const std::exception&) {
+    return Status::Invalid("Invalid memory budget " + arg + ".");
+  }
+  std::string suffix = arg.substr(pos);
+  if (suffix == "K" || suffix == "k") {
+    bytes <<= 10;
+  } else if (suffix == "M" || suffix == "m") {
+    bytes <<= 20;
+  } else if (suffix == "G" || suffix == "g") {
+    bytes <<= 30;
+  } else if (!suffix.empty()) {
+    return Status::Invalid("Invalid memory budget " + arg + ".");
+  }
+  return bytes;
+}
+
+Status ParseArguments(int argc, char* argv[], ImportOptions* options) {
+  for (int i = 1; i < argc; ++i) {
+    std::string option = argv[i];
+    if (i + 1 == argc) {
+      return Status::Invalid("The option " + option + " has no argument.");
+    }
+    std::string arg = argv[++i];
+    if (option == "--graph") {
+      options->graph_path = arg;
+    } else if (option == "--output") {
+      options->output_prefix = arg;
+    } else if (option == "--vertex") {
+      GAR_ASSIGN_OR_RAISE(auto kv, SplitKeyValue(option, arg));
+      auto& files = options->vertex_files[kv.first];
+      for (const auto& file : Split(kv.second, ',')) {
+        files.push_back(file);
+      }
+    } else if (option == "--vertex-key") {
+      GAR_ASSIGN_OR_RAISE(auto kv, SplitKeyValue(option, arg));
+      options->vertex_keys[kv.first] = kv.second;
+    } else if (option == "--edge") {
+      GAR_ASSIGN_OR_RAISE(auto kv, SplitKeyValue(option, arg));
+      GAR_ASSIGN_OR_RAISE(auto source, GetEdgeSource(options, kv.first));
+      for (const auto& file : Split(kv.second, ',')) {
+        source->files.push_back(file);
+      }
+    } else if (option == "--edge-columns") {
+      GAR_ASSIGN_OR_RAISE(auto kv, SplitKeyValue(option, arg));
+      GAR_ASSIGN_OR_RAISE(auto source, GetEdgeSource(options, kv.first));
+      auto columns = Split(kv.second, ',');
+      if (columns.size() != 2) {
+        return Status::Invalid("The argument of --edge-columns must be " +
+                               std::string("<src_column>,<dst_column>."));
+      }
+      source->src_column = columns[0];
+      source->dst_column = columns[1];
+    } else if (option == "--delimiter") {
+      if (arg.size() != 1) {
+        return Status::Invalid("The delimiter must be a single character.");
+      }
+      options->delimiter = arg[0];
+    } else if (option == "--threads") {
+      options->thread_num = std::atoi(arg.c_str());
+    } else if (option == "--memory-budget") {
+      GAR_ASSIGN_OR_RAISE(options->memory_budget, ParseBytes(arg));
+    } else if (option == "--spill-dir") {
+      options->spill_dir = arg;
+    } else {
+      return Status::Invalid("Unknown option " + option + ".");
+    }
+  }
+  if (options->graph_path.empty()) {
+    return Status::Invalid("The graph yaml is not given.");
+  }
+  for (const auto& item : options->edge_sources) {
+    if (item.second.files.empty()) {
+      return Status::Invalid("No files are given for the edges " + item.first +
+                             ".");
+    }
+  }
+  return Status::OK();
+}
+
+/// Report the rows read of a vertex or edge type, at most once a second.
+class Progress {
+ public:
+  explicit Progress(const std::string& name)
+      : name_(name), rows_(0), start_(Clock::now()), last_report_(start_) {}
+
+  void Add(int64_t rows) {
+    int64_t total = rows_ += rows;
+    auto now = Clock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (now - last_report_ >= std::chrono::seconds(1)) {
+      last_report_ = now;
+      report(total, now, "reading");
+    }
+  }
+
+  void Finish(const std::string& action) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    report(rows_, Clock::now(), action);
+  }
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  void report(int64_t rows, Clock::time_point now, const std::string& action) {
+    double seconds = std::chrono::duration<double>(now - start_).count();
+    std::cerr << "[gar-import] " << name_ << ": " << action << ", " << rows
+              << " rows in " << seconds << " s, "
+              << static_cast<int64_t>(rows / std::max(seconds, 1e-3))
+              << " rows/s" << std::endl;
+  }
+
+  std::string name_;
+  std::atomic<int64_t> rows_;
+  Clock::time_point start_;
+  Clock::time_point last_report_;
+  std::mutex mutex_;
+};
+
+/// A CSV or Parquet file, read a table at a time.
+class SourceReader {
+ public:
+  /**
+   * @brief Open a source file.
+   *
+   * A CSV file is read a block at a time, and the blocks are converted by
+   * multiple threads. A Parquet file is read a row group at a time, and the
+   * columns are decoded by multiple threads.
+   *
+   * @param path The path or URI of the file.
+   * @param delimiter The delimiter of a CSV file.
+   * @param column_types The types of the columns of a CSV file, the others
+   *     are inferred.
+   * @return The reader, or error.
+   */
+  static Result<std::unique_ptr<SourceReader>> Open(
+      const std::string& path, char delimiter,
+      const std::unordered_map<std::string, std::shared_ptr<arrow::DataType>>&
+          column_types) {
+    std::string file_path;
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        auto fs, arrow::fs::FileSystemFromUriOrPath(path, &file_path));
+    auto reader = std::make_unique<SourceReader>();
+    auto ends_with = [&](const std::string& suffix) {
+      return path.size() >= suffix.size() &&
+             path.compare(path.size() - suffix.size(), suffix.size(),
+                          suffix) == 0;
+    };
+    if (ends_with(".parquet")) {
+      GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto input,
+                                           fs->OpenInputFile(file_path));
+      RETURN_NOT_ARROW_OK(parquet::arrow::OpenFile(
+          input, arrow::default_memory_pool(), &reader->parquet_reader_));
+      reader->parquet_reader_->set_use_threads(true);
+    } else if (ends_with(".csv")) {
+      GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto input,
+                                           fs->OpenInputStream(file_path));
+      auto read_options = arrow::csv::ReadOptions::Defaults();
+      read_options.use_threads = true;
+      auto parse_options = arrow::csv::ParseOptions::Defaults();
+      parse_options.delimiter = delimiter;
+      auto convert_options = arrow::csv::ConvertOptions::Defaults();
+      convert_options.column_types = column_types;
+      GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+          reader->csv_reader_,
+          arrow::csv::StreamingReader::Make(arrow::io::default_io_context(),
+                                            input, read_options, parse_options,
+                                            convert_options));
+    } else {
+      return Status::Invalid("The file " + path +
+                             " is neither .csv nor .parquet.");
+    }
+    return reader;
+  }
+
+  /// Read the next table, or nullptr at the end of the file.
+  Result<std::shared_ptr<arrow::Table>> Next() {
+    std::shared_ptr<arrow::Table> table;
+    if (parquet_reader_ != nullptr) {
+      if (row_group_ < parquet_reader_->num_row_groups()) {
+        RETURN_NOT_ARROW_OK(
+            parquet_reader_->ReadRowGroup(row_group_++, &table));
+      }
+      return table;
+    }
+    std::shared_ptr<arrow::RecordBatch> batch;
+    RETURN_NOT_ARROW_OK(csv_reader_->ReadNext(&batch));
+    if (batch != nullptr) {
+      GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+          table, arrow::Table::FromRecordBatches({batch}));
+    }
+    return table;
+  }
+
+ private:
+  std::shared_ptr<arrow::csv::StreamingReader> csv_reader_;
+  std::unique_ptr<parquet::arrow::FileReader> parquet_reader_;
+  int row_group_ = 0;
+};
+
+/// The map from the original ids of the vertices of a type to their indices.
+class VertexIndexMap {
+ public:
+  /**
+   * @brief Add the ids of the vertices with consecutive indices.
+   *
+   * The ids are kept as int64 if the first ids added are integers, or as
+   * strings otherwise, and the later ids are cast to the same type.
+   *
+   * @param ids The ids of the vertices.
+   * @param first The index of the first vertex.
+   * @return Status: ok or Status::Invalid if an id is null or duplicate.
+   */
+  Status Add(const std::shared_ptr<arrow::ChunkedArray>& ids, IdType first) {
+    if (type_ == nullptr) {
+      type_ = arrow::is_integer(ids->type()->id()) ? arrow::int64()
+                                                   : arrow::utf8();
+    }
+    GAR_ASSIGN_OR_RAISE(auto casted, castIds(ids));
+    if (casted->null_count() > 0) {
+      return Status::Invalid("The vertex ids must not be null.");
+    }
+    IdType index = first;
+    for (const auto& chunk : casted->chunks()) {
+      for (int64_t i = 0; i < chunk->length(); ++i, ++index) {
+        bool inserted =
+            type_->id() == arrow::Type::INT64
+                ? int_ids_
+                      .emplace(std::static_pointer_cast<arrow::Int64Array>(
+                                   chunk)
+                                   ->Value(i),
+                               index)
+                      .second
+                : string_ids_
+                      .emplace(std::static_pointer_cast<arrow::StringArray>(
+                                   chunk)
+                                   ->GetString(i),
+                               index)
+                      .second;
+        if (!inserted) {
+          return Status::Invalid("The vertex id at " + std::to_string(index) +
+                                 " is duplicate.");
+        }
+      }
+    }
+    return Status::OK();
+  }
+
+  /**
+   * @brief Map the ids to the indices of the vertices.
+   *
+   * @param ids The ids of the vertices.
+   * @return The indices, null for the null or unknown ids, or error.
+   */
+  Result<std::shared_ptr<arrow::ChunkedArray>> Map(
+      const std::shared_ptr<arrow::ChunkedArray>& ids) const {
+    arrow::Int64Builder builder;
+    RETURN_NOT_ARROW_OK(builder.Reserve(ids->length()));
+    if (type_ == nullptr) {
+      RETURN_NOT_ARROW_OK(builder.AppendNulls(ids->length()));
+    } else {
+      GAR_ASSIGN_OR_RAISE(auto casted, castIds(ids));
+      for (const auto& chunk : casted->chunks()) {
+        for (int64_t i = 0; i < chunk->length(); ++i) {
+          if (chunk->IsNull(i)) {
+            builder.UnsafeAppendNull();
+            continue;
+          }
+          if (type_->id() == arrow::Type::INT64) {
+            auto it = int_ids_.find(
+                std::static_pointer_cast<arrow::Int64Array>(chunk)->Value(i));
+            if (it != int_ids_.end()) {
+              builder.UnsafeAppend(it->second);
+              continue;
+            }
+          } else {
+            auto it = string_ids_.find(
+                std::static_pointer_cast<arrow::StringArray>(chunk)->GetString(
+                    i));
+            if (it != string_ids_.end()) {
+              builder.UnsafeAppend(it->second);
+              continue;
+            }
+          }
+          builder.UnsafeAppendNull();
+        }
+      }
+    }
+    std::shared_ptr<arrow::Array> indices;
+    RETURN_NOT_ARROW_OK(builder.Finish(&indices));
+    return std::make_shared<arrow::ChunkedArray>(indices);
+  }
+
+ private:
+  Result<std::shared_ptr<arrow::ChunkedArray>> castIds(
+      const std::shared_ptr<arrow::ChunkedArray>& ids) const {
+    if (ids->type()->Equals(type_)) {
+      return ids;
+    }
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto casted,
+                                         arrow::compute::Cast(ids, type_));
+    return casted.chunked_array();
+  }
+
+  std::shared_ptr<arrow::DataType> type_;
+  std::unordered_map<int64_t, IdType> int_ids_;
+  std::unordered_map<std::string, IdType> string_ids_;
+};
+
+/// The CSV column types of the properties, so that they need no cast.
+std::unordered_map<std::string, std::shared_ptr<arrow::DataType>> ColumnTypes(
+    const std::vector<Property>& properties) {
+  std::unordered_map<std::string, std::shared_ptr<arrow::DataType>> types;
+  for (const auto& property : properties) {
+    types[property.name] = DataType::DataTypeToArrowDataType(property.type);
+  }
+  return types;
+}
+
+/// Append the columns of the properties in the table cast to their types,
+/// or of nulls for the properties not in the table.
+Status AppendProperties(
+    const std::shared_ptr<arrow::Table>& table,
+    const std::vector<Property>& properties,
+    std::vector<std::shared_ptr<arrow::Field>>* fields,
+    std::vector<std::shared_ptr<arrow::ChunkedArray>>* columns) {
+  for (const auto& property : properties) {
+    auto type = DataType::DataTypeToArrowDataType(property.type);
+    auto column = table->GetColumnByName(property.name);
+    if (column == nullptr) {
+      GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+          auto nulls, arrow::MakeArrayOfNull(type, table->num_rows()));
+      column = std::make_shared<arrow::ChunkedArray>(nulls);
+    } else if (!column->type()->Equals(type)) {
+      GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto casted,
+                                           arrow::compute::Cast(column, type));
+      column = casted.chunked_array();
+    }
+    fields->push_back(arrow::field(property.name, type));
+    columns->push_back(column);
+  }
+  return Status::OK();
+}
+
+/// Get a column of the table by name, or Status::KeyError.
+Result<std::shared_ptr<arrow::ChunkedArray>> GetColumn(
+    const std::shared_ptr<arrow::Table>& table, const std::string& name,
+    const std::string& path) {
+  auto column = table->GetColumnByName(name);
+  if (column == nullptr) {
+    return Status::KeyError("The column " + name + " is not found in " + path +
+                            ".");
+  }
+  return column;
+}
+
+/**
+ * @brief Read the vertices of a type, and write them by chunk as soon as
+ * the chunks are full.
+ *
+ * @param vertex_info The vertex info of the vertices.
+ * @param files The source files of the vertices.
+ * @param key The column of the original ids, or empty.
+ * @param options The options of gar-import.
+ * @param prefix The prefix to write to.
+ * @param index_map The map to add the original ids to.
+ * @return The number of vertices, or error.
+ */
+Result<IdType> ImportVertices(const VertexInfo& vertex_info,
+                              const std::vector<std::string>& files,
+                              const std::string& key,
+                              const ImportOptions& options,
+                              const std::string& prefix,
+                              VertexIndexMap* index_map) {
+  std::vector<Property> properties;
+  for (const auto& property_group : vertex_info.GetPropertyGroups()) {
+    for (const auto& property : property_group.GetProperties()) {
+      properties.push_back(property);
+    }
+  }
+  int thread_num = options.thread_num > 0
+                       ? options.thread_num
+                       : std::max(1u, std::thread::hardware_concurrency());
+  VerticesBuilder builder(vertex_info, prefix);
+  builder.EnableStreaming(thread_num);
+  Progress progress(vertex_info.GetLabel());
+  for (const auto& file : files) {
+    GAR_ASSIGN_OR_RAISE(
+        auto reader,
+        SourceReader::Open(file, options.delimiter, ColumnTypes(properties)));
+    while (true) {
+      GAR_ASSIGN_OR_RAISE(auto table, reader->Next());
+      if (table == nullptr) {
+        break;
+      }
+      if (!key.empty()) {
+        GAR_ASSIGN_OR_RAISE(auto ids, GetColumn(table, key, file));
+        GAR_RETURN_NOT_OK(index_map->Add(ids, builder.GetNum()));
+      }
+      std::vector<std::shared_ptr<arrow::Field>> fields;
+      std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
+      GAR_RETURN_NOT_OK(AppendProperties(table, properties, &fields, &columns));
+      GAR_RETURN_NOT_OK(builder.AddVertices(arrow::Table::Make(
+          arrow::schema(fields), columns, table->num_rows())));
+      progress.Add(table->num_rows());
+    }
+  }
+  GAR_RETURN_NOT_OK(builder.Dump());
+  progress.Finish("written");
+  return builder.GetNum();
+}
+
+/**
+ * @brief Convert a table of a source file to the edges, with the indices of
+ * the sources and destinations and the columns of the properties.
+ *
+ * @param table The table of the source file.
+ * @param source The edge source.
+ * @param path The path of the source file.
+ * @param src_map The map of the source ids, or nullptr if they are indices.
+ * @param dst_map The map of the destination ids, or nullptr.
+ * @param properties The properties of the edges.
+ * @return The edges without the ones of null or unknown endpoints, or error.
+ */
+Result<std::shared_ptr<arrow::Table>> ConvertEdges(
+    const std::shared_ptr<arrow::Table>& table, const EdgeSource& source,
+    const std::string& path, const VertexIndexMap* src_map,
+    const VertexIndexMap* dst_map, const std::vector<Property>& properties) {
+  std::vector<std::shared_ptr<arrow::Field>> fields = {
+      arrow::field(GeneralParams::kSrcIndexCol, arrow::int64()),
+      arrow::field(GeneralParams::kDstIndexCol, arrow::int64())};
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
+  for (auto item : {std::make_pair(&source.src_column, src_map),
+                    std::make_pair(&source.dst_column, dst_map)}) {
+    GAR_ASSIGN_OR_RAISE(auto ids, GetColumn(table, *item.first, path));
+    if (item.second != nullptr) {
+      GAR_ASSIGN_OR_RAISE(ids, item.second->Map(ids));
+    } else if (!ids->type()->Equals(arrow::int64())) {
+      GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+          auto casted, arrow::compute::Cast(ids, arrow::int64()));
+      ids = casted.chunked_array();
+    }
+    columns.push_back(ids);
+  }
+  GAR_RETURN_NOT_OK(AppendProperties(table, properties, &fields, &columns));
+  auto edges =
+      arrow::Table::Make(arrow::schema(fields), columns, table->num_rows());
+  if (columns[0]->null_count() == 0 && columns[1]->null_count() == 0) {
+    return edges;
+  }
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto src_valid,
+                                       arrow::compute::IsValid(columns[0]));
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto dst_valid,
+                                       arrow::compute::IsValid(columns[1]));
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      auto valid, arrow::compute::And(src_valid, dst_valid));
+  GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto filtered,
+                                       arrow::compute::Filter(edges, valid));
+  return filtered.table();
+}
+
+/**
+ * @brief Read the edges of a type, and write them to all adj list types of
+ * the edge info.
+ *
+ * @param edge_info The edge info of the edges.
+ * @param source The edge source.
+ * @param src_map The map of the source ids, or nullptr if they are indices.
+ * @param dst_map The map of the destination ids, or nullptr.
+ * @param src_num The number of source vertices, or -1 if unknown.
+ * @param dst_num The number of destination vertices, or -1 if unknown.
+ * @param options The options of gar-import.
+ * @param prefix The prefix to write to.
+ * @return Status: ok or error.
+ */
+Status ImportEdges(const EdgeInfo& edge_info, const EdgeSource& source,
+                   const VertexIndexMap* src_map, const VertexIndexMap* dst_map,
+                   IdType src_num, IdType dst_num, const ImportOptions& options,
+                   const std::string& prefix) {
+  // the properties of all adj list types, and the builders of them if the
+  // buffered edges are limited by the memory budget
+  std::vector<Property> properties;
+  std::vector<std::unique_ptr<EdgesBuilder>> builders;
+  std::vector<std::vector<std::string>> builder_columns;
+  for (auto adj_list_type :
+       {AdjListType::ordered_by_source, AdjListType::ordered_by_dest,
+        AdjListType::unordered_by_source, AdjListType::unordered_by_dest}) {
+    if (!edge_info.ContainAdjList(adj_list_type)) {
+      continue;
+    }
+    std::vector<std::string> columns = {GeneralParams::kSrcIndexCol,
+                                        GeneralParams::kDstIndexCol};
+    GAR_ASSIGN_OR_RAISE(const auto& property_groups,
+                        edge_info.GetPropertyGroups(adj_list_type));
+    for (const auto& property_group : property_groups) {
+      for (const auto& property : property_group.GetProperties()) {
+        columns.push_back(property.name);
+        if (std::none_of(properties.begin(), properties.end(),
+                         [&](const Property& p) {
+                           return p.name == property.name;
+                         })) {
+          properties.push_back(property);
+        }
+      }
+    }
+    if (options.memory_budget > 0) {
+      bool by_source = adj_list_type == AdjListType::ordered_by_source ||
+                       adj_list_type == AdjListType::unordered_by_source;
+      builders.push_back(std::make_unique<EdgesBuilder>(
+          edge_info, prefix, adj_list_type, by_source ? src_num : dst_num));
+      builder_columns.push_back(columns);
+    }
+  }
+  for (auto& builder : builders) {
+    builder->SetMemoryBudget(options.memory_budget / builders.size(),
+                             options.spill_dir);
+  }
+
+  // read the files in parallel
+  std::string name = source.src_label + ":" + source.edge_label + ":" +
+                     source.dst_label;
+  Progress progress(name);
+  std::atomic<int64_t> dropped(0);
+  std::vector<std::vector<std::shared_ptr<arrow::Table>>> file_edges(
+      source.files.size());
+  // each builder has its own lock, so a builder spilling its edges does not
+  // block the others
+  std::vector<std::mutex> builder_mutexes(builders.size());
+  GAR_RETURN_NOT_OK(util::ParallelFor(
+      0, source.files.size(),
+      [&](IdType i) -> Status {
+        const auto& file = source.files[i];
+        GAR_ASSIGN_OR_RAISE(auto reader,
+                            SourceReader::Open(file, options.delimiter,
+                                               ColumnTypes(properties)));
+        while (true) {
+          GAR_ASSIGN_OR_RAISE(auto table, reader->Next());
+          if (table == nullptr) {
+            return Status::OK();
+          }
+          GAR_ASSIGN_OR_RAISE(auto edges,
+                              ConvertEdges(table, source, file, src_map,
+                                           dst_map, properties));
+          dropped += table->num_rows() - edges->num_rows();
+          if (builders.empty()) {
+            file_edges[i].push_back(edges);
+          } else {
+            // the threads start from different builders to spread the locks
+            for (size_t k = 0; k < builders.size(); ++k) {
+              size_t j = (i + k) % builders.size();
+              std::vector<int> indices;
+              for (const auto& column : builder_columns[j]) {
+                indices.push_back(edges->schema()->GetFieldIndex(column));
+              }
+              GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+                  auto selected, edges->SelectColumns(indices));
+              std::lock_guard<std::mutex> lock(builder_mutexes[j]);
+              GAR_RETURN_NOT_OK(builders[j]->AddEdges(selected));
+            }
+          }
+          progress.Add(table->num_rows());
+        }
+      },
+      options.thread_num));
+  if (dropped > 0) {
+    std::cerr << "[gar-import] " << name << ": dropped " << dropped.load()
+              << " edges of null or unknown endpoints" << std::endl;
+  }
+
+  // write the edges
+  if (builders.empty()) {
+    std::vector<std::shared_ptr<arrow::Table>> tables;
+    for (auto& edges : file_edges) {
+      tables.insert(tables.end(), edges.begin(), edges.end());
+      edges.clear();
+    }
+    if (tables.empty()) {
+      return Status::OK();
+    }
+    GAR_RETURN_ON_ARROW_ERROR_AND_ASSIGN(auto edges,
+                                         arrow::ConcatenateTables(tables));
+    tables.clear();
+    // without edges, e.g., all of them are dropped, only the empty offset
+    // chunks of the known vertices are written
+    if (edges->num_rows() > 0 || src_num != -1 || dst_num != -1) {
+      MultiLayoutEdgeWriter writer(edge_info, prefix);
+      GAR_RETURN_NOT_OK(
+          writer.WriteTable(edges, src_num, dst_num, options.thread_num));
+    }
+  } else {
+    for (auto& builder : builders) {
+      GAR_RETURN_NOT_OK(builder->Dump(options.thread_num));
+    }
+  }
+  progress.Finish("written");
+  return Status::OK();
+}
+
+/// Import the sources into the files of the graph.
+Status Import(const ImportOptions& options) {
+  GAR_ASSIGN_OR_RAISE(auto graph_info, GraphInfo::Load(options.graph_path));
+  std::string prefix = options.output_prefix.empty()
+                           ? graph_info.GetPrefix()
+                           : options.output_prefix;
+  if (prefix.empty() || prefix.back() != '/') {
+    prefix += "/";
+  }
+  auto start = std::chrono::steady_clock::now();
+
+  for (const auto& item : options.vertex_keys) {
+    if (!options.vertex_files.count(item.first)) {
+      return Status::Invalid("No files are given for the vertices " +
+                             item.first + ".");
+    }
+  }
+
+  std::map<std::string, VertexIndexMap> index_maps;
+  std::map<std::string, IdType> vertex_nums;
+  for (const auto& item : options.vertex_files) {
+    GAR_ASSIGN_OR_RAISE(const auto& vertex_info,
+                        graph_info.GetVertexInfo(item.first));
+    std::string key;
+    VertexIndexMap* index_map = nullptr;
+    if (options.vertex_keys.count(item.first)) {
+      key = options.vertex_keys.at(item.first);
+      index_map = &index_maps[item.first];
+    }
+    GAR_ASSIGN_OR_RAISE(vertex_nums[item.first],
+                        ImportVertices(vertex_info, item.second, key, options,
+                                       prefix, index_map));
+  }
+
+  for (const auto& item : options.edge_sources) {
+    const auto& source = item.second;
+    GAR_ASSIGN_OR_RAISE(const auto& edge_info,
+                        graph_info.GetEdgeInfo(source.src_label,
+                                               source.edge_label,
+                                               source.dst_label));
+    auto src_map = index_maps.find(source.src_label);
+    auto dst_map = index_maps.find(source.dst_label);
+    auto src_num = vertex_nums.find(source.src_label);
+    auto dst_num = vertex_nums.find(source.dst_label);
+    GAR_RETURN_NOT_OK(ImportEdges(
+        edge_info, source,
+        src_map == index_maps.end() ? nullptr : &src_map->second,
+        dst_map == index_maps.end() ? nullptr : &dst_map->second,
+        src_num == vertex_nums.end() ? -1 : src_num->second,
+        dst_num == vertex_nums.end() ? -1 : dst_num->second, options, prefix));
+  }
+
+  // describe the graph at the new prefix
+  if (!options.output_prefix.empty()) {
+    GraphInfo new_graph_info(graph_info.GetName(), graph_info.GetVersion(),
+                             prefix);
+    for (const auto& item : graph_info.GetAllVertexInfo()) {
+      GAR_RETURN_NOT_OK(new_graph_info.AddVertex(item.second));
+      std::string vertex_info_path = item.first + ".vertex.yml";
+      GAR_RETURN_NOT_OK(item.second.Save(prefix + vertex_info_path));
+      new_graph_info.AddVertexInfoPath(vertex_info_path);
+    }
+    for (const auto& item : graph_info.GetAllEdgeInfo()) {
+      const auto& edge_info = item.second;
+      GAR_RETURN_NOT_OK(new_graph_info.AddEdge(edge_info));
+      std::string edge_info_path = edge_info.GetSrcLabel() + "_" +
+                                   edge_info.GetEdgeLabel() + "_" +
+                                   edge_info.GetDstLabel() + ".edge.yml";
+      GAR_RETURN_NOT_OK(edge_info.Save(prefix + edge_info_path));
+      new_graph_info.AddEdgeInfoPath(edge_info_path);
+    }
+    GAR_RETURN_NOT_OK(new_graph_info.Save(prefix + graph_info.GetName() +
+                                          ".graph.yml"));
+  }
+  double seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  std::cerr << "[gar-import] done in " << seconds << " s" << std::endl;
+  return Status::OK();
+}
+
+}  // namespace
+}  // namespace GAR_NAMESPACE_INTERNAL
+
+int main(int argc, char* argv[]) {
+  namespace GAR = GAR_NAMESPACE;
+  for (int i = 1; i < argc; ++i) {
+    if (std::string(argv[i]) == "--help" || std::string(argv[i]) == "-h") {
+      std::cout << GAR::kUsage;
+      return 0;
+    }
+  }
+  GAR::ImportOptions options;
+  GAR::Status status = GAR::ParseArguments(argc, argv, &options);
+  if (!status.ok()) {
+    std::cerr << "gar-import: " << status.message() << std::endl
+              << GAR::kUsage;
+    return 1;
+  }
+  status = GAR::Import(options);
+  if (!status.ok()) {
+    std::cerr << "gar-import: " << status.message() << std::endl;
+    return 1;
+  }
+  return 0;
+}